@@ -0,0 +1,192 @@
+#include "AsyncLogger.hpp"
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <numeric>
+
+namespace {
+
+// How long the writer sleeps when every ring is empty
+constexpr auto kWriterIdle = std::chrono::milliseconds(1);
+
+template <typename T>
+T readValue(const char*& cursor) {
+    T value;
+    std::memcpy(&value, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return value;
+}
+
+// Appends the next argument; returns false when there is none left
+bool appendArgument(const char*& cursor, const char* end, std::string& out) {
+    if (cursor >= end) {
+        return false;
+    }
+    char text[32];
+    switch (static_cast<LogArg>(*cursor++)) {
+        case LogArg::Int:
+            out.append(text, std::snprintf(text, sizeof(text), "%" PRId64, readValue<int64_t>(cursor)));
+            break;
+        case LogArg::UInt:
+            out.append(text, std::snprintf(text, sizeof(text), "%" PRIu64, readValue<uint64_t>(cursor)));
+            break;
+        case LogArg::Double:
+            // What operator<< prints with the default precision
+            out.append(text, std::snprintf(text, sizeof(text), "%g", readValue<double>(cursor)));
+            break;
+        case LogArg::Bool:
+            out += readValue<bool>(cursor) ? "true" : "false";
+            break;
+        case LogArg::Char:
+            out += readValue<char>(cursor);
+            break;
+        case LogArg::String: {
+            uint16_t length = readValue<uint16_t>(cursor);
+            out.append(cursor, length);
+            cursor += length;
+            break;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+AsyncLogger& AsyncLogger::instance() {
+    static AsyncLogger logger;
+    return logger;
+}
+
+AsyncLogger::AsyncLogger() : writer([this] { run(); }) {}
+
+AsyncLogger::~AsyncLogger() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    writer.join();
+}
+
+std::shared_ptr<AsyncLogger::ThreadBuffer> AsyncLogger::registerThread() {
+    auto buffer = std::make_shared<ThreadBuffer>();
+    std::lock_guard<std::mutex> lock(mutex);
+    buffer->threadIndex = nextThreadIndex++;
+    buffers.push_back(buffer);
+    return buffer;
+}
+
+void AsyncLogger::flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    uint64_t request = ++flushRequests;
+    wake.notify_all();
+    flushed.wait(lock, [&] { return flushesDone >= request || stopping; });
+}
+
+uint64_t AsyncLogger::droppedCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    uint64_t dropped = droppedByExitedThreads;
+    for (const auto& buffer : buffers) {
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+void AsyncLogger::format(const LogRecord& record, std::string& out) {
+    const char* cursor = record.payload;
+    const char* end = record.payload + record.payloadBytes;
+    std::string_view format = record.site->format;
+    size_t position = 0;
+    while (position < format.size()) {
+        size_t placeholder = format.find("{}", position);
+        if (placeholder == std::string_view::npos) {
+            out.append(format.substr(position));
+            break;
+        }
+        out.append(format.substr(position, placeholder - position));
+        if (!appendArgument(cursor, end, out)) {
+            out += "{}";
+        }
+        position = placeholder + 2;
+    }
+    if (record.truncated) {
+        out += " [truncated]";
+    }
+    out += '\n';
+}
+
+size_t AsyncLogger::drain(std::vector<LogRecord>& batch) {
+    std::vector<std::shared_ptr<ThreadBuffer>> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // Rings of threads that have exited (only this list still holds them) go once they are empty
+        for (auto it = buffers.begin(); it != buffers.end();) {
+            if (it->use_count() == 1 && (*it)->ring.size() == 0) {
+                droppedByExitedThreads += (*it)->dropped.load(std::memory_order_relaxed);
+                it = buffers.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        snapshot = buffers;
+    }
+    size_t before = batch.size();
+    for (const auto& buffer : snapshot) {
+        buffer->ring.popBatch([&batch](const LogRecord& record) { batch.push_back(record); }, SIZE_MAX);
+        uint64_t dropped = buffer->dropped.load(std::memory_order_relaxed);
+        if (dropped != buffer->reportedDropped) {
+            std::fprintf(stderr, "Log ring of thread %u full: %" PRIu64 " records dropped\n", buffer->threadIndex,
+                         dropped - buffer->reportedDropped);
+            buffer->reportedDropped = dropped;
+        }
+    }
+    return batch.size() - before;
+}
+
+void AsyncLogger::run() {
+    std::vector<LogRecord> batch;
+    std::vector<uint32_t> order;
+    std::string out;
+    std::string err;
+    for (;;) {
+        uint64_t request;
+        bool exiting;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            request = flushRequests;
+            exiting = stopping;
+        }
+
+        batch.clear();
+        drain(batch);
+        // Each ring is in order; across threads the batch is merged by time
+        order.resize(batch.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(),
+                         [&batch](uint32_t a, uint32_t b) { return batch[a].timeNs < batch[b].timeNs; });
+        out.clear();
+        err.clear();
+        for (uint32_t index : order) {
+            format(batch[index], batch[index].site->level >= LogLevel::Warn ? err : out);
+        }
+        if (!out.empty()) {
+            std::fwrite(out.data(), 1, out.size(), stdout);
+            std::fflush(stdout);
+        }
+        if (!err.empty()) {
+            std::fwrite(err.data(), 1, err.size(), stderr);
+            std::fflush(stderr);
+        }
+        written.store(written.load(std::memory_order_relaxed) + batch.size(), std::memory_order_relaxed);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        flushesDone = request;
+        flushed.notify_all();
+        if (exiting) {
+            return;
+        }
+        if (batch.empty()) {
+            wake.wait_for(lock, kWriterIdle, [&] { return stopping || flushRequests != flushesDone; });
+        }
+    }
+}
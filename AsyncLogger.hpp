@@ -0,0 +1,196 @@
+#ifndef ASYNCLOGGER_HPP
+#define ASYNCLOGGER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "MonotonicClock.hpp"
+#include "SpscRing.hpp"
+
+// Calls below this level compile to nothing: 0 debug, 1 info, 2 warn, 3 error, 4 none.
+// Build with -DPX_LOG_LEVEL=0 to get the debug output back.
+#ifndef PX_LOG_LEVEL
+#define PX_LOG_LEVEL 1
+#endif
+
+enum class LogLevel : uint8_t { Debug = 0, Info = 1, Warn = 2, Error = 3 };
+
+// One static instance per call site; its address is the format id a record carries
+struct LogSite {
+    LogLevel level;
+    const char* format;             // "{}" placeholders, filled in argument order
+};
+
+// One log call as it sits in a thread's ring: the site and the raw arguments, each a type tag and
+// its bytes. Strings are copied (and cut to what fits), so the caller's buffers can go away.
+struct alignas(64) LogRecord {
+    static constexpr size_t kPayloadBytes = 236;
+
+    int64_t timeNs;
+    const LogSite* site;
+    uint16_t payloadBytes;
+    uint8_t argCount;
+    bool truncated;
+    char payload[kPayloadBytes];
+};
+static_assert(sizeof(LogRecord) == 256, "LogRecord should be four cache lines");
+
+enum class LogArg : uint8_t { Int, UInt, Double, Bool, Char, String };
+
+// Takes formatting and console I/O off the threads that log. A log call stamps the time, writes the
+// call site and its raw arguments into the calling thread's own preallocated ring (no lock, no
+// allocation, no syscall) and returns; a full ring drops the record and counts it. A writer thread
+// drains every ring about once a millisecond, orders the batch by time, formats it and writes it
+// with one fwrite and fflush per stream: Debug and Info to stdout, Warn and Error to stderr. Going
+// through stdio keeps its output in order with std::cout on the same stream.
+//
+// A record holds LogRecord::kPayloadBytes of arguments: longer strings are cut and the line ends in
+// " [truncated]". Print unbounded text (raw frames, long symbol lists) directly after flush().
+//
+// Use the PX_LOG_* macros rather than log(), so PX_LOG_LEVEL can remove calls at compile time.
+class AsyncLogger {
+public:
+    static constexpr size_t kRingRecords = 4096;  // Per logging thread, allocated on its first call
+
+    static AsyncLogger& instance();
+
+    template <typename... Args>
+    void log(const LogSite& site, const Args&... args) {
+        ThreadBuffer& buffer = threadBuffer();
+        int64_t nowNs = monotonicNowNs();
+        bool pushed = buffer.ring.tryPushWith([&](LogRecord& record) {
+            record.timeNs = nowNs;
+            record.site = &site;
+            record.payloadBytes = 0;
+            record.argCount = 0;
+            record.truncated = false;
+            (encode(record, args), ...);
+        });
+        if (!pushed) {
+            buffer.dropped.store(buffer.dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+    }
+
+    // Blocks until everything logged before the call has been written. Call it before printing
+    // directly to the same stream when the order matters, and before the process exits abruptly.
+    void flush();
+
+    uint64_t writtenCount() const { return written.load(std::memory_order_relaxed); }
+    uint64_t droppedCount() const;
+
+    // Appends the text of record, as the writer thread prints it (newline included)
+    static void format(const LogRecord& record, std::string& out);
+
+    ~AsyncLogger();
+
+private:
+    struct ThreadBuffer {
+        SpscRing<LogRecord> ring{kRingRecords};
+        std::atomic<uint64_t> dropped{0};   // Logging thread only
+        uint64_t reportedDropped = 0;       // Writer thread only
+        uint32_t threadIndex = 0;
+    };
+
+    AsyncLogger();
+
+    ThreadBuffer& threadBuffer() {
+        thread_local std::shared_ptr<ThreadBuffer> buffer;
+        if (!buffer) {
+            buffer = registerThread();
+        }
+        return *buffer;
+    }
+
+    std::shared_ptr<ThreadBuffer> registerThread();
+    void run();
+    size_t drain(std::vector<LogRecord>& batch);
+
+    static void put(LogRecord& record, LogArg tag, const void* value, size_t size) {
+        if (record.payloadBytes + 1 + size > LogRecord::kPayloadBytes) {
+            record.truncated = true;
+            return;
+        }
+        char* cursor = record.payload + record.payloadBytes;
+        *cursor = static_cast<char>(tag);
+        std::memcpy(cursor + 1, value, size);
+        record.payloadBytes = static_cast<uint16_t>(record.payloadBytes + 1 + size);
+        ++record.argCount;
+    }
+
+    static void putString(LogRecord& record, std::string_view text) {
+        size_t room = LogRecord::kPayloadBytes - record.payloadBytes;
+        if (room < 1 + sizeof(uint16_t)) {
+            record.truncated = true;
+            return;
+        }
+        uint16_t length = static_cast<uint16_t>(std::min(text.size(), room - 1 - sizeof(uint16_t)));
+        char* cursor = record.payload + record.payloadBytes;
+        *cursor = static_cast<char>(LogArg::String);
+        std::memcpy(cursor + 1, &length, sizeof(length));
+        std::memcpy(cursor + 1 + sizeof(length), text.data(), length);
+        record.payloadBytes = static_cast<uint16_t>(record.payloadBytes + 1 + sizeof(length) + length);
+        record.truncated = record.truncated || length < text.size();
+        ++record.argCount;
+    }
+
+    template <typename T>
+    static void encode(LogRecord& record, const T& value) {
+        using V = std::decay_t<T>;
+        if constexpr (std::is_same_v<V, bool>) {
+            put(record, LogArg::Bool, &value, 1);
+        } else if constexpr (std::is_same_v<V, char>) {
+            put(record, LogArg::Char, &value, 1);
+        } else if constexpr (std::is_integral_v<V> && std::is_signed_v<V>) {
+            int64_t widened = value;
+            put(record, LogArg::Int, &widened, sizeof(widened));
+        } else if constexpr (std::is_integral_v<V>) {
+            uint64_t widened = value;
+            put(record, LogArg::UInt, &widened, sizeof(widened));
+        } else if constexpr (std::is_floating_point_v<V>) {
+            double widened = value;
+            put(record, LogArg::Double, &widened, sizeof(widened));
+        } else if constexpr (std::is_same_v<V, const char*> || std::is_same_v<V, char*>) {
+            putString(record, value != nullptr ? std::string_view(value) : std::string_view("(null)"));
+        } else {
+            static_assert(std::is_convertible_v<const V&, std::string_view>,
+                          "Log arguments are numbers, bools, chars and strings");
+            putString(record, std::string_view(value));
+        }
+    }
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;       // Writer: flush requested or stopping
+    std::condition_variable flushed;    // Flushers: the writer caught up
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    uint32_t nextThreadIndex = 0;
+    uint64_t flushRequests = 0;
+    uint64_t flushesDone = 0;
+    bool stopping = false;
+    std::atomic<uint64_t> written{0};
+    uint64_t droppedByExitedThreads = 0;
+    std::thread writer;
+};
+
+#define PX_LOG(level, format, ...)                                                    \
+    do {                                                                              \
+        if constexpr (static_cast<int>(level) >= PX_LOG_LEVEL) {                      \
+            static constexpr LogSite pxLogSite{level, format};                        \
+            AsyncLogger::instance().log(pxLogSite, ##__VA_ARGS__);                    \
+        }                                                                             \
+    } while (false)
+
+#define PX_LOG_DEBUG(format, ...) PX_LOG(LogLevel::Debug, format, ##__VA_ARGS__)
+#define PX_LOG_INFO(format, ...) PX_LOG(LogLevel::Info, format, ##__VA_ARGS__)
+#define PX_LOG_WARN(format, ...) PX_LOG(LogLevel::Warn, format, ##__VA_ARGS__)
+#define PX_LOG_ERROR(format, ...) PX_LOG(LogLevel::Error, format, ##__VA_ARGS__)
+
+#endif // ASYNCLOGGER_HPP
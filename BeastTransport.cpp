@@ -0,0 +1,223 @@
+#include "BeastTransport.hpp"
+#include <chrono>
+#include <stdexcept>
+#include <boost/asio/connect.hpp>
+#include <boost/asio/ssl/host_name_verification.hpp>
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+#include "AsyncLogger.hpp"
+#include "MonotonicClock.hpp"
+
+namespace beast = boost::beast;
+namespace websocket = boost::beast::websocket;
+
+namespace {
+
+constexpr size_t kInitialBufferBytes = 64 * 1024;
+
+// Splits ws[s]://host[:port][/target]
+void parseUrl(const std::string& url, std::string& host, std::string& port, std::string& target) {
+    std::string rest;
+    if (url.rfind("wss://", 0) == 0) {
+        rest = url.substr(6);
+        port = "443";
+    } else if (url.rfind("ws://", 0) == 0) {
+        throw std::runtime_error("BeastTransport only supports wss:// URLs: " + url);
+    } else {
+        throw std::runtime_error("Invalid websocket URL: " + url);
+    }
+    auto slash = rest.find('/');
+    std::string authority = rest.substr(0, slash);
+    target = slash == std::string::npos ? "/" : rest.substr(slash);
+    auto colon = authority.rfind(':');
+    if (colon != std::string::npos && authority.find(']') == std::string::npos) {
+        host = authority.substr(0, colon);
+        port = authority.substr(colon + 1);
+    } else {
+        host = authority;
+    }
+    if (host.empty()) {
+        throw std::runtime_error("Invalid websocket URL: " + url);
+    }
+}
+
+} // namespace
+
+BeastTransport::BeastTransport(SessionTimeline& timeline) : resolver(ioc), sessionTimeline(timeline) {}
+
+void BeastTransport::initTlsContext() {
+    int64_t start = monotonicNowNs();
+    sslContext = std::make_unique<boost::asio::ssl::context>(boost::asio::ssl::context::tls_client);
+    sslContext->set_options(boost::asio::ssl::context::no_sslv2 | boost::asio::ssl::context::no_sslv3 |
+                            boost::asio::ssl::context::no_tlsv1 | boost::asio::ssl::context::no_tlsv1_1);
+    sslContext->set_verify_mode(boost::asio::ssl::verify_peer);
+    if (caFile.empty()) {
+        sslContext->set_default_verify_paths();
+    } else {
+        sslContext->load_verify_file(caFile);
+    }
+    sessionTimeline.record(SessionStage::WsTlsContextInit, start, monotonicNowNs());
+}
+
+void BeastTransport::open(const std::string& url, const std::string& authorization) {
+    if (!sslContext) {
+        initTlsContext();
+    }
+
+    auto conn = std::make_shared<Connection>(ioc, *sslContext);
+    parseUrl(url, conn->host, conn->port, conn->target);
+    conn->authorization = authorization;
+    conn->buffer.reserve(kInitialBufferBytes);
+    current = conn;
+
+    connectStartNs = monotonicNowNs();
+    resolver.async_resolve(conn->host, conn->port,
+                           [this, conn](const boost::system::error_code& ec,
+                                        boost::asio::ip::tcp::resolver::results_type results) {
+        if (ec) {
+            fail(conn, "resolve", ec);
+            return;
+        }
+        startConnect(conn, results);
+    });
+}
+
+void BeastTransport::startConnect(ConnectionPtr conn, const boost::asio::ip::tcp::resolver::results_type& results) {
+    auto& tcp = beast::get_lowest_layer(conn->ws);
+    tcp.expires_after(std::chrono::seconds(30));
+    tcp.async_connect(results, [this, conn](const boost::system::error_code& ec,
+                                            const boost::asio::ip::tcp::endpoint&) {
+        if (ec) {
+            fail(conn, "connect", ec);
+            return;
+        }
+        tcpConnectedNs = monotonicNowNs();
+        sessionTimeline.record(SessionStage::WsResolveConnect, connectStartNs, tcpConnectedNs);
+        appliedTuning = conn->ws.next_layer().next_layer().tune(requestedTuning);
+        startTls(conn);
+    });
+}
+
+void BeastTransport::startTls(ConnectionPtr conn) {
+    auto& tls = conn->ws.next_layer();
+    if (!SSL_set_tlsext_host_name(tls.native_handle(), conn->host.c_str())) {
+        fail(conn, "SNI", boost::system::error_code(static_cast<int>(::ERR_get_error()),
+                                                    boost::asio::error::get_ssl_category()));
+        return;
+    }
+    tls.set_verify_callback(boost::asio::ssl::host_name_verification(conn->host));
+    tls.async_handshake(boost::asio::ssl::stream_base::client, [this, conn](const boost::system::error_code& ec) {
+        if (ec) {
+            fail(conn, "TLS handshake", ec);
+            return;
+        }
+        tlsDoneNs = monotonicNowNs();
+        sessionTimeline.record(SessionStage::WsTlsHandshake, tcpConnectedNs, tlsDoneNs);
+        startUpgrade(conn);
+    });
+}
+
+void BeastTransport::startUpgrade(ConnectionPtr conn) {
+    // The websocket layer has its own timeouts from here on
+    beast::get_lowest_layer(conn->ws).expires_never();
+    conn->ws.set_option(websocket::stream_base::timeout::suggested(beast::role_type::client));
+    conn->ws.set_option(websocket::stream_base::decorator([authorization = conn->authorization](
+                                                              websocket::request_type& req) {
+        if (!authorization.empty()) {
+            req.set(beast::http::field::authorization, authorization);
+        }
+    }));
+    conn->ws.text(true);
+
+    std::string hostHeader = conn->port == "443" ? conn->host : conn->host + ":" + conn->port;
+    conn->ws.async_handshake(hostHeader, conn->target, [this, conn](const boost::system::error_code& ec) {
+        if (ec) {
+            fail(conn, "websocket upgrade", ec);
+            return;
+        }
+        sessionTimeline.record(SessionStage::WsUpgrade, tlsDoneNs, monotonicNowNs());
+        conn->open = true;
+        if (conn == current) {
+            handlers.onOpen();
+        }
+        readNext(conn);
+    });
+}
+
+void BeastTransport::readNext(ConnectionPtr conn) {
+    conn->ws.async_read(conn->buffer, [this, conn](const boost::system::error_code& ec, size_t) {
+        if (ec) {
+            fail(conn, "read", ec);
+            return;
+        }
+        if (conn == current) {
+            // flat_buffer keeps the message contiguous, so the handler gets it in place
+            auto data = conn->buffer.cdata();
+            handlers.onMessage(std::string_view(static_cast<const char*>(data.data()), data.size()));
+        }
+        conn->buffer.consume(conn->buffer.size());
+        if (!conn->closed) {
+            readNext(conn);
+        }
+    });
+}
+
+int64_t BeastTransport::kernelReceiveNs() const {
+    return current ? current->ws.next_layer().next_layer().lastReceiveNs() : 0;
+}
+
+void BeastTransport::send(const std::string& payload) {
+    ConnectionPtr conn = current;
+    if (!conn || !conn->open || conn->closed) {
+        throw std::runtime_error("BeastTransport::send on a connection that is not open");
+    }
+    conn->outbox.push_back(payload);
+    if (conn->outbox.size() == 1) {
+        writeNext(conn);
+    }
+}
+
+void BeastTransport::writeNext(ConnectionPtr conn) {
+    conn->ws.async_write(boost::asio::buffer(conn->outbox.front()),
+                         [this, conn](const boost::system::error_code& ec, size_t) {
+        if (ec) {
+            fail(conn, "write", ec);
+            return;
+        }
+        conn->outbox.pop_front();
+        if (!conn->outbox.empty()) {
+            writeNext(conn);
+        }
+    });
+}
+
+void BeastTransport::drop() {
+    if (current && !current->closed) {
+        boost::system::error_code ec;
+        beast::get_lowest_layer(current->ws).socket().close(ec);
+    }
+}
+
+void BeastTransport::run() {
+    ioc.run();
+}
+
+void BeastTransport::fail(const ConnectionPtr& conn, const char* stage, const boost::system::error_code& ec) {
+    if (conn->closed) {
+        return;
+    }
+    conn->closed = true;
+    bool wasOpen = conn->open;
+    conn->open = false;
+    boost::system::error_code ignored;
+    beast::get_lowest_layer(conn->ws).socket().close(ignored);
+    if (conn != current) {
+        return;
+    }
+    // bad_descriptor is the pending read after drop() closed the socket
+    if (ec != websocket::error::closed && ec != boost::asio::error::operation_aborted &&
+        ec != boost::asio::error::bad_descriptor) {
+        PX_LOG_ERROR("Websocket {} error: {}", stage, ec.message());
+    }
+    handlers.onClose(wasOpen ? "closed" : "failed");
+}
@@ -0,0 +1,81 @@
+#ifndef BEASTTRANSPORT_HPP
+#define BEASTTRANSPORT_HPP
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/ssl/context.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/ssl.hpp>
+#include <boost/beast/websocket.hpp>
+#include <boost/beast/websocket/ssl.hpp>
+#include "FeedTransport.hpp"
+#include "TimestampedTcpStream.hpp"
+
+// FeedTransport on Boost.Beast, the same Asio/OpenSSL stack RestConnection uses. Every message is
+// read into one reusable flat_buffer and handed to onMessage as a view of that buffer, so steady
+// state reads do not allocate. The TLS context is built once, on the first open(). The TCP layer
+// reads with recvmsg, so every message comes with the kernel receive stamp of its last bytes.
+class BeastTransport : public FeedTransport {
+public:
+    explicit BeastTransport(SessionTimeline& timeline);
+
+    const char* name() const override { return "beast"; }
+    void setHandlers(TransportHandlers transportHandlers) override { handlers = std::move(transportHandlers); }
+    void setCaFile(const std::string& path) override { caFile = path; }
+    void setSocketTuning(const SocketTuning& tuning) override { requestedTuning = tuning; }
+    AppliedSocketTuning socketTuning() const override { return appliedTuning; }
+    int64_t kernelReceiveNs() const override;
+    void open(const std::string& url, const std::string& authorization) override;
+    void send(const std::string& payload) override;
+    void drop() override;
+    void run() override;
+    void stop() override { ioc.stop(); }
+    boost::asio::io_context& ioContext() override { return ioc; }
+
+private:
+    using Stream = boost::beast::websocket::stream<boost::beast::ssl_stream<TimestampedTcpStream>>;
+
+    // One connection attempt; handlers hold it alive and ignore it once a newer one exists
+    struct Connection {
+        Connection(boost::asio::io_context& ioc, boost::asio::ssl::context& ctx) : ws(ioc, ctx) {}
+
+        Stream ws;
+        std::string host;
+        std::string port;
+        std::string target;
+        std::string authorization;
+        boost::beast::flat_buffer buffer;
+        std::deque<std::string> outbox;   // async_write allows one write in flight
+        bool open = false;
+        bool closed = false;
+    };
+    using ConnectionPtr = std::shared_ptr<Connection>;
+
+    boost::asio::io_context ioc;
+    boost::asio::ip::tcp::resolver resolver;
+    std::unique_ptr<boost::asio::ssl::context> sslContext;
+    std::string caFile;
+    SocketTuning requestedTuning;
+    AppliedSocketTuning appliedTuning;
+    TransportHandlers handlers;
+    ConnectionPtr current;
+
+    SessionTimeline& sessionTimeline;
+    int64_t connectStartNs = 0;
+    int64_t tcpConnectedNs = 0;
+    int64_t tlsDoneNs = 0;
+
+    void initTlsContext();
+    void startConnect(ConnectionPtr conn, const boost::asio::ip::tcp::resolver::results_type& results);
+    void startTls(ConnectionPtr conn);
+    void startUpgrade(ConnectionPtr conn);
+    void readNext(ConnectionPtr conn);
+    void writeNext(ConnectionPtr conn);
+    void fail(const ConnectionPtr& conn, const char* stage, const boost::system::error_code& ec);
+};
+
+#endif // BEASTTRANSPORT_HPP
@@ -0,0 +1,64 @@
+#include "CompactFeedDecoder.hpp"
+
+DxLinkMessageType CompactFeedDecoder::messageType(std::string_view type) {
+    // FEED_DATA first, it is by far the most frequent message
+    if (type == "FEED_DATA") return DxLinkMessageType::FeedData;
+    if (type == "KEEPALIVE") return DxLinkMessageType::Keepalive;
+    if (type == "AUTH_STATE") return DxLinkMessageType::AuthState;
+    if (type == "CHANNEL_OPENED") return DxLinkMessageType::ChannelOpened;
+    if (type == "CHANNEL_CLOSED") return DxLinkMessageType::ChannelClosed;
+    if (type == "FEED_CONFIG") return DxLinkMessageType::FeedConfig;
+    if (type == "SETUP") return DxLinkMessageType::Setup;
+    if (type == "ERROR") return DxLinkMessageType::Error;
+    return DxLinkMessageType::Unknown;
+}
+
+bool CompactFeedDecoder::scanFrame(std::string_view message, DxLinkFrame& frame) {
+    frame = DxLinkFrame{};
+
+    JsonCursor cursor(message);
+    if (!cursor.consume('{')) {
+        return false;
+    }
+    if (cursor.consume('}')) {
+        return cursor.atEnd();
+    }
+
+    do {
+        std::string_view key;
+        if (!cursor.readString(key) || !cursor.consume(':')) {
+            return false;
+        }
+
+        if (key == "type") {
+            std::string_view type;
+            if (!cursor.readString(type)) {
+                return false;
+            }
+            frame.type = messageType(type);
+        } else if (key == "channel") {
+            double channel;
+            if (!cursor.readNumber(channel) || std::isnan(channel)) {
+                return false;
+            }
+            frame.channel = static_cast<int64_t>(channel);
+        } else if (key == "data") {
+            cursor.peek(); // Skip whitespace so the view starts at the value
+            const char* start = cursor.position();
+            // dxLink puts "data" last; once type and channel are known there is no need to walk
+            // the payload twice, decodeEvents() stops at the end of the array on its own
+            if (frame.type != DxLinkMessageType::Unknown && frame.channel >= 0) {
+                frame.data = std::string_view(start, static_cast<size_t>(message.data() + message.size() - start));
+                return true;
+            }
+            if (!cursor.skipValue()) {
+                return false;
+            }
+            frame.data = std::string_view(start, static_cast<size_t>(cursor.position() - start));
+        } else if (!cursor.skipValue()) {
+            return false;
+        }
+    } while (cursor.consume(','));
+
+    return cursor.consume('}') && cursor.atEnd();
+}
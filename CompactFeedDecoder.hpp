@@ -0,0 +1,426 @@
+#ifndef COMPACTFEEDDECODER_HPP
+#define COMPACTFEEDDECODER_HPP
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "EventSchema.hpp"
+
+// dxLink message types the client dispatches on
+enum class DxLinkMessageType {
+    Unknown,
+    Setup,
+    AuthState,
+    ChannelOpened,
+    ChannelClosed,
+    FeedConfig,
+    FeedData,
+    Keepalive,
+    Error
+};
+
+// Top-level fields of a dxLink frame, viewed in place in the received payload
+struct DxLinkFrame {
+    DxLinkMessageType type = DxLinkMessageType::Unknown;
+    int64_t channel = -1;
+    std::string_view data; // Raw JSON text starting at the "data" value (may run on to the end of the message)
+};
+
+// Minimal forward-only JSON reader over a string_view. Strings are returned as views of the
+// raw text between the quotes (escape sequences are skipped, not decoded), so nothing allocates.
+class JsonCursor {
+public:
+    explicit JsonCursor(std::string_view text) : pos(text.data()), end(text.data() + text.size()) {}
+
+    bool atEnd() { skipWhitespace(); return pos == end; }
+
+    char peek() {
+        skipWhitespace();
+        return pos < end ? *pos : '\0';
+    }
+
+    bool consume(char c) {
+        skipWhitespace();
+        if (pos < end && *pos == c) {
+            ++pos;
+            return true;
+        }
+        return false;
+    }
+
+    bool readString(std::string_view& out) {
+        if (!consume('"')) {
+            return false;
+        }
+        const char* start = pos;
+        while (pos < end && *pos != '"') {
+            pos += (*pos == '\\') ? 2 : 1;
+        }
+        if (pos >= end) {
+            return false;
+        }
+        out = std::string_view(start, static_cast<size_t>(pos - start));
+        ++pos;
+        return true;
+    }
+
+    // Reads a number; dxLink sends "NaN"/"Infinity" as strings and may send null, all of which map to NaN/inf
+    bool readNumber(double& out) {
+        char c = peek();
+        if (c == '"') {
+            std::string_view text;
+            if (!readString(text)) {
+                return false;
+            }
+            if (text == "Infinity") {
+                out = std::numeric_limits<double>::infinity();
+            } else if (text == "-Infinity") {
+                out = -std::numeric_limits<double>::infinity();
+            } else {
+                out = std::numeric_limits<double>::quiet_NaN();
+            }
+            return true;
+        }
+        if (c == 'n') {
+            return readLiteral("null", out);
+        }
+        if (readDecimalFast(out)) {
+            return true;
+        }
+        auto result = std::from_chars(pos, end, out);
+        if (result.ec != std::errc()) {
+            return false;
+        }
+        pos = result.ptr;
+        return true;
+    }
+
+    // Skips one value of any kind, including nested arrays and objects
+    bool skipValue() {
+        char c = peek();
+        if (c == '"') {
+            std::string_view ignored;
+            return readString(ignored);
+        }
+        if (c == '[' || c == '{') {
+            int depth = 0;
+            while (pos < end) {
+                char ch = *pos;
+                if (ch == '"') {
+                    std::string_view ignored;
+                    if (!readString(ignored)) {
+                        return false;
+                    }
+                    continue;
+                }
+                ++pos;
+                if (ch == '[' || ch == '{') {
+                    ++depth;
+                } else if (ch == ']' || ch == '}') {
+                    if (--depth == 0) {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+        // Number, true, false or null
+        const char* start = pos;
+        while (pos < end && *pos != ',' && *pos != ']' && *pos != '}' && !isWhitespace(*pos)) {
+            ++pos;
+        }
+        return pos != start;
+    }
+
+    const char* position() const { return pos; }
+
+private:
+    const char* pos;
+    const char* end;
+
+    static bool isWhitespace(char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+
+    void skipWhitespace() {
+        while (pos < end && isWhitespace(*pos)) {
+            ++pos;
+        }
+    }
+
+    // Exact fast path for plain decimals with at most 15 significant digits (Clinger): the mantissa
+    // and the power of ten are both exact doubles, so one division is correctly rounded.
+    // Anything else (exponents, long mantissas) is left to std::from_chars.
+    bool readDecimalFast(double& out) {
+        static constexpr double kPow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+                                            1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+        const char* p = pos;
+        bool negative = p < end && *p == '-';
+        if (negative) {
+            ++p;
+        }
+        uint64_t mantissa = 0;
+        int digits = 0;
+        int fractionDigits = 0;
+        const char* digitsStart = p;
+        while (p < end && static_cast<unsigned>(*p - '0') < 10) {
+            mantissa = mantissa * 10 + static_cast<unsigned>(*p - '0');
+            ++digits;
+            ++p;
+        }
+        if (p == digitsStart) {
+            return false;
+        }
+        if (p < end && *p == '.') {
+            ++p;
+            while (p < end && static_cast<unsigned>(*p - '0') < 10) {
+                mantissa = mantissa * 10 + static_cast<unsigned>(*p - '0');
+                ++digits;
+                ++fractionDigits;
+                ++p;
+            }
+            if (fractionDigits == 0) {
+                return false;
+            }
+        }
+        if (digits > 15 || (p < end && (*p == 'e' || *p == 'E'))) {
+            return false;
+        }
+        double value = static_cast<double>(mantissa) / kPow10[fractionDigits];
+        out = negative ? -value : value;
+        pos = p;
+        return true;
+    }
+
+    bool readLiteral(std::string_view literal, double& out) {
+        if (static_cast<size_t>(end - pos) < literal.size() || std::string_view(pos, literal.size()) != literal) {
+            return false;
+        }
+        pos += literal.size();
+        out = std::numeric_limits<double>::quiet_NaN();
+        return true;
+    }
+};
+
+// Field readers the schema decoders are generated from: one overload per member type, so the
+// type dispatch happens at compile time
+namespace event_decode {
+
+inline bool readField(JsonCursor& cursor, std::string_view& out) {
+    if (cursor.peek() == 'n') {
+        out = std::string_view();
+        return cursor.skipValue();
+    }
+    return cursor.readString(out);
+}
+
+inline bool readField(JsonCursor& cursor, double& out) {
+    return cursor.readNumber(out);
+}
+
+inline bool readField(JsonCursor& cursor, int64_t& out) {
+    double value;
+    if (!cursor.readNumber(value)) {
+        return false;
+    }
+    out = std::fabs(value) < 9.2e18 ? static_cast<int64_t>(value) : 0; // NaN fails the comparison too
+    return true;
+}
+
+template <typename Event, size_t I>
+bool readColumn(JsonCursor& cursor, Event& event) {
+    return readField(cursor, event.*(std::get<I>(EventSchema<Event>::fields).member));
+}
+
+template <typename Event>
+bool skipColumn(JsonCursor& cursor, Event&) {
+    return cursor.skipValue();
+}
+
+// One record in schema order, unrolled at compile time: every field is a direct read into its member
+template <typename Event, size_t... I>
+bool readRecord(JsonCursor& cursor, Event& event, std::index_sequence<I...>) {
+    return (((I == 0 || cursor.consume(',')) && readColumn<Event, I>(cursor, event)) && ...);
+}
+
+template <typename Event>
+using ColumnReader = bool (*)(JsonCursor&, Event&);
+
+template <typename Event, size_t... I>
+constexpr std::array<ColumnReader<Event>, sizeof...(I)> columnReaders(std::index_sequence<I...>) {
+    return {&readColumn<Event, I>...};
+}
+
+} // namespace event_decode
+
+// How one event type's records are laid out on the wire. Empty while the server sends the fields
+// in schema order; otherwise one reader per server column (columns without a schema field are
+// skipped, schema fields the server does not send stay NaN/empty).
+template <typename Event>
+struct EventColumns {
+    std::vector<event_decode::ColumnReader<Event>> readers;
+    Event blank = emptyEvent<Event>();
+
+    void assign(const std::vector<std::string_view>& fields) {
+        static constexpr auto names = eventFieldNames<Event>();
+        static constexpr auto all = event_decode::columnReaders<Event>(std::make_index_sequence<eventFieldCount<Event>>{});
+        readers.clear();
+        if (fields.empty() || std::equal(fields.begin(), fields.end(), names.begin(), names.end())) {
+            return;
+        }
+        for (std::string_view field : fields) {
+            auto found = std::find(names.begin(), names.end(), field);
+            readers.push_back(found == names.end() ? &event_decode::skipColumn<Event>
+                                                   : all[static_cast<size_t>(found - names.begin())]);
+        }
+    }
+
+    bool remapped() const { return !readers.empty(); }
+};
+
+// The wire layout of every event type on a channel, taken from the eventFields of FEED_CONFIG.
+// dxLink may answer FEED_SETUP with its own field order; records are then read through the column
+// map instead of the fixed schema order, so a reordered feed still decodes correctly.
+class FeedLayout {
+public:
+    // Applies the server's field list for eventType; returns false if there is no schema for it
+    bool configure(std::string_view eventType, const std::vector<std::string_view>& fields) {
+        bool known = false;
+        forEachEventSchema([&](auto schema) {
+            using Schema = decltype(schema);
+            if (eventType == Schema::name) {
+                std::get<EventColumns<typename Schema::Event>>(layouts).assign(fields);
+                known = true;
+            }
+        });
+        return known;
+    }
+
+    // Back to schema order for every event type
+    void reset() {
+        forEachEventSchema([&](auto schema) {
+            std::get<EventColumns<typename decltype(schema)::Event>>(layouts).readers.clear();
+        });
+    }
+
+    template <typename Event>
+    const EventColumns<Event>& columns() const {
+        return std::get<EventColumns<Event>>(layouts);
+    }
+
+private:
+    std::tuple<EventColumns<QuoteEvent>, EventColumns<TradeEvent>, EventColumns<SummaryEvent>,
+               EventColumns<GreeksEvent>, EventColumns<TimeAndSaleEvent>> layouts;
+};
+
+// Zero-allocation decoder for dxLink frames. scanFrame() reads the top-level object once to find
+// "type", "channel" and "data"; decodeEvents() then walks the COMPACT FEED_DATA payload in place.
+class CompactFeedDecoder {
+public:
+    static constexpr size_t kQuoteFieldCount = eventFieldCount<QuoteEvent>;
+
+    // Returns false if the message is not a well-formed JSON object
+    static bool scanFrame(std::string_view message, DxLinkFrame& frame);
+
+    static DxLinkMessageType messageType(std::string_view type);
+
+    // Walks a COMPACT "data" array ([eventType, [values...], eventType, [values...], ...]) and calls
+    // handler(const E&) for every record of each event type E it accepts; records of other types
+    // are skipped. Returns the number of records decoded, or -1 if the payload is malformed.
+    template <typename Handler>
+    static long decodeEvents(std::string_view data, const FeedLayout& layout, Handler&& handler) {
+        JsonCursor cursor(data);
+        if (!cursor.consume('[')) {
+            return -1;
+        }
+        long count = 0;
+        if (cursor.consume(']')) {
+            return count;
+        }
+        do {
+            std::string_view feedType;
+            if (!cursor.readString(feedType) || !cursor.consume(',')) {
+                return -1;
+            }
+            long decoded = decodeBatch(feedType, cursor, layout, handler);
+            if (decoded < 0) {
+                return -1;
+            }
+            count += decoded;
+        } while (cursor.consume(','));
+        return cursor.consume(']') ? count : -1;
+    }
+
+    // Quote records only, in schema order; calls onQuote(const QuoteEvent&)
+    template <typename Handler>
+    static long decodeQuotes(std::string_view data, Handler&& onQuote) {
+        static const FeedLayout schemaOrder;
+        return decodeEvents(data, schemaOrder, [&onQuote](const QuoteEvent& quote) { onQuote(quote); });
+    }
+
+private:
+    // One [values...] array of feedType; returns its record count (0 if skipped) or -1
+    template <typename Handler>
+    static long decodeBatch(std::string_view feedType, JsonCursor& cursor, const FeedLayout& layout,
+                            Handler& handler) {
+        long decoded = -2;
+        forEachEventSchema([&](auto schema) {
+            using Event = typename decltype(schema)::Event;
+            if (decoded != -2 || feedType != decltype(schema)::name) {
+                return;
+            }
+            if constexpr (std::is_invocable_v<Handler&, const Event&>) {
+                decoded = decodeRecords(cursor, layout.columns<Event>(), handler);
+            } else {
+                decoded = cursor.skipValue() ? 0 : -1;
+            }
+        });
+        if (decoded == -2) {
+            decoded = cursor.skipValue() ? 0 : -1;
+        }
+        return decoded;
+    }
+
+    template <typename Event, typename Handler>
+    static long decodeRecords(JsonCursor& cursor, const EventColumns<Event>& columns, Handler& handler) {
+        if (!cursor.consume('[')) {
+            return -1;
+        }
+        long count = 0;
+        if (cursor.consume(']')) {
+            return count;
+        }
+        if (!columns.remapped()) {
+            do {
+                Event event;
+                if (!event_decode::readRecord(cursor, event, std::make_index_sequence<eventFieldCount<Event>>{})) {
+                    return -1;
+                }
+                handler(static_cast<const Event&>(event));
+                ++count;
+            } while (cursor.consume(','));
+        } else {
+            const size_t columnCount = columns.readers.size();
+            do {
+                Event event = columns.blank;
+                for (size_t i = 0; i < columnCount; ++i) {
+                    if ((i > 0 && !cursor.consume(',')) || !columns.readers[i](cursor, event)) {
+                        return -1;
+                    }
+                }
+                handler(static_cast<const Event&>(event));
+                ++count;
+            } while (cursor.consume(','));
+        }
+        return cursor.consume(']') ? count : -1;
+    }
+};
+
+#endif // COMPACTFEEDDECODER_HPP
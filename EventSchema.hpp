@@ -0,0 +1,263 @@
+#ifndef EVENTSCHEMA_HPP
+#define EVENTSCHEMA_HPP
+
+#include <array>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+// dxFeed event types the client can subscribe to on its FEED channel
+enum class EventType : uint8_t {
+    Quote,
+    Trade,
+    Summary,
+    Greeks,
+    TimeAndSale
+};
+
+constexpr size_t kEventTypeCount = 5;
+
+// A set of event types, one bit per EventType
+using EventTypeSet = uint32_t;
+
+constexpr EventTypeSet eventTypeBit(EventType type) {
+    return EventTypeSet{1} << static_cast<unsigned>(type);
+}
+
+// Decoded COMPACT records. Strings are views into the received frame and only valid while the
+// frame is being processed; numbers dxLink sends as "NaN" or null are NaN (0 for times).
+struct QuoteEvent {
+    std::string_view eventType;
+    std::string_view eventSymbol;
+    double bidPrice;
+    double askPrice;
+    double bidSize;
+    double askSize;
+};
+
+struct TradeEvent {
+    std::string_view eventType;
+    std::string_view eventSymbol;
+    int64_t time;           // ms since the epoch
+    double price;
+    double size;
+    double dayVolume;
+};
+
+struct SummaryEvent {
+    std::string_view eventType;
+    std::string_view eventSymbol;
+    double dayOpenPrice;
+    double dayHighPrice;
+    double dayLowPrice;
+    double dayClosePrice;
+    double prevDayClosePrice;
+    double openInterest;
+};
+
+struct GreeksEvent {
+    std::string_view eventType;
+    std::string_view eventSymbol;
+    int64_t time;
+    double price;
+    double volatility;
+    double delta;
+    double gamma;
+    double theta;
+    double rho;
+    double vega;
+};
+
+struct TimeAndSaleEvent {
+    std::string_view eventType;
+    std::string_view eventSymbol;
+    int64_t time;
+    std::string_view exchangeCode;
+    double price;
+    double size;
+    double bidPrice;
+    double askPrice;
+    std::string_view aggressorSide;   // BUY, SELL or UNDEFINED
+};
+
+// One column of a COMPACT record: the dxLink field name and the member it is decoded into
+template <typename Event, typename T>
+struct EventField {
+    std::string_view name;
+    T Event::*member;
+};
+
+template <typename Event, typename T>
+constexpr EventField<Event, T> eventField(std::string_view name, T Event::*member) {
+    return EventField<Event, T>{name, member};
+}
+
+// Every event type is described exactly once, here: its dxLink name and its fields in the order
+// requested in FEED_SETUP acceptEventFields. The FEED_SETUP message, the subscription entries and
+// the decoders in CompactFeedDecoder are all generated from these specializations.
+template <typename Event>
+struct EventSchema;
+
+template <>
+struct EventSchema<QuoteEvent> {
+    using Event = QuoteEvent;
+    static constexpr EventType type = EventType::Quote;
+    static constexpr std::string_view name = "Quote";
+    static constexpr auto fields = std::make_tuple(
+        eventField("eventType", &QuoteEvent::eventType),
+        eventField("eventSymbol", &QuoteEvent::eventSymbol),
+        eventField("bidPrice", &QuoteEvent::bidPrice),
+        eventField("askPrice", &QuoteEvent::askPrice),
+        eventField("bidSize", &QuoteEvent::bidSize),
+        eventField("askSize", &QuoteEvent::askSize));
+};
+
+template <>
+struct EventSchema<TradeEvent> {
+    using Event = TradeEvent;
+    static constexpr EventType type = EventType::Trade;
+    static constexpr std::string_view name = "Trade";
+    static constexpr auto fields = std::make_tuple(
+        eventField("eventType", &TradeEvent::eventType),
+        eventField("eventSymbol", &TradeEvent::eventSymbol),
+        eventField("time", &TradeEvent::time),
+        eventField("price", &TradeEvent::price),
+        eventField("size", &TradeEvent::size),
+        eventField("dayVolume", &TradeEvent::dayVolume));
+};
+
+template <>
+struct EventSchema<SummaryEvent> {
+    using Event = SummaryEvent;
+    static constexpr EventType type = EventType::Summary;
+    static constexpr std::string_view name = "Summary";
+    static constexpr auto fields = std::make_tuple(
+        eventField("eventType", &SummaryEvent::eventType),
+        eventField("eventSymbol", &SummaryEvent::eventSymbol),
+        eventField("dayOpenPrice", &SummaryEvent::dayOpenPrice),
+        eventField("dayHighPrice", &SummaryEvent::dayHighPrice),
+        eventField("dayLowPrice", &SummaryEvent::dayLowPrice),
+        eventField("dayClosePrice", &SummaryEvent::dayClosePrice),
+        eventField("prevDayClosePrice", &SummaryEvent::prevDayClosePrice),
+        eventField("openInterest", &SummaryEvent::openInterest));
+};
+
+template <>
+struct EventSchema<GreeksEvent> {
+    using Event = GreeksEvent;
+    static constexpr EventType type = EventType::Greeks;
+    static constexpr std::string_view name = "Greeks";
+    static constexpr auto fields = std::make_tuple(
+        eventField("eventType", &GreeksEvent::eventType),
+        eventField("eventSymbol", &GreeksEvent::eventSymbol),
+        eventField("time", &GreeksEvent::time),
+        eventField("price", &GreeksEvent::price),
+        eventField("volatility", &GreeksEvent::volatility),
+        eventField("delta", &GreeksEvent::delta),
+        eventField("gamma", &GreeksEvent::gamma),
+        eventField("theta", &GreeksEvent::theta),
+        eventField("rho", &GreeksEvent::rho),
+        eventField("vega", &GreeksEvent::vega));
+};
+
+template <>
+struct EventSchema<TimeAndSaleEvent> {
+    using Event = TimeAndSaleEvent;
+    static constexpr EventType type = EventType::TimeAndSale;
+    static constexpr std::string_view name = "TimeAndSale";
+    static constexpr auto fields = std::make_tuple(
+        eventField("eventType", &TimeAndSaleEvent::eventType),
+        eventField("eventSymbol", &TimeAndSaleEvent::eventSymbol),
+        eventField("time", &TimeAndSaleEvent::time),
+        eventField("exchangeCode", &TimeAndSaleEvent::exchangeCode),
+        eventField("price", &TimeAndSaleEvent::price),
+        eventField("size", &TimeAndSaleEvent::size),
+        eventField("bidPrice", &TimeAndSaleEvent::bidPrice),
+        eventField("askPrice", &TimeAndSaleEvent::askPrice),
+        eventField("aggressorSide", &TimeAndSaleEvent::aggressorSide));
+};
+
+// Calls fn(EventSchema<E>{}) for every event type, in EventType order
+template <typename Fn>
+void forEachEventSchema(Fn&& fn) {
+    fn(EventSchema<QuoteEvent>{});
+    fn(EventSchema<TradeEvent>{});
+    fn(EventSchema<SummaryEvent>{});
+    fn(EventSchema<GreeksEvent>{});
+    fn(EventSchema<TimeAndSaleEvent>{});
+}
+
+template <typename Event>
+constexpr size_t eventFieldCount = std::tuple_size_v<std::decay_t<decltype(EventSchema<Event>::fields)>>;
+
+// The field names of an event type in schema order
+template <typename Event>
+constexpr std::array<std::string_view, eventFieldCount<Event>> eventFieldNames() {
+    return std::apply([](const auto&... field) {
+        return std::array<std::string_view, sizeof...(field)>{field.name...};
+    }, EventSchema<Event>::fields);
+}
+
+// A record with every number NaN (times 0) and every string empty, for fields the server does not send
+template <typename Event>
+Event emptyEvent() {
+    Event event{};
+    std::apply([&event](const auto&... field) {
+        auto clear = [](auto& value) {
+            if constexpr (std::is_floating_point_v<std::decay_t<decltype(value)>>) {
+                value = std::numeric_limits<double>::quiet_NaN();
+            }
+        };
+        (clear(event.*(field.member)), ...);
+    }, EventSchema<Event>::fields);
+    return event;
+}
+
+inline std::string_view eventTypeName(EventType type) {
+    std::string_view name;
+    forEachEventSchema([&](auto schema) {
+        if (decltype(schema)::type == type) {
+            name = decltype(schema)::name;
+        }
+    });
+    return name;
+}
+
+// Parses a comma-separated list of event type names ("Quote,Trade", case-insensitive) into types.
+// Returns false on an unknown name.
+inline bool parseEventTypes(std::string_view list, EventTypeSet& types) {
+    EventTypeSet parsed = 0;
+    while (!list.empty()) {
+        size_t comma = list.find(',');
+        std::string_view item = list.substr(0, comma);
+        list = comma == std::string_view::npos ? std::string_view() : list.substr(comma + 1);
+        if (item.empty()) {
+            continue;
+        }
+        bool known = false;
+        forEachEventSchema([&](auto schema) {
+            std::string_view name = decltype(schema)::name;
+            if (name.size() != item.size()) {
+                return;
+            }
+            for (size_t i = 0; i < name.size(); ++i) {
+                if (std::tolower(static_cast<unsigned char>(name[i])) != std::tolower(static_cast<unsigned char>(item[i]))) {
+                    return;
+                }
+            }
+            parsed |= eventTypeBit(decltype(schema)::type);
+            known = true;
+        });
+        if (!known) {
+            return false;
+        }
+    }
+    types = parsed;
+    return true;
+}
+
+#endif // EVENTSCHEMA_HPP
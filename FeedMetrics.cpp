@@ -0,0 +1,160 @@
+#include "FeedMetrics.hpp"
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "MonotonicClock.hpp"
+
+namespace {
+
+// Prometheus label values escape backslash, quote and newline
+std::string labelValue(std::string_view value) {
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (char c : value) {
+        if (c == '\\' || c == '"') {
+            escaped += '\\';
+            escaped += c;
+        } else if (c == '\n') {
+            escaped += "\\n";
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+void writeHeader(std::ostream& out, std::string_view name, std::string_view type, std::string_view help) {
+    out << "# HELP " << name << ' ' << help << "\n# TYPE " << name << ' ' << type << '\n';
+}
+
+double seconds(int64_t nanoseconds) {
+    return static_cast<double>(nanoseconds) / 1e9;
+}
+
+} // namespace
+
+FeedMetrics::FeedMetrics(size_t capacity)
+    : symbolCapacity(capacity), symbols(std::make_unique<SymbolSlot[]>(capacity)), startNs(monotonicNowNs()),
+      previousRenderNs(startNs) {}
+
+bool FeedMetrics::isStale(const SymbolSlot& slot, int64_t nowNs, int64_t thresholdNs) const {
+    if (thresholdNs <= 0) {
+        return false;
+    }
+    int64_t last = slot.lastNs.load(std::memory_order_relaxed);
+    return nowNs - (last != 0 ? last : startNs) > thresholdNs;
+}
+
+size_t FeedMetrics::staleCount(const QuoteBook& book, int64_t nowNs) const {
+    int64_t thresholdNs = staleAfterNs.load(std::memory_order_relaxed);
+    size_t count = std::min(book.size(), symbolCapacity);
+    size_t stale = 0;
+    for (size_t id = 0; id < count; ++id) {
+        stale += isStale(symbols[id], nowNs, thresholdNs) ? 1 : 0;
+    }
+    return stale;
+}
+
+void FeedMetrics::writeMetric(std::ostream& out, std::string_view name, std::string_view type, std::string_view help,
+                              double value) {
+    writeHeader(out, name, type, help);
+    out << name << ' ' << value << '\n';
+}
+
+void FeedMetrics::render(std::ostream& out, const QuoteBook& book, int64_t nowNs) {
+    std::lock_guard<std::mutex> lock(renderMutex);
+    uint64_t frameTotal = frames.load(std::memory_order_relaxed);
+    uint64_t byteTotal = frameBytes.load(std::memory_order_relaxed);
+    int64_t lastFrame = lastFrameNs.load(std::memory_order_relaxed);
+    int64_t thresholdNs = staleAfterNs.load(std::memory_order_relaxed);
+    size_t count = std::min(book.size(), symbolCapacity);
+
+    uint64_t updateTotal = 0;
+    for (size_t id = 0; id < count; ++id) {
+        updateTotal += symbols[id].updates.load(std::memory_order_relaxed);
+    }
+    double interval = seconds(nowNs - previousRenderNs);
+
+    writeMetric(out, "dxfeed_frames_total", "counter", "Websocket messages received",
+                static_cast<double>(frameTotal));
+    writeMetric(out, "dxfeed_bytes_total", "counter", "Websocket payload bytes received",
+                static_cast<double>(byteTotal));
+    writeMetric(out, "dxfeed_parse_errors_total", "counter", "Messages that could not be parsed",
+                static_cast<double>(parseErrors.load(std::memory_order_relaxed)));
+    writeMetric(out, "dxfeed_updates_total", "counter", "Quotes of tracked symbols",
+                static_cast<double>(updateTotal));
+    if (interval > 0) {
+        writeMetric(out, "dxfeed_frames_per_second", "gauge", "Message rate since the previous scrape",
+                    static_cast<double>(frameTotal - previousFrames) / interval);
+        writeMetric(out, "dxfeed_bytes_per_second", "gauge", "Payload byte rate since the previous scrape",
+                    static_cast<double>(byteTotal - previousBytes) / interval);
+        writeMetric(out, "dxfeed_updates_per_second", "gauge", "Tracked-symbol quote rate since the previous scrape",
+                    static_cast<double>(updateTotal - previousUpdates) / interval);
+    }
+    writeMetric(out, "dxfeed_seconds_since_last_frame", "gauge", "Time since the last message (-1: none yet)",
+                lastFrame != 0 ? seconds(nowNs - lastFrame) : -1.0);
+
+    writeHeader(out, "dxfeed_frame_interarrival_seconds", "histogram", "Time between consecutive messages");
+    uint64_t cumulative = 0;
+    for (size_t bucket = 0; bucket < kGapBuckets; ++bucket) {
+        cumulative += gapBuckets[bucket].load(std::memory_order_relaxed);
+        out << "dxfeed_frame_interarrival_seconds_bucket{le=\"";
+        if (bucket + 1 < kGapBuckets) {
+            out << static_cast<double>(uint64_t{1} << bucket) / 1e6;
+        } else {
+            out << "+Inf";
+        }
+        out << "\"} " << cumulative << '\n';
+    }
+    out << "dxfeed_frame_interarrival_seconds_sum "
+        << seconds(static_cast<int64_t>(gapSumNs.load(std::memory_order_relaxed))) << '\n';
+    out << "dxfeed_frame_interarrival_seconds_count " << cumulative << '\n';
+
+    // Per symbol: one family at a time, as the text format requires. A value below 0 skips the symbol.
+    std::vector<std::string> labels(count);
+    for (size_t id = 0; id < count; ++id) {
+        labels[id] = "{symbol=\"" + labelValue(book.symbol(static_cast<int32_t>(id))) + "\"} ";
+    }
+    auto writeSymbols = [&](std::string_view name, std::string_view type, std::string_view help, auto value) {
+        writeHeader(out, name, type, help);
+        for (size_t id = 0; id < count; ++id) {
+            double v = value(symbols[id]);
+            if (v >= 0) {
+                out << name << labels[id] << v << '\n';
+            }
+        }
+    };
+    writeSymbols("dxfeed_symbol_updates_total", "counter", "Quotes per symbol", [](const SymbolSlot& slot) {
+        return static_cast<double>(slot.updates.load(std::memory_order_relaxed));
+    });
+    writeSymbols("dxfeed_symbol_seconds_since_update", "gauge", "Time since the symbol's last quote",
+                 [nowNs](const SymbolSlot& slot) {
+        int64_t last = slot.lastNs.load(std::memory_order_relaxed);
+        return last != 0 ? seconds(nowNs - last) : -1.0;
+    });
+    writeSymbols("dxfeed_symbol_mean_interarrival_seconds", "gauge", "Mean time between the symbol's quotes",
+                 [](const SymbolSlot& slot) {
+        uint64_t updates = slot.updates.load(std::memory_order_relaxed);
+        int64_t span = slot.lastNs.load(std::memory_order_relaxed) - slot.firstNs.load(std::memory_order_relaxed);
+        return updates >= 2 ? seconds(span) / static_cast<double>(updates - 1) : -1.0;
+    });
+    writeSymbols("dxfeed_symbol_max_interarrival_seconds", "gauge", "Longest time between two of the symbol's quotes",
+                 [](const SymbolSlot& slot) {
+        return seconds(slot.maxGapNs.load(std::memory_order_relaxed));
+    });
+    size_t stale = 0;
+    writeSymbols("dxfeed_symbol_stale", "gauge", "1 if the symbol has been quiet longer than the stale threshold",
+                 [&](const SymbolSlot& slot) {
+        bool symbolStale = isStale(slot, nowNs, thresholdNs);
+        stale += symbolStale ? 1 : 0;
+        return symbolStale ? 1.0 : 0.0;
+    });
+    writeMetric(out, "dxfeed_stale_symbols", "gauge", "Tracked symbols quiet longer than the stale threshold",
+                static_cast<double>(stale));
+    writeMetric(out, "dxfeed_stale_threshold_seconds", "gauge", "Stale threshold (0: off)", seconds(thresholdNs));
+
+    previousRenderNs = nowNs;
+    previousFrames = frameTotal;
+    previousBytes = byteTotal;
+    previousUpdates = updateTotal;
+}
@@ -0,0 +1,121 @@
+#ifndef FEEDMETRICS_HPP
+#define FEEDMETRICS_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+#include "QuoteBook.hpp"
+
+// Health and throughput counters of one feed connection, exported in the Prometheus text format.
+// The feed thread is the only writer: every counter is an atomic bumped with a relaxed load and
+// store (no locked instruction, as in QuoteDispatcher), so render() can read them from any thread
+// while the feed runs. Per-symbol slots are indexed by QuoteBook id.
+class FeedMetrics {
+public:
+    // Frame inter-arrival buckets: bucket k counts gaps below 2^k microseconds (the last one: any)
+    static constexpr size_t kGapBuckets = 24;
+
+    // symbolCapacity: capacity of the QuoteBook whose ids are passed to onSymbolUpdate()
+    explicit FeedMetrics(size_t symbolCapacity);
+
+    FeedMetrics(const FeedMetrics&) = delete;
+    FeedMetrics& operator=(const FeedMetrics&) = delete;
+
+    // Every websocket message as it arrives
+    void onFrame(size_t bytes, int64_t receiveTimeNs) {
+        bump(frames, 1);
+        bump(frameBytes, bytes);
+        int64_t last = lastFrameNs.load(std::memory_order_relaxed);
+        if (last != 0 && receiveTimeNs > last) {
+            uint64_t gap = static_cast<uint64_t>(receiveTimeNs - last);
+            bump(gapBuckets[gapBucket(gap)], 1);
+            bump(gapSumNs, gap);
+        }
+        lastFrameNs.store(receiveTimeNs, std::memory_order_relaxed);
+    }
+
+    // Every quote of a tracked symbol
+    void onSymbolUpdate(int32_t symbolId, int64_t receiveTimeNs) {
+        SymbolSlot& slot = symbols[static_cast<size_t>(symbolId)];
+        bump(slot.updates, 1);
+        int64_t last = slot.lastNs.load(std::memory_order_relaxed);
+        if (last == 0) {
+            slot.firstNs.store(receiveTimeNs, std::memory_order_relaxed);
+        } else if (receiveTimeNs - last > slot.maxGapNs.load(std::memory_order_relaxed)) {
+            slot.maxGapNs.store(receiveTimeNs - last, std::memory_order_relaxed);
+        }
+        slot.lastNs.store(receiveTimeNs, std::memory_order_relaxed);
+    }
+
+    // A message that could not be parsed
+    void onParseError() { bump(parseErrors, 1); }
+
+    // A symbol is stale once nothing arrived for it for this long (from construction if it never
+    // quoted). 0 turns the check off.
+    void setStaleAfter(int64_t nanoseconds) { staleAfterNs.store(nanoseconds, std::memory_order_relaxed); }
+    int64_t staleAfter() const { return staleAfterNs.load(std::memory_order_relaxed); }
+
+    uint64_t frameCount() const { return frames.load(std::memory_order_relaxed); }
+    uint64_t byteCount() const { return frameBytes.load(std::memory_order_relaxed); }
+    uint64_t parseErrorCount() const { return parseErrors.load(std::memory_order_relaxed); }
+    uint64_t symbolUpdates(int32_t symbolId) const {
+        return symbols[static_cast<size_t>(symbolId)].updates.load(std::memory_order_relaxed);
+    }
+
+    // Number of book symbols that are stale at nowNs
+    size_t staleCount(const QuoteBook& book, int64_t nowNs) const;
+
+    // Writes every metric for the symbols in book. The rate gauges cover the time since the previous
+    // render() (since construction for the first one). Safe from any thread.
+    void render(std::ostream& out, const QuoteBook& book, int64_t nowNs);
+
+    // One "# HELP / # TYPE / value" block, for counters kept elsewhere (dispatcher, reconnects)
+    static void writeMetric(std::ostream& out, std::string_view name, std::string_view type, std::string_view help,
+                            double value);
+
+    static size_t gapBucket(uint64_t gapNs) {
+        uint64_t micros = gapNs / 1000;
+        size_t bucket = micros == 0 ? 0 : static_cast<size_t>(64 - __builtin_clzll(micros));
+        return bucket < kGapBuckets ? bucket : kGapBuckets - 1;
+    }
+
+private:
+    struct SymbolSlot {
+        std::atomic<uint64_t> updates{0};
+        std::atomic<int64_t> firstNs{0};
+        std::atomic<int64_t> lastNs{0};
+        std::atomic<int64_t> maxGapNs{0};
+    };
+
+    static void bump(std::atomic<uint64_t>& counter, uint64_t amount) {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    bool isStale(const SymbolSlot& slot, int64_t nowNs, int64_t thresholdNs) const;
+
+    const size_t symbolCapacity;
+    std::unique_ptr<SymbolSlot[]> symbols;
+    const int64_t startNs;
+    std::atomic<int64_t> staleAfterNs{0};
+
+    // Feed-thread counters
+    alignas(64) std::atomic<uint64_t> frames{0};
+    std::atomic<uint64_t> frameBytes{0};
+    std::atomic<uint64_t> parseErrors{0};
+    std::atomic<int64_t> lastFrameNs{0};
+    std::atomic<uint64_t> gapSumNs{0};
+    std::array<std::atomic<uint64_t>, kGapBuckets> gapBuckets{};
+
+    // Scraper side: the previous render's totals for the rate gauges
+    alignas(64) std::mutex renderMutex;
+    int64_t previousRenderNs;
+    uint64_t previousFrames = 0;
+    uint64_t previousBytes = 0;
+    uint64_t previousUpdates = 0;
+};
+
+#endif // FEEDMETRICS_HPP
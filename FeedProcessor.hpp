@@ -0,0 +1,138 @@
+#ifndef FEEDPROCESSOR_HPP
+#define FEEDPROCESSOR_HPP
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <utility>
+#include "CompactFeedDecoder.hpp"
+#include "EventSchema.hpp"
+#include "FeedMetrics.hpp"
+#include "QuoteBook.hpp"
+#include "QuoteDispatcher.hpp"
+#include "SessionTimeline.hpp"
+#include "SubscriptionManager.hpp"
+
+// Callbacks for the event types other than Quote, run on the thread that decodes the frame (the
+// feed I/O thread). The event's strings point into the frame: copy what must outlive the call.
+struct MarketEventHandlers {
+    std::function<void(const TradeEvent&, int64_t receiveTimeNs)> onTrade;
+    std::function<void(const SummaryEvent&, int64_t receiveTimeNs)> onSummary;
+    std::function<void(const GreeksEvent&, int64_t receiveTimeNs)> onGreeks;
+    std::function<void(const TimeAndSaleEvent&, int64_t receiveTimeNs)> onTimeAndSale;
+};
+
+// The FEED_DATA hot path without any transport: decode a COMPACT payload, update the QuoteBook
+// and publish QuoteRecords; the other event types go to the MarketEventHandlers. MarketDataWebSocket
+// drives it from onMessage; benchmarks and replay tools drive it directly with recorded or
+// synthetic frames.
+class FeedProcessor {
+public:
+    FeedProcessor(QuoteBook& book, QuoteDispatcher& dispatcher, SessionTimeline& timeline)
+        : quoteBook(&book), quoteDispatcher(dispatcher), sessionTimeline(timeline) {}
+
+    void setBook(QuoteBook& book) { quoteBook = &book; }
+
+    // Marks symbols live in subscriptions as their quotes arrive (nullptr: no tracking)
+    void setSubscriptions(SubscriptionManager* manager) { subscriptions = manager; }
+
+    // Counts every tracked symbol's quotes in metrics, which must be sized to the book (nullptr: off)
+    void setMetrics(FeedMetrics* feedMetrics) { metrics = feedMetrics; }
+
+    // Start of the subscription -> first quote stage
+    void setSubscriptionSentNs(int64_t timestampNs) { subscriptionSentNs = timestampNs; }
+
+    void setEventHandlers(MarketEventHandlers handlers) { eventHandlers = std::move(handlers); }
+
+    // Field order of each event type as the server sends it (from FEED_CONFIG)
+    FeedLayout& layout() { return feedLayout; }
+
+    // Records of one event type decoded so far
+    uint64_t eventCount(EventType type) const { return eventCounts[static_cast<size_t>(type)]; }
+
+    // Decodes the "data" member of a FEED_DATA frame. Returns the number of events, or -1 if malformed.
+    long onFeedData(std::string_view feedData, int64_t receiveTimeNs) {
+        return CompactFeedDecoder::decodeEvents(feedData, feedLayout, [this, receiveTimeNs](const auto& event) {
+            onEvent(event, receiveTimeNs);
+        });
+    }
+
+    // Scans a complete message and processes it if it is FEED_DATA for channel.
+    // Returns the number of events, 0 for other messages, or -1 if malformed.
+    long onMessage(std::string_view message, int64_t channel, int64_t receiveTimeNs) {
+        DxLinkFrame frame;
+        if (!CompactFeedDecoder::scanFrame(message, frame)) {
+            return -1;
+        }
+        if (frame.type != DxLinkMessageType::FeedData || frame.channel != channel) {
+            return 0;
+        }
+        return onFeedData(frame.data, receiveTimeNs);
+    }
+
+private:
+    QuoteBook* quoteBook;
+    QuoteDispatcher& quoteDispatcher;
+    SessionTimeline& sessionTimeline;
+    SubscriptionManager* subscriptions = nullptr;
+    FeedMetrics* metrics = nullptr;
+    int64_t subscriptionSentNs = 0;
+    MarketEventHandlers eventHandlers;
+    FeedLayout feedLayout;
+    std::array<uint64_t, kEventTypeCount> eventCounts{};
+
+    void onEvent(const QuoteEvent& quote, int64_t receiveTimeNs) {
+        ++eventCounts[static_cast<size_t>(EventType::Quote)];
+        onQuote(quote, receiveTimeNs);
+    }
+
+    template <typename Event, typename Handler>
+    void dispatch(const Event& event, const Handler& handler, int64_t receiveTimeNs) {
+        ++eventCounts[static_cast<size_t>(EventSchema<Event>::type)];
+        if (handler) {
+            handler(event, receiveTimeNs);
+        }
+    }
+
+    void onEvent(const TradeEvent& trade, int64_t receiveTimeNs) {
+        dispatch(trade, eventHandlers.onTrade, receiveTimeNs);
+    }
+    void onEvent(const SummaryEvent& summary, int64_t receiveTimeNs) {
+        dispatch(summary, eventHandlers.onSummary, receiveTimeNs);
+    }
+    void onEvent(const GreeksEvent& greeks, int64_t receiveTimeNs) {
+        dispatch(greeks, eventHandlers.onGreeks, receiveTimeNs);
+    }
+    void onEvent(const TimeAndSaleEvent& sale, int64_t receiveTimeNs) {
+        dispatch(sale, eventHandlers.onTimeAndSale, receiveTimeNs);
+    }
+
+    void onQuote(const QuoteEvent& quote, int64_t receiveTimeNs) {
+        int32_t symbolId = quoteBook->find(quote.eventSymbol);
+        if (symbolId != QuoteBook::kNotFound) {
+            if (quoteBook->update(symbolId, quote.bidPrice, quote.askPrice, quote.bidSize, quote.askSize,
+                                  receiveTimeNs)) {
+                sessionTimeline.record(SessionStage::SubscriptionToFirstQuote, subscriptionSentNs, receiveTimeNs);
+            }
+            if (subscriptions) {
+                subscriptions->onQuote(symbolId, receiveTimeNs);
+            }
+            if (metrics) {
+                metrics->onSymbolUpdate(symbolId, receiveTimeNs);
+            }
+        }
+
+        QuoteRecord record;
+        record.receiveTimeNs = receiveTimeNs;
+        record.bidPrice = quote.bidPrice;
+        record.askPrice = quote.askPrice;
+        record.bidSize = quote.bidSize;
+        record.askSize = quote.askSize;
+        record.symbolId = symbolId;
+        record.setSymbol(quote.eventSymbol);
+        quoteDispatcher.publish(record);
+    }
+};
+
+#endif // FEEDPROCESSOR_HPP
@@ -0,0 +1,35 @@
+#include "FeedTransport.hpp"
+#include "BeastTransport.hpp"
+#include "WebsocketppTransport.hpp"
+
+std::unique_ptr<FeedTransport> makeFeedTransport(TransportKind kind, SessionTimeline& timeline) {
+    switch (kind) {
+        case TransportKind::Beast: return std::make_unique<BeastTransport>(timeline);
+        case TransportKind::Websocketpp: break;
+    }
+    return std::make_unique<WebsocketppTransport>(timeline);
+}
+
+void FeedTransport::runBusyPoll() {
+    boost::asio::io_context& ioc = ioContext();
+    // poll() stops the context itself once no work is left, the point where run() would return
+    while (!ioc.stopped()) {
+        ioc.poll();
+    }
+}
+
+const char* transportKindName(TransportKind kind) {
+    return kind == TransportKind::Beast ? "beast" : "websocketpp";
+}
+
+bool parseTransportKind(std::string_view name, TransportKind& kind) {
+    if (name == "beast") {
+        kind = TransportKind::Beast;
+        return true;
+    }
+    if (name == "websocketpp") {
+        kind = TransportKind::Websocketpp;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,91 @@
+#ifndef FEEDTRANSPORT_HPP
+#define FEEDTRANSPORT_HPP
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <boost/asio/io_context.hpp>
+#include "SessionTimeline.hpp"
+#include "SocketTuning.hpp"
+
+// Websocket implementations MarketDataWebSocket can run on, chosen at runtime
+enum class TransportKind {
+    Websocketpp,    // websocketpp asio/TLS client (the original transport)
+    Beast           // Boost.Beast websocket::stream over ssl_stream, same stack as the REST side
+};
+
+// How the event-loop thread waits for network events
+struct EventLoopConfig {
+    // Spin on io_context::poll() instead of sleeping in epoll_wait, so a frame is picked up without
+    // a scheduler wake-up. The thread then uses its core fully, idle or not.
+    bool busyPoll = false;
+    int cpu = -1;           // Pin the event-loop thread to this CPU; -1 leaves it to the scheduler
+};
+
+// Callbacks a transport delivers on its event-loop thread
+struct TransportHandlers {
+    std::function<void()> onOpen;
+    // The view is only valid during the call
+    std::function<void(std::string_view payload)> onMessage;
+    // The connection failed to open ("failed") or was lost after opening ("closed")
+    std::function<void(const char* reason)> onClose;
+};
+
+// One dxLink websocket connection at a time over TLS, driven by a single event-loop thread.
+// Implementations record the WsTlsContextInit, WsResolveConnect, WsTlsHandshake and WsUpgrade
+// stages of every connection into the timeline they are given.
+class FeedTransport {
+public:
+    virtual ~FeedTransport() = default;
+
+    virtual const char* name() const = 0;
+
+    // Must be set before open()
+    virtual void setHandlers(TransportHandlers handlers) = 0;
+
+    // Trust a specific CA bundle instead of the default one
+    virtual void setCaFile(const std::string& caFile) = 0;
+
+    // TCP options for the following connections, applied once each is connected
+    virtual void setSocketTuning(const SocketTuning& tuning) = 0;
+
+    // What the kernel granted on the current connection
+    virtual AppliedSocketTuning socketTuning() const = 0;
+
+    // Kernel receive time (monotonicNowNs() scale) of the newest bytes of the message being handed
+    // to onMessage, or 0 if the transport does not read kernel timestamps
+    virtual int64_t kernelReceiveNs() const { return 0; }
+
+    // Starts resolving, connecting, TLS and the upgrade for url on the event loop; onOpen or
+    // onClose follows. An empty authorization sends no Authorization header.
+    virtual void open(const std::string& url, const std::string& authorization) = 0;
+
+    // Sends a text frame on the open connection (event-loop thread only)
+    virtual void send(const std::string& payload) = 0;
+
+    // Aborts the current connection without a close handshake, e.g. after a stall; onClose follows
+    virtual void drop() = 0;
+
+    // Runs the event loop until stop() or until there is no work left
+    virtual void run() = 0;
+
+    // run() without ever blocking: polls the event loop in a loop on the calling thread until
+    // stop() or until there is no work left
+    void runBusyPoll();
+
+    // Makes run() return, from any thread
+    virtual void stop() = 0;
+
+    // The event loop, for timers, signals and posting work onto the transport thread
+    virtual boost::asio::io_context& ioContext() = 0;
+};
+
+std::unique_ptr<FeedTransport> makeFeedTransport(TransportKind kind, SessionTimeline& timeline);
+
+const char* transportKindName(TransportKind kind);
+
+// Accepts "websocketpp" and "beast"; returns false for anything else
+bool parseTransportKind(std::string_view name, TransportKind& kind);
+
+#endif // FEEDTRANSPORT_HPP
@@ -0,0 +1,140 @@
+#include "FrameJournal.hpp"
+#include <fcntl.h>
+#include <iostream>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char kMagic[8] = {'D', 'X', 'F', 'J', 'R', 'N', 'L', '1'};
+constexpr uint32_t kVersion = 1;
+
+static_assert(sizeof(FrameJournalHeader) == 64, "journal header must stay 64 bytes");
+static_assert(sizeof(FrameJournalRecordHeader) == 16, "record header must stay 16 bytes");
+
+} // namespace
+
+FrameJournal::FrameJournal(const std::string& journalPath, size_t capacity, bool prefault) : path(journalPath) {
+    // Owner-only, like the token cache: frames can carry account data. An existing file keeps its
+    // mode through O_CREAT, so tighten it as well.
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to create frame journal: " + path);
+    }
+    if (::fchmod(fd, S_IRUSR | S_IWUSR) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Failed to restrict frame journal permissions: " + path);
+    }
+    mappingSize = sizeof(FrameJournalHeader) + capacity;
+    if (::ftruncate(fd, static_cast<off_t>(mappingSize)) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Failed to size frame journal: " + path);
+    }
+
+    int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+    if (prefault) {
+        flags |= MAP_POPULATE;
+    }
+#else
+    (void)prefault;
+#endif
+    mapping = ::mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, flags, fd, 0);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        ::close(fd);
+        throw std::runtime_error("Failed to map frame journal: " + path);
+    }
+
+    header = static_cast<FrameJournalHeader*>(mapping);
+    std::memcpy(header->magic, kMagic, sizeof(kMagic));
+    header->version = kVersion;
+    header->headerSize = sizeof(FrameJournalHeader);
+    header->capacity = capacity;
+    header->usedBytes = 0;
+    header->records = 0;
+    records = static_cast<char*>(mapping) + sizeof(FrameJournalHeader);
+}
+
+FrameJournal::~FrameJournal() {
+    close();
+}
+
+void FrameJournal::close() {
+    if (!mapping) {
+        return;
+    }
+    uint64_t used = header->usedBytes;
+    ::munmap(mapping, mappingSize);
+    mapping = nullptr;
+    header = nullptr;
+    records = nullptr;
+
+    // Drop the unused tail so the file only holds what was captured
+    if (::ftruncate(fd, static_cast<off_t>(sizeof(FrameJournalHeader) + used)) != 0) {
+        std::cerr << "Failed to trim frame journal: " << path << std::endl;
+    }
+    ::close(fd);
+    fd = -1;
+}
+
+FrameJournalReader::FrameJournalReader(const std::string& path) {
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open frame journal: " + path);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(FrameJournalHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Not a frame journal: " + path);
+    }
+    mappingSize = static_cast<size_t>(info.st_size);
+    mapping = ::mmap(nullptr, mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        ::close(fd);
+        throw std::runtime_error("Failed to map frame journal: " + path);
+    }
+    header = static_cast<const FrameJournalHeader*>(mapping);
+    if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 || header->version != kVersion) {
+        ::munmap(mapping, mappingSize);
+        ::close(fd);
+        throw std::runtime_error("Not a frame journal: " + path);
+    }
+    records = static_cast<const char*>(mapping) + header->headerSize;
+}
+
+FrameJournalReader::~FrameJournalReader() {
+    if (mapping) {
+        ::munmap(mapping, mappingSize);
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+bool FrameJournalReader::next(FrameJournalRecord& record) {
+    uint64_t used = header->usedBytes;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t available = mappingSize - header->headerSize;
+    if (used > available) {
+        used = available;
+    }
+    if (offset + sizeof(FrameJournalRecordHeader) > used) {
+        return false;
+    }
+
+    FrameJournalRecordHeader recordHeader;
+    std::memcpy(&recordHeader, records + offset, sizeof(recordHeader));
+    uint64_t size = FrameJournal::recordSize(recordHeader.length);
+    if (offset + size > used) {
+        return false;
+    }
+    record.timestampNs = recordHeader.timestampNs;
+    record.direction = recordHeader.direction;
+    record.payload = std::string_view(records + offset + sizeof(recordHeader), recordHeader.length);
+    offset += size;
+    return true;
+}
@@ -0,0 +1,119 @@
+#ifndef FRAMEJOURNAL_HPP
+#define FRAMEJOURNAL_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+enum class FrameDirection : uint8_t {
+    Inbound = 0,
+    Outbound = 1
+};
+
+// File layout: a 64-byte header followed by records, each a 16-byte RecordHeader and the payload,
+// padded to a multiple of 8 bytes
+struct FrameJournalHeader {
+    char magic[8];              // "DXFJRNL1"
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t capacity;          // Bytes available for records after the header
+    uint64_t usedBytes;         // Bytes of complete records, updated after every append
+    uint64_t records;
+    uint64_t reserved[3];
+};
+
+struct FrameJournalRecordHeader {
+    int64_t timestampNs;        // monotonicNowNs() at receive / send
+    uint32_t length;            // Payload bytes
+    FrameDirection direction;
+    uint8_t padding[3];
+};
+
+// Append-only websocket frame capture in a memory-mapped file. append() is a bounds check and a
+// memcpy into the mapping: it never allocates, locks or makes a system call, so it can run on the
+// feed I/O thread. When the file is full further frames are dropped and counted. One writer thread.
+class FrameJournal {
+public:
+    static constexpr size_t kDefaultCapacity = size_t(256) << 20;
+
+    // Creates (truncates) path, readable by the owner only. prefault touches every page up front so no
+    // append takes a page fault.
+    explicit FrameJournal(const std::string& path, size_t capacity = kDefaultCapacity, bool prefault = false);
+    ~FrameJournal();
+
+    FrameJournal(const FrameJournal&) = delete;
+    FrameJournal& operator=(const FrameJournal&) = delete;
+
+    bool append(FrameDirection direction, int64_t timestampNs, std::string_view payload) {
+        uint64_t used = header->usedBytes;
+        uint64_t size = recordSize(payload.size());
+        if (size > header->capacity - used) {
+            dropped.store(dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+        char* out = records + used;
+        FrameJournalRecordHeader record{timestampNs, static_cast<uint32_t>(payload.size()), direction, {0, 0, 0}};
+        std::memcpy(out, &record, sizeof(record));
+        std::memcpy(out + sizeof(record), payload.data(), payload.size());
+
+        // Readers of a live file only look as far as usedBytes, so publish it after the data
+        std::atomic_thread_fence(std::memory_order_release);
+        header->usedBytes = used + size;
+        ++header->records;
+        return true;
+    }
+
+    uint64_t recordCount() const { return header->records; }
+    uint64_t usedBytes() const { return header->usedBytes; }
+    uint64_t droppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+    // Unmaps and trims the file to the records written; called by the destructor
+    void close();
+
+    static uint64_t recordSize(size_t payloadLength) {
+        return (sizeof(FrameJournalRecordHeader) + payloadLength + 7) & ~uint64_t(7);
+    }
+
+private:
+    std::string path;
+    int fd = -1;
+    void* mapping = nullptr;
+    size_t mappingSize = 0;
+    FrameJournalHeader* header = nullptr;
+    char* records = nullptr;
+    std::atomic<uint64_t> dropped{0};
+};
+
+struct FrameJournalRecord {
+    int64_t timestampNs;
+    FrameDirection direction;
+    std::string_view payload;   // Points into the mapping, valid while the reader lives
+};
+
+// Sequential reader over a journal file, also usable on one that is still being written
+class FrameJournalReader {
+public:
+    explicit FrameJournalReader(const std::string& path);
+    ~FrameJournalReader();
+
+    FrameJournalReader(const FrameJournalReader&) = delete;
+    FrameJournalReader& operator=(const FrameJournalReader&) = delete;
+
+    // Returns false at the end of the journal
+    bool next(FrameJournalRecord& record);
+
+    void rewind() { offset = 0; }
+    uint64_t recordCount() const { return header->records; }
+
+private:
+    int fd = -1;
+    void* mapping = nullptr;
+    size_t mappingSize = 0;
+    const FrameJournalHeader* header = nullptr;
+    const char* records = nullptr;
+    uint64_t offset = 0;
+};
+
+#endif // FRAMEJOURNAL_HPP
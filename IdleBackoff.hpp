@@ -0,0 +1,54 @@
+#ifndef IDLEBACKOFF_HPP
+#define IDLEBACKOFF_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+// Idle policy of the threads that poll SPSC rings (the QuoteDispatcher consumer, the sharded merger).
+// They spin for a short while so the next quote of a burst is picked up without a scheduler round
+// trip, then yield, then sleep with an interval that doubles up to kMaxSleep. An idle feed costs a
+// few thousand wake-ups a second instead of a whole core; the first quote after a long gap waits at
+// most kMaxSleep (plus timer slack).
+class IdleBackoff {
+public:
+    static constexpr int kSpins = 1000;
+    static constexpr int kYields = 100;
+    static constexpr std::chrono::microseconds kFirstSleep{20};
+    static constexpr std::chrono::microseconds kMaxSleep{500};
+
+    // Call when the poll found work
+    void reset() {
+        idleRounds = 0;
+        sleep = kFirstSleep;
+    }
+
+    // Call when the poll came back empty
+    void idle() {
+        if (idleRounds < kSpins) {
+            ++idleRounds;
+            cpuRelax();
+        } else if (idleRounds < kSpins + kYields) {
+            ++idleRounds;
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(sleep);
+            sleep = std::min(sleep * 2, kMaxSleep);
+        }
+    }
+
+private:
+    int idleRounds = 0;
+    std::chrono::microseconds sleep = kFirstSleep;
+
+    static void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#endif
+    }
+};
+
+#endif // IDLEBACKOFF_HPP
@@ -0,0 +1,68 @@
+#include "LatencyHistogram.hpp"
+#include <cmath>
+#include <sstream>
+
+uint64_t LatencyHistogram::bucketLowerBound(size_t index) {
+    if (index < kSubBucketCount) {
+        return index;
+    }
+    size_t shift = (index - kSubBucketCount) / kSubBucketCount;
+    uint64_t subBucket = (index - kSubBucketCount) % kSubBucketCount;
+    return (kSubBucketCount + subBucket) << shift;
+}
+
+uint64_t LatencyHistogram::bucketWidth(size_t index) {
+    if (index < kSubBucketCount) {
+        return 1;
+    }
+    return uint64_t{1} << ((index - kSubBucketCount) / kSubBucketCount);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        buckets[i] += other.buckets[i];
+    }
+    total += other.total;
+    sum += other.sum;
+    if (other.minValue < minValue) minValue = other.minValue;
+    if (other.maxValue > maxValue) maxValue = other.maxValue;
+}
+
+void LatencyHistogram::reset() {
+    buckets.fill(0);
+    total = 0;
+    sum = 0;
+    minValue = UINT64_MAX;
+    maxValue = 0;
+}
+
+uint64_t LatencyHistogram::percentile(double percent) const {
+    if (total == 0) {
+        return 0;
+    }
+    uint64_t rank = static_cast<uint64_t>(std::ceil(percent / 100.0 * static_cast<double>(total)));
+    if (rank == 0) {
+        rank = 1;
+    }
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            uint64_t value = bucketLowerBound(i) + bucketWidth(i) / 2;
+            if (value < minValue) value = minValue;
+            return value < maxValue ? value : maxValue;
+        }
+    }
+    return maxValue;
+}
+
+std::string LatencyHistogram::summary() const {
+    auto us = [](uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+    std::ostringstream out;
+    out << "count=" << total
+        << " p50=" << us(percentile(50)) << "us"
+        << " p99=" << us(percentile(99)) << "us"
+        << " p99.9=" << us(percentile(99.9)) << "us"
+        << " max=" << us(max()) << "us";
+    return out.str();
+}
@@ -0,0 +1,64 @@
+#ifndef LATENCYHISTOGRAM_HPP
+#define LATENCYHISTOGRAM_HPP
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+// Log-linear latency histogram in the style of HdrHistogram: every power of two is split into
+// 32 linear sub-buckets, so any recorded value is reported within ~3% over the full uint64 range.
+// Fixed size, no allocation on record(), and histograms of the same shape can be merged.
+class LatencyHistogram {
+public:
+    static constexpr int kSubBucketBits = 5;
+    static constexpr uint64_t kSubBucketCount = uint64_t{1} << kSubBucketBits;
+    static constexpr size_t kBucketCount = kSubBucketCount + (64 - kSubBucketBits) * kSubBucketCount;
+
+    void record(uint64_t value) {
+        ++buckets[bucketIndex(value)];
+        ++total;
+        sum += value;
+        if (value < minValue) minValue = value;
+        if (value > maxValue) maxValue = value;
+    }
+
+    // Negative durations (clock skew between stamps) are clamped to zero
+    void recordDuration(int64_t startNs, int64_t endNs) {
+        record(endNs > startNs ? static_cast<uint64_t>(endNs - startNs) : 0);
+    }
+
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+    // Value at the given percentile (0-100), reported as the midpoint of its bucket and clamped to max()
+    uint64_t percentile(double percent) const;
+
+    uint64_t count() const { return total; }
+    uint64_t min() const { return total > 0 ? minValue : 0; }
+    uint64_t max() const { return maxValue; }
+    double mean() const { return total > 0 ? static_cast<double>(sum) / static_cast<double>(total) : 0; }
+
+    // "count=N p50=... p99=... p99.9=... max=..." with values scaled from ns to microseconds
+    std::string summary() const;
+
+    static size_t bucketIndex(uint64_t value) {
+        if (value < kSubBucketCount) {
+            return static_cast<size_t>(value);
+        }
+        int shift = (63 - __builtin_clzll(value)) - kSubBucketBits;
+        uint64_t subBucket = (value >> shift) - kSubBucketCount;
+        return static_cast<size_t>(kSubBucketCount + static_cast<uint64_t>(shift) * kSubBucketCount + subBucket);
+    }
+
+    static uint64_t bucketLowerBound(size_t index);
+    static uint64_t bucketWidth(size_t index);
+
+private:
+    std::array<uint64_t, kBucketCount> buckets{};
+    uint64_t total = 0;
+    uint64_t sum = 0;
+    uint64_t minValue = UINT64_MAX;
+    uint64_t maxValue = 0;
+};
+
+#endif // LATENCYHISTOGRAM_HPP
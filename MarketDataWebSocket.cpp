@@ -1,88 +1,215 @@
 #include "MarketDataWebSocket.hpp"
-#include <iostream>
+#include "AsyncLogger.hpp"
+#include "MonotonicClock.hpp"
+#include "ThreadAffinity.hpp"
+#include <algorithm>
+#include <optional>
+#include <boost/asio/signal_set.hpp>
 #include <boost/json.hpp>
 #include <chrono>
+#include <iostream>
 
-MarketDataWebSocket::MarketDataWebSocket(const std::string& url, const std::string& authToken, int channel)
-    : wsUrl(url), token(authToken), channelNumber(channel) {}
+namespace {
 
-void MarketDataWebSocket::connect() {
-    try {
-        // Initialize the WebSocket client
-        client.init_asio();
+// Takes the field order of each event type from FEED_CONFIG eventFields
+void applyEventFields(FeedLayout& layout, const boost::json::object& eventFields) {
+    layout.reset();
+    for (const auto& entry : eventFields) {
+        if (!entry.value().is_array()) {
+            continue;
+        }
+        std::vector<std::string_view> fields;
+        for (const auto& field : entry.value().as_array()) {
+            if (field.is_string()) {
+                fields.push_back(field.as_string());
+            }
+        }
+        layout.configure(entry.key(), fields);
+    }
+}
 
-        // Set the TLS initialization handler
-        client.set_tls_init_handler([](websocketpp::connection_hdl hdl) {
-            return custom_tls_config::on_tls_init(hdl);
-        });
+// The FEED_SETUP acceptEventFields member for the event types in types, from their schemas
+boost::json::object acceptEventFields(EventTypeSet types) {
+    boost::json::object accepted;
+    forEachEventSchema([&](auto schema) {
+        using Schema = decltype(schema);
+        if ((types & eventTypeBit(Schema::type)) == 0) {
+            return;
+        }
+        boost::json::array fields;
+        for (std::string_view name : eventFieldNames<typename Schema::Event>()) {
+            fields.push_back(boost::json::value(name));
+        }
+        accepted[Schema::name] = std::move(fields);
+    });
+    return accepted;
+}
 
-        // Set up connection handlers
-        client.set_open_handler([this](websocketpp::connection_hdl hdl) {
-            this->onOpen(hdl);
-        });
+} // namespace
 
-        client.set_message_handler([this](websocketpp::connection_hdl hdl, WebSocketClient::message_ptr msg) {
-            this->onMessage(hdl, msg->get_payload());
-        });
+MarketDataWebSocket::MarketDataWebSocket(const std::string& url, const std::string& authToken, int channel,
+                                         TransportKind kind)
+    : wsUrl(url), token(authToken), channelNumber(channel),
+      quoteBook(std::make_unique<QuoteBook>(std::vector<std::string>{})), activeBook(quoteBook.get()),
+      subscriptionManager(*quoteBook, sessionTimeline, channel),
+      feedProcessor(*quoteBook, quoteDispatcher, sessionTimeline),
+      transport(makeFeedTransport(kind, sessionTimeline)),
+      watchdogTimer(transport->ioContext()), reconnectTimer(transport->ioContext()) {
+    // Set up connection handlers
+    TransportHandlers handlers;
+    handlers.onOpen = [this] {
+        this->onOpen();
+    };
+    handlers.onMessage = [this](std::string_view message) {
+        this->onMessage(message);
+    };
+    handlers.onClose = [this](const char* reason) {
+        PX_LOG_WARN("Connection {}.", reason);
+        onDisconnected(reason);
+    };
+    transport->setHandlers(std::move(handlers));
+    feedProcessor.setSubscriptions(&subscriptionManager);
+}
 
-        client.set_fail_handler([this](websocketpp::connection_hdl) {
-            std::cerr << "Connection failed." << std::endl;
-        });
+void MarketDataWebSocket::enableStreaming(const StreamingConfig& config) {
+    streaming = true;
+    streamingConfig = config;
+}
+
+void MarketDataWebSocket::stop() {
+    stopRequested = true;
+    transport->stop();
+}
+
+StreamingStats MarketDataWebSocket::streamingStats() const {
+    return StreamingStats{reconnectCount.load(std::memory_order_relaxed), stallCount.load(std::memory_order_relaxed),
+                          keepalivesSent.load(std::memory_order_relaxed),
+                          keepalivesReceived.load(std::memory_order_relaxed)};
+}
 
-        client.set_close_handler([this](websocketpp::connection_hdl) {
-            std::cerr << "Connection closed." << std::endl;
-        });
+void MarketDataWebSocket::openConnection() {
+    // No Authorization header while the token is still being fetched (overlapped bootstrap)
+    transport->open(wsUrl, token);
+}
 
-        // Create WebSocket connection
-        websocketpp::lib::error_code ec;
-        WebSocketClient::connection_ptr con = client.get_connection(wsUrl, ec);
-        if (ec) {
-            throw std::runtime_error("Connection initialization error: " + ec.message());
+void MarketDataWebSocket::connect() {
+    try {
+        // Ctrl-C ends a streaming session cleanly; the signal_set only lives while run() does
+        boost::asio::signal_set signals(transport->ioContext());
+        if (streaming) {
+            signals.add(SIGINT);
+            signals.add(SIGTERM);
+            signals.async_wait([this](const boost::system::error_code& ec, int) {
+                if (!ec) {
+                    stop();
+                }
+            });
+            scheduleWatchdog();
         }
 
-        // Add the Authorization header for the token
-        con->append_header("Authorization", token);
+        // Pinned only while the loop runs; the caller's thread gets its own mask back afterwards
+        std::optional<ScopedCpuPin> pin;
+        if (eventLoop.cpu >= 0) {
+            pin.emplace(eventLoop.cpu);
+            eventLoopPinned = pin->pinned();
+            if (!eventLoopPinned) {
+                PX_LOG_WARN("Could not pin the feed thread to CPU {}", eventLoop.cpu);
+            }
+        }
 
         // Connect and run the client
-        client.connect(con);
-        client.run();
+        openConnection();
+        if (eventLoop.busyPoll) {
+            transport->runBusyPoll();
+        } else {
+            transport->run();
+        }
     } catch (const std::exception& e) {
-        std::cerr << "WebSocket connection error: " << e.what() << std::endl;
+        PX_LOG_ERROR("WebSocket connection error: {}", e.what());
     }
 }
 
-void MarketDataWebSocket::onOpen(websocketpp::connection_hdl hdl) {
+void MarketDataWebSocket::onOpen() {
     // std::cout << "### Connection opened ###" << std::endl;
+    connectionOpen = true;
+    lastReceiveNs = monotonicNowNs();
 
     // Send SETUP message
     boost::json::object setupMessage{
         {"type", "SETUP"},
         {"channel", 0},
         {"version", "0.1-DXF-JS/0.3.0"},
-        {"keepaliveTimeout", 15},
+        {"keepaliveTimeout", streaming ? std::max(1, streamingConfig.stallTimeoutMs / 1000) : 15},
         {"acceptKeepaliveTimeout", 20}
     };
 
     // std::cout << "Sending SETUP message: " << boost::json::serialize(setupMessage) << std::endl;
-    client.send(hdl, boost::json::serialize(setupMessage), websocketpp::frame::opcode::text);
+    setupSentNs = monotonicNowNs();
+    sendText(boost::json::serialize(setupMessage));
 }
 
-void MarketDataWebSocket::onMessage(websocketpp::connection_hdl hdl, const std::string& message) {
+void MarketDataWebSocket::onMessage(std::string_view message) {
     try {
         auto ws_start_time = std::chrono::high_resolution_clock::now();
-        auto data = boost::json::parse(message).as_object();
-        
+        int64_t receiveTimeNs = monotonicNowNs();
+        lastReceiveNs = receiveTimeNs;
+        // Records are stamped with the kernel receive time when there is one, so a consumer's
+        // now - receiveTimeNs is wire-to-handler and includes the TLS and framing work above us
+        int64_t wireTimeNs = receiveTimeNs;
+        if (int64_t kernelNs = transport->kernelReceiveNs(); kernelNs > 0 && kernelNs <= receiveTimeNs) {
+            wireTimeNs = kernelNs;
+            kernelToHandlerLatency.recordDuration(kernelNs, receiveTimeNs);
+        }
+        if (feedMetrics) {
+            feedMetrics->onFrame(message.size(), wireTimeNs);
+        }
+        if (journal) {
+            journalRecord = journal->append(FrameDirection::Inbound, receiveTimeNs, message)
+                                ? static_cast<int64_t>(journal->recordCount()) - 1 : -1;
+        }
+
+        // Dispatch on "type" once; FEED_DATA is decoded in place without building a DOM
+        DxLinkFrame frame;
+        if (!CompactFeedDecoder::scanFrame(message, frame)) {
+            throw std::runtime_error("Malformed dxLink frame");
+        }
+
+        if (frame.type == DxLinkMessageType::FeedData) {
+            if (frame.channel == channelNumber) {
+                onFeedData(frame.data, wireTimeNs, receiveTimeNs, ws_start_time);
+            }
+            return;
+        }
+
+        if (frame.type == DxLinkMessageType::Keepalive) {
+            keepalivesReceived.fetch_add(1, std::memory_order_relaxed);
+            sendKeepalive();
+            return;
+        }
+
+        // Control messages are rare, the generic parser is fine for them
+        boost::json::value parsed = boost::json::parse(message);
+        const auto& data = parsed.as_object();
+
         // Handle AUTH_STATE
-        if (data["type"].as_string() == "AUTH_STATE") {
-            if (data["state"].as_string() == "UNAUTHORIZED") {
-                boost::json::object authMessage{
-                    {"type", "AUTH"},
-                    {"channel", 0},
-                    {"token", token}
-                };
-                // std::cout << "Sending AUTH message: " << boost::json::serialize(authMessage) << std::endl;
-                client.send(hdl, boost::json::serialize(authMessage), websocketpp::frame::opcode::text);
-            } else if (data["state"].as_string() == "AUTHORIZED") {
+        if (frame.type == DxLinkMessageType::AuthState) {
+            if (setupSentNs != 0) {
+                sessionTimeline.record(SessionStage::SetupToAuthState, setupSentNs, receiveTimeNs);
+                setupSentNs = 0;
+            }
+            if (data.at("state").as_string() == "UNAUTHORIZED" && authSent) {
+                PX_LOG_ERROR("dxLink rejected the websocket token.");
+                authRejected = true;
+                transport->stop();
+            } else if (data.at("state").as_string() == "UNAUTHORIZED") {
+                if (token.empty()) {
+                    // REST login still in flight; provideToken() sends AUTH
+                    authPending = true;
+                    tokenWaitStartNs = receiveTimeNs;
+                } else {
+                    sendAuth();
+                }
+            } else if (data.at("state").as_string() == "AUTHORIZED") {
                 boost::json::object channelRequestMessage{
                     {"type", "CHANNEL_REQUEST"},
                     {"channel", channelNumber},
@@ -90,98 +217,332 @@ void MarketDataWebSocket::onMessage(websocketpp::connection_hdl hdl, const std::
                     {"parameters", boost::json::object{{"contract", "AUTO"}}}
                 };
                 // std::cout << "Sending CHANNEL_REQUEST message: " << boost::json::serialize(channelRequestMessage) << std::endl;
-                client.send(hdl, boost::json::serialize(channelRequestMessage), websocketpp::frame::opcode::text);
+                sendText(boost::json::serialize(channelRequestMessage));
             }
         }
 
         // Handle CHANNEL_OPENED
-        if (data["type"].as_string() == "CHANNEL_OPENED" && data["channel"].as_int64() == channelNumber) {
+        if (frame.type == DxLinkMessageType::ChannelOpened && frame.channel == channelNumber) {
+            if (authSentNs != 0) {
+                sessionTimeline.record(SessionStage::AuthToChannelOpened, authSentNs, receiveTimeNs);
+                authSentNs = 0;
+            }
             boost::json::object feedSetupMessage{
                 {"type", "FEED_SETUP"},
                 {"channel", channelNumber},
-                {"acceptAggregationPeriod", 0.1},
+                {"acceptAggregationPeriod", aggregationPeriodSeconds},
                 {"acceptDataFormat", "COMPACT"},
-                {"acceptEventFields", boost::json::object{
-                    {"Quote", {"eventType", "eventSymbol", "bidPrice", "askPrice", "bidSize", "askSize"}}
-                }}
+                {"acceptEventFields", acceptEventFields(subscriptionManager.eventTypes())}
             };
             // std::cout << "Sending FEED_SETUP message: " << boost::json::serialize(feedSetupMessage) << std::endl;
-            client.send(hdl, boost::json::serialize(feedSetupMessage), websocketpp::frame::opcode::text);
+            feedSetupSentNs = monotonicNowNs();
+            sendText(boost::json::serialize(feedSetupMessage));
         }
 
         // Handle FEED_CONFIG
-        if (data["type"].as_string() == "FEED_CONFIG" && data["channel"].as_int64() == channelNumber) {
-            boost::json::array symbolsArray;
-            for (const auto& symbol : symbolsToTrack) {
-                symbolsArray.push_back(boost::json::object{{"type", "Quote"}, {"symbol", symbol}});
+        if (frame.type == DxLinkMessageType::FeedConfig && frame.channel == channelNumber) {
+            if (feedSetupSentNs != 0) {
+                sessionTimeline.record(SessionStage::FeedSetupToFeedConfig, feedSetupSentNs, receiveTimeNs);
+                feedSetupSentNs = 0;
+            }
+            if (const auto* period = data.if_contains("aggregationPeriod"); period && period->is_number()) {
+                grantedAggregationSeconds = period->to_number<double>();
+            }
+            // The fields as the server will send them, which need not be the order we asked for
+            if (const auto* eventFields = data.if_contains("eventFields"); eventFields && eventFields->is_object()) {
+                applyEventFields(feedProcessor.layout(), eventFields->as_object());
             }
+            // reset + the whole list, split into bounded frames and reused across reconnects
+            channelConfigured = true;
+            int64_t subscriptionSentNs = monotonicNowNs();
+            feedProcessor.setSubscriptionSentNs(subscriptionSentNs);
+            for (const auto& subscriptionFrame : subscriptionManager.resubscribeAll(subscriptionSentNs)) {
+                sendText(subscriptionFrame);
+            }
+        }
+    } catch (const std::exception& e) {
+        if (feedMetrics) {
+            feedMetrics->onParseError();
+        }
+        // Printed directly: a log record would cut the raw message short. Flushing first keeps it in
+        // order with what the feed thread logged before.
+        AsyncLogger::instance().flush();
+        std::cerr << "Failed to parse message: " << e.what() << "\nRaw Message: " << message << std::endl;
+        if (journalRecord >= 0) {
+            std::cerr << "Captured as journal record " << journalRecord << std::endl;
+        }
+    }
+}
 
-            boost::json::object subscriptionMessage{
-                {"type", "FEED_SUBSCRIPTION"},
-                {"channel", channelNumber},
-                {"reset", true},
-                {"add", symbolsArray}
-            };
+void MarketDataWebSocket::sendAuth() {
+    boost::json::object authMessage{
+        {"type", "AUTH"},
+        {"channel", 0},
+        {"token", token}
+    };
+    // std::cout << "Sending AUTH message: " << boost::json::serialize(authMessage) << std::endl;
+    authSentNs = monotonicNowNs();
+    authSent = true;
+    // The journal is a plain file; keep the live credential out of it
+    std::string journaled;
+    if (journal) {
+        authMessage["token"] = "<redacted>";
+        journaled = boost::json::serialize(authMessage);
+        authMessage["token"] = token;
+    }
+    sendText(boost::json::serialize(authMessage), journaled);
+}
 
-            // std::cout << "Sending FEED_SUBSCRIPTION message: "
-                    //   << boost::json::serialize(subscriptionMessage) << std::endl;
+void MarketDataWebSocket::sendKeepalive() {
+    keepalivesSent.fetch_add(1, std::memory_order_relaxed);
+    sendText(R"({"type":"KEEPALIVE","channel":0})");
+}
 
-            client.send(hdl, boost::json::serialize(subscriptionMessage), websocketpp::frame::opcode::text);
+void MarketDataWebSocket::sendText(const std::string& payload) {
+    sendText(payload, payload);
+}
+
+void MarketDataWebSocket::sendText(const std::string& payload, std::string_view journaledPayload) {
+    lastSendNs = monotonicNowNs();
+    if (journal) {
+        journal->append(FrameDirection::Outbound, lastSendNs, journaledPayload);
+    }
+    transport->send(payload);
+}
+
+void MarketDataWebSocket::provideToken(const std::string& authToken) {
+    // All connection state belongs to the io_context thread, so hand the token over through it
+    boost::asio::post(transport->ioContext(), [this, authToken] {
+        token = authToken;
+        if (authPending) {
+            authPending = false;
+            sessionTimeline.record(SessionStage::TokenWait, tokenWaitStartNs, monotonicNowNs());
+            try {
+                sendAuth();
+            } catch (const std::exception& e) {
+                PX_LOG_ERROR("Failed to send AUTH: {}", e.what());
+            }
         }
+    });
+}
 
-        // Handle FEED_DATA
-        if (data["type"].as_string() == "FEED_DATA" && data["channel"].as_int64() == channelNumber) {
-            // std::cout << "FEED_DATA message received. Processing market data." << std::endl;
+void MarketDataWebSocket::onFeedData(std::string_view feedData, int64_t wireTimeNs, int64_t receiveTimeNs,
+                                     std::chrono::high_resolution_clock::time_point ws_start_time) {
+    // std::cout << "FEED_DATA message received. Processing market data." << std::endl;
 
-            auto feedData = data["data"].as_array();
-            std::string feedType = std::string(feedData[0].as_string().c_str()); // Fix conversion here
-            auto marketData = feedData[1].as_array();
+    long decoded = feedProcessor.onFeedData(feedData, wireTimeNs);
+    if (decoded < 0) {
+        throw std::runtime_error("Malformed FEED_DATA payload");
+    }
+    feedDataLatency.recordDuration(receiveTimeNs, monotonicNowNs());
+    ++feedDataFrames;
 
-            for (size_t i = 0; i < marketData.size(); i += 6) {
-                std::string eventType = std::string(marketData[i + 0].as_string().c_str());
-                std::string eventSymbol = std::string(marketData[i + 1].as_string().c_str());
-                double bidPrice = marketData[i + 2].as_double();
-                double askPrice = marketData[i + 3].as_double();
-                double midPrice = (bidPrice + askPrice) / 2;
-                double bidSize = marketData[i + 4].as_double();
-                double askSize = marketData[i + 5].as_double();
+    // First data on a new connection closes the reconnect gap
+    if (disconnectedNs != 0 && decoded > 0) {
+        sessionTimeline.record(SessionStage::ReconnectGap, disconnectedNs, receiveTimeNs);
+        disconnectedNs = 0;
+        reconnectAttempt = 0;
+    }
 
-                std::cout << "Symbol: " << eventSymbol
-                          << " | Bid: " << bidPrice
-                          << " | Ask: " << askPrice
-                          << " | Mid: " << midPrice
-                          << " | bidSize: " << bidSize
-                          << " | askSize: " << askSize << std::endl;
+    // Check if all symbols have received data
+    if (!streaming && subscriptionManager.fullyLive()) {
+        auto ws_end_time = std::chrono::high_resolution_clock::now();
+        auto ws_duration = std::chrono::duration_cast<std::chrono::microseconds>(ws_end_time - ws_start_time).count();
+        PX_LOG_INFO("WebSocket routine return time: {} mus", ws_duration);
+        PX_LOG_INFO("All symbols have received data. Closing WebSocket connection.");
+        transport->stop();
+    }
+}
 
-                if (symbolsStatus.find(eventSymbol) != symbolsStatus.end()) {
-                    symbolsStatus[eventSymbol] = true;
-                }
-            }
+void MarketDataWebSocket::onDisconnected(const char* reason) {
+    connectionOpen = false;
+    channelConfigured = false;
+    if (!streaming || stopRequested || authRejected) {
+        return;
+    }
+    if (disconnectedNs == 0) {
+        disconnectedNs = monotonicNowNs();
+    }
+    PX_LOG_WARN("Connection {}, reconnecting.", reason);
+    scheduleReconnect();
+}
 
-            // Check if all symbols have received data
-            if (std::all_of(symbolsStatus.begin(), symbolsStatus.end(),
-                            [](const auto& entry) { return entry.second; })) {
-                auto ws_end_time = std::chrono::high_resolution_clock::now();
-                auto ws_duration = std::chrono::duration_cast<std::chrono::microseconds>(ws_end_time - ws_start_time).count();
-                std::cout << "WebSocket routine return time: " << ws_duration << " mus" << std::endl;                                
-                std::cout << "All symbols have received data. Closing WebSocket connection." << std::endl;
-                client.stop();
-            }
-        }
-    } catch (const std::exception& e) {
-        std::cerr << "Failed to parse message: " << e.what() << "\nRaw Message: " << message << std::endl;
+void MarketDataWebSocket::scheduleReconnect() {
+    if (reconnectScheduled) {
+        return;
     }
+    reconnectScheduled = true;
+
+    long delayMs = std::min<long>(streamingConfig.reconnectMaxMs,
+                                  static_cast<long>(streamingConfig.reconnectInitialMs) << std::min(reconnectAttempt, 20));
+    ++reconnectAttempt;
+    reconnectTimer.expires_after(std::chrono::milliseconds(delayMs));
+    reconnectTimer.async_wait([this](const boost::system::error_code& ec) {
+        reconnectScheduled = false;
+        if (ec || stopRequested) {
+            return;
+        }
+        reconnectCount.fetch_add(1, std::memory_order_relaxed);
+
+        // Fresh handshake state; CHANNEL_REQUEST, FEED_SETUP and FEED_SUBSCRIPTION follow from it
+        authSent = false;
+        authPending = false;
+        setupSentNs = 0;
+        authSentNs = 0;
+        feedSetupSentNs = 0;
+        try {
+            openConnection();
+        } catch (const std::exception& e) {
+            PX_LOG_ERROR("Reconnect failed: {}", e.what());
+            scheduleReconnect();
+        }
+    });
+}
+
+void MarketDataWebSocket::scheduleWatchdog() {
+    long tickMs = std::max(10, std::min(streamingConfig.keepaliveIntervalMs, streamingConfig.stallTimeoutMs) / 4);
+    watchdogTimer.expires_after(std::chrono::milliseconds(tickMs));
+    watchdogTimer.async_wait([this](const boost::system::error_code& ec) {
+        if (!ec && !stopRequested) {
+            onWatchdog();
+            scheduleWatchdog();
+        }
+    });
 }
 
+void MarketDataWebSocket::onWatchdog() {
+    if (!connectionOpen) {
+        return;
+    }
+    int64_t now = monotonicNowNs();
+    if (now - lastReceiveNs > static_cast<int64_t>(streamingConfig.stallTimeoutMs) * 1000000) {
+        // A stalled peer will not answer a close handshake either, so drop the socket; the
+        // close handler then schedules the reconnect
+        PX_LOG_WARN("No data for {} ms, dropping connection.", streamingConfig.stallTimeoutMs);
+        stallCount.fetch_add(1, std::memory_order_relaxed);
+        disconnectedNs = lastReceiveNs;
+        connectionOpen = false;
+        transport->drop();
+        return;
+    }
+    if (now - lastSendNs > static_cast<int64_t>(streamingConfig.keepaliveIntervalMs) * 1000000) {
+        try {
+            sendKeepalive();
+        } catch (const std::exception& e) {
+            PX_LOG_ERROR("Failed to send KEEPALIVE: {}", e.what());
+        }
+    }
+}
 
-void MarketDataWebSocket::setSymbolsToTrack(const std::vector<std::string>& symbols) {
-    symbolsToTrack = symbols;
+void MarketDataWebSocket::setSymbolsToTrack(const std::vector<std::string>& symbols, size_t capacity) {
+    if (!sharedBook) {
+        quoteBook = std::make_unique<QuoteBook>(symbols, capacity);
+        activeBook = quoteBook.get();
+        feedProcessor.setBook(*activeBook);
+        if (feedMetrics) {
+            enableMetrics(feedMetrics->staleAfter());
+        }
+    }
+    subscriptionManager.setBook(*activeBook);
     for (const auto& symbol : symbols) {
-        symbolsStatus[symbol] = false; // Initialize symbol statuses to false
+        int32_t id = activeBook->find(symbol);
+        if (id == QuoteBook::kNotFound) {
+            PX_LOG_WARN("Not tracking {}: not in the shared quote book", symbol);
+            continue;
+        }
+        subscriptionManager.add(id);
     }
+    // Printed directly, like the parse errors: a log record would cut a long list short
+    AsyncLogger::instance().flush();
     std::cout << "Symbols to track set: ";
-    for (const auto& symbol : symbols) {
-        std::cout << symbol << " ";
+    if (symbols.size() > 10) {
+        std::cout << symbols.size() << " symbols";
+    } else {
+        for (const auto& symbol : symbols) {
+            std::cout << symbol << " ";
+        }
     }
     std::cout << std::endl;
 }
+
+void MarketDataWebSocket::useSharedBook(QuoteBook& book) {
+    sharedBook = true;
+    quoteBook.reset();
+    activeBook = &book;
+    feedProcessor.setBook(book);
+    subscriptionManager.setBook(book);
+    if (feedMetrics) {
+        enableMetrics(feedMetrics->staleAfter());
+    }
+}
+
+void MarketDataWebSocket::enableMetrics(int64_t staleAfterNs) {
+    feedMetrics = std::make_unique<FeedMetrics>(activeBook->capacity());
+    feedMetrics->setStaleAfter(staleAfterNs);
+    feedProcessor.setMetrics(feedMetrics.get());
+}
+
+void MarketDataWebSocket::renderMetrics(std::ostream& out) {
+    if (!feedMetrics) {
+        return;
+    }
+    feedMetrics->render(out, *activeBook, monotonicNowNs());
+    QuoteDispatcher::Stats stats = quoteDispatcher.stats();
+    FeedMetrics::writeMetric(out, "dxfeed_quotes_published_total", "counter", "Quotes handed to the dispatcher",
+                             static_cast<double>(stats.published));
+    FeedMetrics::writeMetric(out, "dxfeed_quotes_dropped_total", "counter", "Quotes lost to a full dispatcher ring",
+                             static_cast<double>(stats.dropped));
+    FeedMetrics::writeMetric(out, "dxfeed_quotes_merged_total", "counter",
+                             "Quote updates conflated into a newer one before the consumer saw them",
+                             static_cast<double>(stats.merged));
+    FeedMetrics::writeMetric(out, "dxfeed_quote_backlog", "gauge", "Quotes waiting for the consumer",
+                             static_cast<double>(quoteDispatcher.backlog()));
+    StreamingStats streamStats = streamingStats();
+    FeedMetrics::writeMetric(out, "dxfeed_reconnects_total", "counter", "Reconnects after a lost connection",
+                             static_cast<double>(streamStats.reconnects));
+    FeedMetrics::writeMetric(out, "dxfeed_stalls_total", "counter", "Connections dropped for silence",
+                             static_cast<double>(streamStats.stalls));
+}
+
+void MarketDataWebSocket::addSymbols(const std::vector<std::string>& symbols) {
+    // The book index and the subscription state belong to the event-loop thread
+    boost::asio::post(transport->ioContext(), [this, symbols] {
+        for (const auto& symbol : symbols) {
+            // A shared book is interned up front by its owner; a private one grows into its spare capacity
+            int32_t id = sharedBook ? activeBook->find(symbol) : activeBook->intern(symbol);
+            if (id == QuoteBook::kNotFound) {
+                PX_LOG_WARN("Not tracking {}: {}", symbol,
+                            sharedBook ? "not in the shared quote book" : "quote book is full");
+                continue;
+            }
+            subscriptionManager.add(id);
+        }
+        flushSubscriptions();
+    });
+}
+
+void MarketDataWebSocket::removeSymbols(const std::vector<std::string>& symbols) {
+    boost::asio::post(transport->ioContext(), [this, symbols] {
+        for (const auto& symbol : symbols) {
+            int32_t id = activeBook->find(symbol);
+            if (id != QuoteBook::kNotFound) {
+                subscriptionManager.remove(id);
+            }
+        }
+        flushSubscriptions();
+    });
+}
+
+void MarketDataWebSocket::flushSubscriptions() {
+    // Before FEED_CONFIG the changes ride along with the initial subscription
+    if (!channelConfigured || !subscriptionManager.hasPending()) {
+        return;
+    }
+    try {
+        for (const auto& subscriptionFrame : subscriptionManager.takePending(monotonicNowNs())) {
+            sendText(subscriptionFrame);
+        }
+    } catch (const std::exception& e) {
+        PX_LOG_ERROR("Failed to send FEED_SUBSCRIPTION: {}", e.what());
+    }
+}
@@ -1,106 +1,266 @@
 #ifndef MARKETDATAWEBSOCKET_HPP
 #define MARKETDATAWEBSOCKET_HPP
 
-#include <websocketpp/config/core_client.hpp>
-#include <websocketpp/transport/asio/endpoint.hpp>
-#include <websocketpp/transport/asio/security/tls.hpp>
-#include <websocketpp/client.hpp>
-#include <boost/asio/ssl.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
-#include <map> // For symbol tracking
-#include <iostream> // For debug output
-#include <fstream> // For file existence check
-#include <openssl/ssl.h> // For OpenSSL configuration
-
-// Custom TLS configuration for WebSocket++ client
-struct custom_tls_config : public websocketpp::config::core_client {
-    typedef custom_tls_config type;
-    typedef core_client base;
-
-    typedef base::concurrency_type concurrency_type;
-    typedef base::request_type request_type;
-    typedef base::response_type response_type;
-    typedef base::message_type message_type;
-    typedef base::con_msg_manager_type con_msg_manager_type;
-    typedef base::endpoint_msg_manager_type endpoint_msg_manager_type;
-    typedef base::alog_type alog_type;
-    typedef base::elog_type elog_type;
-    typedef base::rng_type rng_type;
-
-    struct transport_config : public base::transport_config {
-        typedef type::concurrency_type concurrency_type;
-        typedef type::alog_type alog_type;
-        typedef type::elog_type elog_type;
-        typedef type::request_type request_type;
-        typedef type::response_type response_type;
-        typedef websocketpp::transport::asio::tls_socket::endpoint socket_type;
-    };
-
-    typedef websocketpp::transport::asio::endpoint<transport_config> transport_type;
-
-    // TLS context initialization
-    static std::shared_ptr<boost::asio::ssl::context> on_tls_init(websocketpp::connection_hdl) {
-        const char* cert_file = "/etc/ssl/certs/ca-bundle.crt";
-
-        // Debug: Check if the CA file exists
-        std::ifstream file(cert_file);
-        if (file) {
-            std::cout << "[DEBUG] CA file found: " << cert_file << std::endl;
-        } else {
-            std::cerr << "[ERROR] CA file not found: " << cert_file << std::endl;
-        }
-
-        // Create and configure the SSL context
-        auto ctx = std::make_shared<boost::asio::ssl::context>(boost::asio::ssl::context::tlsv12);
-        try {
-            ctx->set_verify_mode(boost::asio::ssl::verify_peer); // Verify peers
-
-            // Directly set the CA file path for OpenSSL
-            if (SSL_CTX_load_verify_locations(ctx->native_handle(), cert_file, nullptr) != 1) {
-                std::cerr << "[ERROR] Failed to load CA file: " << cert_file << std::endl;
-                throw std::runtime_error("Failed to load CA file");
-            }
-
-            std::cout << "[DEBUG] Successfully loaded CA file: " << cert_file << std::endl;
-        } catch (const std::exception& e) {
-            std::cerr << "[ERROR] SSL context configuration failed: " << e.what() << std::endl;
-            throw;
-        }
-
-        return ctx;
-    }
+#include "CompactFeedDecoder.hpp"
+#include "EventSchema.hpp"
+#include "FeedMetrics.hpp"
+#include "FeedProcessor.hpp"
+#include "FeedTransport.hpp"
+#include "FrameJournal.hpp"
+#include "LatencyHistogram.hpp"
+#include "QuoteBook.hpp"
+#include "QuoteDispatcher.hpp"
+#include "SessionTimeline.hpp"
+#include "SubscriptionManager.hpp"
+
+// Continuous mode settings (MarketDataWebSocket::enableStreaming)
+struct StreamingConfig {
+    int keepaliveIntervalMs = 5000;   // KEEPALIVE is sent when nothing else went out for this long
+    int stallTimeoutMs = 15000;       // Silence for this long drops the connection; sent as keepaliveTimeout in SETUP
+    int reconnectInitialMs = 100;     // First reconnect delay, doubled after every failed attempt
+    int reconnectMaxMs = 5000;        // Upper bound of the reconnect delay
 };
 
-// WebSocket client typedef
-typedef websocketpp::client<custom_tls_config> WebSocketClient;
+struct StreamingStats {
+    uint64_t reconnects;
+    uint64_t stalls;
+    uint64_t keepalivesSent;
+    uint64_t keepalivesReceived;
+};
 
 class MarketDataWebSocket {
 private:
     std::string wsUrl;
     std::string token;
     int channelNumber;
-    std::vector<std::string> symbolsToTrack;
 
-    // Add a map to track symbol statuses
-    std::map<std::string, bool> symbolsStatus;
+    // Live top-of-book for the tracked symbols, built by setSymbolsToTrack unless useSharedBook()
+    // points activeBook at a book owned elsewhere
+    std::unique_ptr<QuoteBook> quoteBook;
+    QuoteBook* activeBook;
+    bool sharedBook = false;
+
+    // Decoded quotes are handed off here; printing and other consumers run on their own thread
+    QuoteDispatcher quoteDispatcher;
+
+    // Stage latencies of this connection and the monotonic stamps they are measured from. The
+    // transport records the connect, TLS and upgrade stages itself.
+    SessionTimeline sessionTimeline;
+    int64_t setupSentNs = 0;
+    int64_t authSentNs = 0;
+    int64_t tokenWaitStartNs = 0;
+    int64_t feedSetupSentNs = 0;
+
+    // Optional capture of every inbound and outbound payload
+    FrameJournal* journal = nullptr;
+    int64_t journalRecord = -1;     // Index of the last inbound record, -1 if it was not captured
+
+    // Receive -> published time of every FEED_DATA frame (decode, book update, hand-off)
+    LatencyHistogram feedDataLatency;
+    uint64_t feedDataFrames = 0;
+
+    // Kernel receive -> onMessage of every frame (socket queue, TLS decrypt, websocket framing),
+    // when the transport reads kernel timestamps
+    LatencyHistogram kernelToHandlerLatency;
+
+    // Health counters for scraping (enableMetrics); null when off
+    std::unique_ptr<FeedMetrics> feedMetrics;
+
+    // How connect() runs the transport's event loop, and whether the pin took
+    EventLoopConfig eventLoop;
+    bool eventLoopPinned = false;
+
+    // Set once AUTH went out, so a later UNAUTHORIZED means the token was rejected
+    bool authSent = false;
+    bool authRejected = false;
+
+    // Overlapped bootstrap: the server asked for AUTH before provideToken() was called
+    bool authPending = false;
+
+    // Streaming mode; all of this except the counters and stopRequested lives on the io_context thread
+    bool streaming = false;
+    StreamingConfig streamingConfig;
+    std::atomic<bool> stopRequested{false};
+    bool connectionOpen = false;
+    bool reconnectScheduled = false;
+    int reconnectAttempt = 0;
+    int64_t lastReceiveNs = 0;
+    int64_t lastSendNs = 0;
+    int64_t disconnectedNs = 0;
+    std::atomic<uint64_t> reconnectCount{0};
+    std::atomic<uint64_t> stallCount{0};
+    std::atomic<uint64_t> keepalivesSent{0};
+    std::atomic<uint64_t> keepalivesReceived{0};
+
+    // What this channel is subscribed to, as pre-serialized FEED_SUBSCRIPTION diffs; the initial
+    // list goes out on FEED_CONFIG, later changes as soon as the channel is configured
+    SubscriptionManager subscriptionManager;
+    bool channelConfigured = false;
 
-    WebSocketClient client;
+    // Server-side conflation window asked for in FEED_SETUP, and the one FEED_CONFIG granted (-1: none yet)
+    double aggregationPeriodSeconds = 0.1;
+    double grantedAggregationSeconds = -1;
+
+    // Decode -> book -> dispatcher hot path
+    FeedProcessor feedProcessor;
+
+    // The websocket itself; declared after everything its handlers touch, and the timers run on its
+    // io_context so they are declared after it
+    std::unique_ptr<FeedTransport> transport;
+    boost::asio::steady_timer watchdogTimer;
+    boost::asio::steady_timer reconnectTimer;
+
+    // Starts connecting to wsUrl on the transport's event loop
+    void openConnection();
+
+    void sendText(const std::string& payload);
+    // Sends payload but journals journaledPayload in its place (a copy with secrets taken out)
+    void sendText(const std::string& payload, std::string_view journaledPayload);
+    void sendAuth();
+    void sendKeepalive();
+
+    // Sends the subscription changes queued by addSymbols()/removeSymbols()
+    void flushSubscriptions();
+
+    // Streaming: fail/close handler, reconnect with exponential backoff, keepalive and stall timer
+    void onDisconnected(const char* reason);
+    void scheduleReconnect();
+    void scheduleWatchdog();
+    void onWatchdog();
+
+    // Runs a FEED_DATA payload through the FeedProcessor and stops once every subscribed symbol has a quote
+    // wireTimeNs stamps the decoded records; receiveTimeNs starts the frame latency
+    void onFeedData(std::string_view feedData, int64_t wireTimeNs, int64_t receiveTimeNs,
+                    std::chrono::high_resolution_clock::time_point ws_start_time);
 
 public:
-    // Constructor
-    MarketDataWebSocket(const std::string& url, const std::string& authToken, int channel);
+    // Constructor. authToken may be empty if it is passed later with provideToken().
+    MarketDataWebSocket(const std::string& url, const std::string& authToken, int channel,
+                        TransportKind kind = TransportKind::Websocketpp);
 
-    // Connect to the WebSocket server
+    // Connect to the WebSocket server; runs the event loop until the snapshot is complete
     void connect();
 
+    // Hands over the token from another thread while connect() is already running, so DNS, TCP,
+    // TLS, the upgrade and SETUP overlap with the REST login. AUTH goes out as soon as both the
+    // token and the server's UNAUTHORIZED are in.
+    void provideToken(const std::string& authToken);
+
+    // Stays connected after the snapshot: answers and sends keepalives, drops silent connections and
+    // reconnects with bounded backoff, restoring the channel and the subscription. connect() then
+    // returns on stop(), SIGINT/SIGTERM, or when the token is rejected.
+    void enableStreaming(const StreamingConfig& config = StreamingConfig{});
+
+    // Makes connect() return, from any thread; a streaming session does not reconnect afterwards
+    void stop();
+
+    StreamingStats streamingStats() const;
+
+    // Appends every received and sent payload to journal (nullptr turns capture off). The token in
+    // the outbound AUTH frame is replaced by "<redacted>". The journal must outlive the connection;
+    // tools/JournalReplay.cpp plays it back.
+    void setJournal(FrameJournal* frameJournal) { journal = frameJournal; }
+
+    // Trust a specific CA bundle for the websocket host (e.g. a local stand-in server)
+    void setCaFile(const std::string& path) { transport->setCaFile(path); }
+
+    // TCP_NODELAY, SO_RCVBUF and kernel receive timestamps for the feed socket; call before connect()
+    void setSocketTuning(const SocketTuning& tuning) { transport->setSocketTuning(tuning); }
+
+    // What the kernel granted on the last connection
+    AppliedSocketTuning socketTuning() const { return transport->socketTuning(); }
+
+    // Blocking or busy-poll event loop, optionally pinned; call before connect(). connect() pins the
+    // thread it runs on while the loop runs and restores the thread's affinity when it returns.
+    void setEventLoop(const EventLoopConfig& config) { eventLoop = config; }
+    const EventLoopConfig& eventLoopConfig() const { return eventLoop; }
+
+    // True if connect() pinned its thread to eventLoopConfig().cpu
+    bool eventLoopIsPinned() const { return eventLoopPinned; }
+
+    // "websocketpp" or "beast"
+    const char* transportName() const { return transport->name(); }
+
     // Handlers
-    void onOpen(websocketpp::connection_hdl hdl);
-    void onMessage(websocketpp::connection_hdl hdl, const std::string& message);
+    void onOpen();
+    void onMessage(std::string_view message);
+
+    // Set symbols to track. capacity reserves quote book slots for symbols added later with
+    // addSymbols() (0: room for this list only).
+    void setSymbolsToTrack(const std::vector<std::string>& symbols, size_t capacity = 0);
+
+    // Subscribe or unsubscribe symbols while connect() runs, from any thread. The changes go out as
+    // FEED_SUBSCRIPTION add/remove diffs on the next pass of the event loop (or with the initial
+    // subscription if the channel is not configured yet); removed symbols keep their book slot.
+    void addSymbols(const std::vector<std::string>& symbols);
+    void removeSymbols(const std::vector<std::string>& symbols);
+
+    // Upper bound of one FEED_SUBSCRIPTION frame; longer lists are split. Call before connect().
+    void setMaxSubscriptionFrameBytes(size_t bytes) { subscriptionManager.setMaxFrameBytes(bytes); }
+
+    // Event types requested for every symbol on the channel (Quote always included; the book and
+    // the snapshot are built from quotes). Their fields come from EventSchema. Call before connect().
+    void setEventTypes(EventTypeSet types) { subscriptionManager.setEventTypes(types); }
+
+    // acceptAggregationPeriod of FEED_SETUP: how long dxLink may merge updates of a symbol before
+    // sending them (0 asks for every update). Call before connect().
+    void setAggregationPeriod(double seconds) { aggregationPeriodSeconds = seconds; }
+
+    // aggregationPeriod from the server's FEED_CONFIG, -1 if none arrived; read once connect() has returned
+    double grantedAggregationPeriod() const { return grantedAggregationSeconds; }
+
+    // Callbacks for Trade, Summary, Greeks and TimeAndSale records, run on the feed thread. Call before connect().
+    void setEventHandlers(MarketEventHandlers handlers) { feedProcessor.setEventHandlers(std::move(handlers)); }
+
+    // Records of one event type decoded so far; read once connect() has returned
+    uint64_t eventCount(EventType type) const { return feedProcessor.eventCount(type); }
+
+    // Subscribed vs confirmed-live symbol counts, readable from any thread
+    SubscriptionCoverage subscriptionCoverage() const { return subscriptionManager.coverage(); }
+
+    // Quote hand-off to consumers (pull with poll()/drain() or start() a callback thread)
+    QuoteDispatcher& quotes() { return quoteDispatcher; }
+
+    // Latest quote per tracked symbol, readable from any thread while the feed runs
+    const QuoteBook& book() const { return *activeBook; }
+
+    // Decodes into a book shared with other connections instead of a private one. Every tracked
+    // symbol must already be interned in it, and no other connection may track the same symbols.
+    void useSharedBook(QuoteBook& book);
+
+    // Counts frames, bytes, parse errors and per-symbol updates for scraping, and flags symbols
+    // quiet for longer than staleAfterNs (0: never). Sized to the current book, so call after
+    // setSymbolsToTrack() or useSharedBook() (calling either later starts the counters afresh).
+    void enableMetrics(int64_t staleAfterNs);
+
+    // nullptr unless enableMetrics() was called
+    const FeedMetrics* metrics() const { return feedMetrics.get(); }
+
+    // Prometheus text snapshot of the metrics plus the dispatcher and reconnect counters. Safe from
+    // any thread while connect() runs (e.g. a MetricsServer's); writes nothing unless enabled.
+    void renderMetrics(std::ostream& out);
+
+    // Per-frame processing latency and frame count; read once connect() has returned
+    const LatencyHistogram& frameLatency() const { return feedDataLatency; }
+
+    // Kernel receive -> onMessage per frame; empty when the transport has no kernel timestamps
+    const LatencyHistogram& kernelLatency() const { return kernelToHandlerLatency; }
+    uint64_t frameCount() const { return feedDataFrames; }
+
+    // True if the server answered our AUTH with UNAUTHORIZED (expired or revoked token)
+    bool authWasRejected() const { return authRejected; }
 
-    // Set symbols to track
-    void setSymbolsToTrack(const std::vector<std::string>& symbols);
+    // Per-stage handshake latencies; read once connect() has returned
+    const SessionTimeline& timeline() const { return sessionTimeline; }
 };
 
 #endif // MARKETDATAWEBSOCKET_HPP
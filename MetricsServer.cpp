@@ -0,0 +1,132 @@
+#include "MetricsServer.hpp"
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <boost/beast/core/flat_buffer.hpp>
+#include <boost/beast/http.hpp>
+
+namespace http = boost::beast::http;
+using boost::asio::ip::tcp;
+using boost::asio::local::stream_protocol;
+
+namespace {
+
+// A scrape is a one-line GET; anything bigger is not a Prometheus client
+constexpr size_t kMaxRequestBytes = 8192;
+
+template <typename Socket>
+struct Exchange {
+    explicit Exchange(Socket&& connected) : socket(std::move(connected)) {}
+
+    Socket socket;
+    boost::beast::flat_buffer buffer{kMaxRequestBytes};
+    http::request<http::string_body> request;
+    http::response<http::string_body> response;
+};
+
+} // namespace
+
+MetricsServer::MetricsServer(const std::string& endpoint, Render renderMetrics) : render(std::move(renderMetrics)) {
+    bool isUnix = endpoint.rfind("unix:", 0) == 0;
+    long port = 0;
+    if (isUnix) {
+        unixPath = endpoint.substr(5);
+        if (unixPath.empty()) {
+            throw std::runtime_error("Empty metrics socket path");
+        }
+    } else {
+        char* end = nullptr;
+        port = std::strtol(endpoint.c_str(), &end, 10);
+        if (endpoint.empty() || *end != '\0' || port < 0 || port > 65535) {
+            throw std::runtime_error("Invalid metrics endpoint (PORT or unix:PATH): " + endpoint);
+        }
+    }
+
+    try {
+        if (isUnix) {
+            // Left behind by a previous run that did not exit cleanly; anything else at PATH is kept
+            struct stat existing;
+            if (::lstat(unixPath.c_str(), &existing) == 0 && S_ISSOCK(existing.st_mode)) {
+                ::unlink(unixPath.c_str());
+            }
+            unixAcceptor = std::make_unique<stream_protocol::acceptor>(ioc, stream_protocol::endpoint(unixPath));
+            acceptUnix();
+        } else {
+            tcpAcceptor = std::make_unique<tcp::acceptor>(
+                ioc, tcp::endpoint(boost::asio::ip::address_v4::loopback(), static_cast<unsigned short>(port)));
+            acceptTcp();
+        }
+    } catch (const boost::system::system_error& e) {
+        throw std::runtime_error("Cannot listen for metrics on " + endpoint + ": " + e.code().message());
+    }
+    thread = std::thread([this] { ioc.run(); });
+}
+
+MetricsServer::~MetricsServer() {
+    ioc.stop();
+    thread.join();
+    if (!unixPath.empty()) {
+        ::unlink(unixPath.c_str());
+    }
+}
+
+std::string MetricsServer::endpoint() const {
+    if (tcpAcceptor) {
+        return "127.0.0.1:" + std::to_string(tcpAcceptor->local_endpoint().port());
+    }
+    return "unix:" + unixPath;
+}
+
+void MetricsServer::acceptTcp() {
+    tcpAcceptor->async_accept([this](const boost::system::error_code& ec, tcp::socket socket) {
+        if (!ec) {
+            serve(std::make_shared<Exchange<tcp::socket>>(std::move(socket)));
+        }
+        if (ec != boost::asio::error::operation_aborted) {
+            acceptTcp();
+        }
+    });
+}
+
+void MetricsServer::acceptUnix() {
+    unixAcceptor->async_accept([this](const boost::system::error_code& ec, stream_protocol::socket socket) {
+        if (!ec) {
+            serve(std::make_shared<Exchange<stream_protocol::socket>>(std::move(socket)));
+        }
+        if (ec != boost::asio::error::operation_aborted) {
+            acceptUnix();
+        }
+    });
+}
+
+template <typename Connection>
+void MetricsServer::serve(std::shared_ptr<Connection> exchange) {
+    http::async_read(exchange->socket, exchange->buffer, exchange->request,
+                     [this, exchange](const boost::system::error_code& ec, size_t) {
+        if (ec) {
+            return;
+        }
+        const auto& request = exchange->request;
+        auto& response = exchange->response;
+        response.version(request.version());
+        response.keep_alive(false);
+        if (request.method() == http::verb::get && (request.target() == "/metrics" || request.target() == "/")) {
+            std::ostringstream body;
+            render(body);
+            response.result(http::status::ok);
+            response.set(http::field::content_type, "text/plain; version=0.0.4");
+            response.body() = body.str();
+        } else {
+            response.result(http::status::not_found);
+            response.set(http::field::content_type, "text/plain");
+            response.body() = "Not found; metrics are at /metrics\n";
+        }
+        response.prepare_payload();
+        http::async_write(exchange->socket, response, [exchange](const boost::system::error_code&, size_t) {
+            boost::system::error_code ignored;
+            exchange->socket.shutdown(boost::asio::socket_base::shutdown_both, ignored);
+        });
+    });
+}
@@ -0,0 +1,46 @@
+#ifndef METRICSSERVER_HPP
+#define METRICSSERVER_HPP
+
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+
+// Serves a Prometheus text snapshot over plain HTTP/1.1 on its own thread, so scraping never runs
+// on the feed thread. Listens either on a loopback TCP port or on a Unix socket
+// (curl --unix-socket PATH http://localhost/metrics). Every request for /metrics calls render;
+// anything else gets a 404. One response per connection.
+class MetricsServer {
+public:
+    using Render = std::function<void(std::ostream&)>;
+
+    // endpoint: a TCP port on 127.0.0.1 ("9464"; "0" picks a free one) or "unix:PATH". A socket
+    // left at PATH by an earlier run is replaced. Throws std::runtime_error if it cannot listen.
+    MetricsServer(const std::string& endpoint, Render render);
+    ~MetricsServer();
+
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    // Where it listens: "127.0.0.1:PORT" or "unix:PATH"
+    std::string endpoint() const;
+
+private:
+    boost::asio::io_context ioc;
+    std::unique_ptr<boost::asio::ip::tcp::acceptor> tcpAcceptor;
+    std::unique_ptr<boost::asio::local::stream_protocol::acceptor> unixAcceptor;
+    std::string unixPath;
+    Render render;
+    std::thread thread;
+
+    void acceptTcp();
+    void acceptUnix();
+    template <typename Connection>
+    void serve(std::shared_ptr<Connection> connection);
+};
+
+#endif // METRICSSERVER_HPP
@@ -0,0 +1,13 @@
+#ifndef MONOTONICCLOCK_HPP
+#define MONOTONICCLOCK_HPP
+
+#include <chrono>
+#include <cstdint>
+
+// Monotonic nanosecond timestamps used for receive stamps and latency measurements
+inline int64_t monotonicNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#endif // MONOTONICCLOCK_HPP
@@ -0,0 +1,74 @@
+#include "QuoteBook.hpp"
+#include <stdexcept>
+
+QuoteBook::QuoteBook(size_t capacity)
+    : slotCapacity(capacity),
+      slots(new Slot[capacity]),
+      names(new std::string[capacity]) {
+    if (capacity == 0 || capacity > static_cast<size_t>(INT32_MAX)) {
+        throw std::invalid_argument("QuoteBook capacity out of range");
+    }
+
+    // Keep the index at most half full so probe sequences stay short
+    size_t bucketCount = 2;
+    while (bucketCount < capacity * 2) {
+        bucketCount <<= 1;
+    }
+    bucketMask = bucketCount - 1;
+    buckets.reset(new std::atomic<int32_t>[bucketCount]);
+    for (size_t i = 0; i < bucketCount; ++i) {
+        buckets[i].store(kNotFound, std::memory_order_relaxed);
+    }
+}
+
+QuoteBook::QuoteBook(const std::vector<std::string>& symbols, size_t capacity)
+    : QuoteBook(capacity > symbols.size() ? capacity : (symbols.empty() ? 1 : symbols.size())) {
+    for (const auto& symbol : symbols) {
+        intern(symbol);
+    }
+}
+
+uint64_t QuoteBook::hashSymbol(std::string_view symbol) {
+    // FNV-1a
+    uint64_t hash = 1469598103934665603ull;
+    for (char c : symbol) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+int32_t QuoteBook::find(std::string_view symbol) const {
+    for (size_t bucket = hashSymbol(symbol) & bucketMask;; bucket = (bucket + 1) & bucketMask) {
+        int32_t id = buckets[bucket].load(std::memory_order_acquire);
+        if (id == kNotFound) {
+            return kNotFound;
+        }
+        if (names[static_cast<size_t>(id)] == symbol) {
+            return id;
+        }
+    }
+}
+
+int32_t QuoteBook::intern(std::string_view symbol) {
+    size_t bucket = hashSymbol(symbol) & bucketMask;
+    for (;; bucket = (bucket + 1) & bucketMask) {
+        int32_t id = buckets[bucket].load(std::memory_order_relaxed);
+        if (id == kNotFound) {
+            break;
+        }
+        if (names[static_cast<size_t>(id)] == symbol) {
+            return id;
+        }
+    }
+
+    size_t next = count.load(std::memory_order_relaxed);
+    if (next == slotCapacity) {
+        return kNotFound;
+    }
+    int32_t id = static_cast<int32_t>(next);
+    names[next] = std::string(symbol);
+    buckets[bucket].store(id, std::memory_order_release);
+    count.store(next + 1, std::memory_order_release);
+    return id;
+}
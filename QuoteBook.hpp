@@ -0,0 +1,126 @@
+#ifndef QUOTEBOOK_HPP
+#define QUOTEBOOK_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Consistent copy of one top-of-book slot
+struct QuoteSnapshot {
+    double bidPrice;
+    double askPrice;
+    double bidSize;
+    double askSize;
+    double midPrice;
+    int64_t receiveTimeNs;
+    uint64_t updateCount;
+};
+
+// Flat top-of-book table indexed by interned symbol id. Each symbol owns one cache-line slot
+// guarded by a seqlock: the feed thread writes without locking and readers on any thread copy a
+// consistent snapshot, retrying only if they raced with a write to that same slot.
+//
+// Interning (intern/setSymbols) must happen on a single thread; find() and read() are safe from
+// any thread at any time. A slot must only ever be updated by one thread.
+class QuoteBook {
+public:
+    static constexpr int32_t kNotFound = -1;
+
+    explicit QuoteBook(size_t capacity);
+    QuoteBook(const std::vector<std::string>& symbols, size_t capacity = 0);
+
+    QuoteBook(const QuoteBook&) = delete;
+    QuoteBook& operator=(const QuoteBook&) = delete;
+
+    // Returns the id of symbol, adding it if needed; kNotFound if the book is full
+    int32_t intern(std::string_view symbol);
+
+    int32_t find(std::string_view symbol) const;
+
+    // Returns true for the first update of the slot
+    bool update(int32_t id, double bidPrice, double askPrice, double bidSize, double askSize,
+                int64_t receiveTimeNs) {
+        Slot& slot = slots[static_cast<size_t>(id)];
+        uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.bidPrice.store(bidPrice, std::memory_order_relaxed);
+        slot.askPrice.store(askPrice, std::memory_order_relaxed);
+        slot.bidSize.store(bidSize, std::memory_order_relaxed);
+        slot.askSize.store(askSize, std::memory_order_relaxed);
+        slot.midPrice.store((bidPrice + askPrice) / 2, std::memory_order_relaxed);
+        slot.receiveTimeNs.store(receiveTimeNs, std::memory_order_relaxed);
+
+        slot.sequence.store(sequence + 2, std::memory_order_release);
+        if (sequence == 0) {
+            seen.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    // Returns false if the symbol has not been quoted yet
+    bool read(int32_t id, QuoteSnapshot& snapshot) const {
+        const Slot& slot = slots[static_cast<size_t>(id)];
+        uint64_t before;
+        uint64_t after;
+        do {
+            before = slot.sequence.load(std::memory_order_acquire);
+            snapshot.bidPrice = slot.bidPrice.load(std::memory_order_relaxed);
+            snapshot.askPrice = slot.askPrice.load(std::memory_order_relaxed);
+            snapshot.bidSize = slot.bidSize.load(std::memory_order_relaxed);
+            snapshot.askSize = slot.askSize.load(std::memory_order_relaxed);
+            snapshot.midPrice = slot.midPrice.load(std::memory_order_relaxed);
+            snapshot.receiveTimeNs = slot.receiveTimeNs.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = slot.sequence.load(std::memory_order_relaxed);
+        } while ((before & 1) != 0 || before != after);
+        snapshot.updateCount = before / 2;
+        return before != 0;
+    }
+
+    bool read(std::string_view symbol, QuoteSnapshot& snapshot) const {
+        int32_t id = find(symbol);
+        return id != kNotFound && read(id, snapshot);
+    }
+
+    const std::string& symbol(int32_t id) const { return names[static_cast<size_t>(id)]; }
+
+    size_t size() const { return count.load(std::memory_order_acquire); }
+    size_t capacity() const { return slotCapacity; }
+
+    // Number of symbols that have received at least one quote
+    size_t seenCount() const { return seen.load(std::memory_order_relaxed); }
+    bool allSeen() const { return seenCount() == size(); }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> sequence{0}; // Odd while a write is in progress; updates = sequence / 2
+        std::atomic<double> bidPrice{0};
+        std::atomic<double> askPrice{0};
+        std::atomic<double> bidSize{0};
+        std::atomic<double> askSize{0};
+        std::atomic<double> midPrice{0};
+        std::atomic<int64_t> receiveTimeNs{0};
+    };
+    static_assert(sizeof(Slot) == 64, "QuoteBook slots should be exactly one cache line");
+
+    const size_t slotCapacity;
+    std::unique_ptr<Slot[]> slots;
+    std::unique_ptr<std::string[]> names;
+
+    // Open-addressing symbol index; buckets hold slot ids and are published with release stores
+    size_t bucketMask;
+    std::unique_ptr<std::atomic<int32_t>[]> buckets;
+
+    std::atomic<size_t> count{0};
+    std::atomic<size_t> seen{0};
+
+    static uint64_t hashSymbol(std::string_view symbol);
+};
+
+#endif // QUOTEBOOK_HPP
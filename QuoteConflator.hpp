@@ -0,0 +1,110 @@
+#ifndef QUOTECONFLATOR_HPP
+#define QUOTECONFLATOR_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include "QuoteRecord.hpp"
+#include "SpscRing.hpp"
+
+// Latest-value-per-symbol hand-off for consumers that may fall behind. The producer overwrites the
+// symbol's slot instead of queueing every update, and each symbol id sits in the ready queue at
+// most once, so a burst costs one slot per symbol however long the consumer stalls. take() returns
+// the newest quote of the next ready symbol and how many updates it stands for (1 when nothing was
+// merged); updates are never lost, only folded into the newest one.
+//
+// One producer thread (offer) and one consumer thread (take).
+class QuoteConflator {
+public:
+    explicit QuoteConflator(size_t symbolCapacity)
+        : symbols(symbolCapacity), slots(new Slot[symbolCapacity]), delivered(new uint64_t[symbolCapacity]()),
+          ready(symbolCapacity) {}
+
+    QuoteConflator(const QuoteConflator&) = delete;
+    QuoteConflator& operator=(const QuoteConflator&) = delete;
+
+    // Producer side. Returns false for ids outside the capacity (including QuoteBook::kNotFound).
+    bool offer(const QuoteRecord& quote) {
+        if (quote.symbolId < 0 || static_cast<size_t>(quote.symbolId) >= symbols) {
+            return false;
+        }
+        Slot& slot = slots[static_cast<size_t>(quote.symbolId)];
+        uint64_t version = slot.version.load(std::memory_order_relaxed);
+        slot.version.store(version + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(static_cast<void*>(&slot.record), &quote, sizeof(QuoteRecord));
+        slot.offered = ++slot.producerOffered;
+        slot.version.store(version + 2, std::memory_order_release);
+
+        // Queue the symbol unless it is already waiting; the consumer clears the flag with an RMW
+        // on the same atomic, so either it sees this update or this call queues the symbol again
+        if (!slot.queued.exchange(true, std::memory_order_acq_rel)) {
+            ready.tryPush(quote.symbolId); // Holds every id at once, so it cannot be full
+        }
+        offeredCount.store(offeredCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Consumer side. Copies the newest quote of the next ready symbol; false if none is ready.
+    bool take(QuoteRecord& quote, uint32_t& updates) {
+        int32_t id;
+        while (ready.tryPop(id)) {
+            Slot& slot = slots[static_cast<size_t>(id)];
+            slot.queued.exchange(false, std::memory_order_acq_rel);
+            uint64_t offered = read(slot, quote);
+            uint64_t merged = offered - delivered[static_cast<size_t>(id)];
+            if (merged == 0) {
+                continue; // Already delivered with the previous take of this symbol
+            }
+            delivered[static_cast<size_t>(id)] = offered;
+            updates = merged > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(merged);
+            mergedCount.store(mergedCount.load(std::memory_order_relaxed) + (merged - 1), std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    size_t symbolCapacity() const { return symbols; }
+
+    // Updates offered so far, and how many of them take() folded into a newer quote
+    uint64_t offeredUpdates() const { return offeredCount.load(std::memory_order_relaxed); }
+    uint64_t mergedUpdates() const { return mergedCount.load(std::memory_order_relaxed); }
+
+    // Symbols waiting for the consumer (approximate while the producer runs)
+    size_t backlog() const { return ready.size(); }
+
+private:
+    struct alignas(kCacheLineSize) Slot {
+        std::atomic<uint64_t> version{0};   // Odd while the producer writes the slot
+        uint64_t offered = 0;               // Updates of this symbol so far, as of record
+        uint64_t producerOffered = 0;       // Producer's own running count
+        std::atomic<bool> queued{false};
+        QuoteRecord record;
+    };
+
+    const size_t symbols;
+    const std::unique_ptr<Slot[]> slots;
+    const std::unique_ptr<uint64_t[]> delivered;   // Consumer-owned: offered count at the last take
+    SpscRing<int32_t> ready;
+
+    alignas(kCacheLineSize) std::atomic<uint64_t> offeredCount{0};
+    alignas(kCacheLineSize) std::atomic<uint64_t> mergedCount{0};
+
+    // Seqlock read of a slot; returns its offered count
+    static uint64_t read(const Slot& slot, QuoteRecord& quote) {
+        for (;;) {
+            uint64_t before = slot.version.load(std::memory_order_acquire);
+            if ((before & 1) == 0) {
+                uint64_t offered = slot.offered;
+                std::memcpy(static_cast<void*>(&quote), &slot.record, sizeof(QuoteRecord));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.version.load(std::memory_order_relaxed) == before) {
+                    return offered;
+                }
+            }
+        }
+    }
+};
+
+#endif // QUOTECONFLATOR_HPP
@@ -0,0 +1,61 @@
+#include "QuoteDispatcher.hpp"
+#include <stdexcept>
+#include "IdleBackoff.hpp"
+
+QuoteDispatcher::QuoteDispatcher(size_t capacity) : ring(capacity) {}
+
+QuoteDispatcher::~QuoteDispatcher() {
+    stop();
+}
+
+void QuoteDispatcher::enableConflation(size_t symbolCapacity) {
+    if (running.load() || published.load(std::memory_order_relaxed) > 0) {
+        throw std::runtime_error("QuoteDispatcher conflation must be enabled before quotes flow");
+    }
+    conflator = std::make_unique<QuoteConflator>(symbolCapacity);
+}
+
+void QuoteDispatcher::start(Callback callback) {
+    start(CountedCallback([callback = std::move(callback)](const QuoteRecord& quote, uint32_t) { callback(quote); }));
+}
+
+void QuoteDispatcher::start(CountedCallback callback) {
+    if (running.exchange(true)) {
+        throw std::runtime_error("QuoteDispatcher consumer already running");
+    }
+    consumerThread = std::thread(&QuoteDispatcher::consumeLoop, this, std::move(callback));
+}
+
+void QuoteDispatcher::stop() {
+    if (!running.exchange(false)) {
+        return;
+    }
+    if (consumerThread.joinable()) {
+        consumerThread.join();
+    }
+}
+
+void QuoteDispatcher::consumeLoop(CountedCallback callback) {
+    IdleBackoff backoff;
+    while (running.load(std::memory_order_acquire)) {
+        if (drain(callback) > 0) {
+            backoff.reset();
+        } else {
+            backoff.idle();
+        }
+    }
+
+    // Deliver whatever was published before stop()
+    while (drain(callback) > 0) {
+    }
+}
+
+QuoteDispatcher::Stats QuoteDispatcher::stats() const {
+    return Stats{
+        published.load(std::memory_order_relaxed),
+        consumed.load(std::memory_order_relaxed),
+        dropped.load(std::memory_order_relaxed),
+        overflows.load(std::memory_order_relaxed),
+        conflator ? conflator->mergedUpdates() : 0
+    };
+}
@@ -0,0 +1,139 @@
+#ifndef QUOTEDISPATCHER_HPP
+#define QUOTEDISPATCHER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include "QuoteConflator.hpp"
+#include "QuoteRecord.hpp"
+#include "SpscRing.hpp"
+
+// Hands decoded quotes from the feed I/O thread to a single consumer thread.
+// The I/O thread only calls publish(), which never blocks: when the ring is full the quote is
+// dropped and counted. Consumers either pull with poll()/drain() from a thread they own, or
+// register a callback with start() and let the dispatcher run its own consumer thread.
+//
+// With enableConflation() a consumer that falls behind gets the newest quote per symbol instead of
+// every update: quotes of tracked symbols go through a QuoteConflator and never drop, the backlog is
+// at most one quote per symbol, and each delivered quote carries how many updates it merged.
+// Untracked symbols still go through the ring. Order is kept per symbol, not across symbols.
+class QuoteDispatcher {
+public:
+    using Callback = std::function<void(const QuoteRecord&)>;
+    // Also gets the number of updates the quote stands for (1 unless conflation merged some)
+    using CountedCallback = std::function<void(const QuoteRecord&, uint32_t updates)>;
+
+    struct Stats {
+        uint64_t published;  // Quotes accepted into the ring
+        uint64_t consumed;   // Quotes handed to the consumer
+        uint64_t dropped;    // Quotes lost because the ring was full
+        uint64_t overflows;  // Number of times the ring went from accepting to full
+        uint64_t merged;     // Updates folded into a newer quote of the same symbol (conflation only)
+    };
+
+    explicit QuoteDispatcher(size_t capacity = 65536);
+    ~QuoteDispatcher();
+
+    QuoteDispatcher(const QuoteDispatcher&) = delete;
+    QuoteDispatcher& operator=(const QuoteDispatcher&) = delete;
+
+    // Conflate symbol ids below symbolCapacity (QuoteBook ids). Call before anything is published.
+    void enableConflation(size_t symbolCapacity);
+    bool conflating() const { return conflator != nullptr; }
+
+    // Producer side (feed I/O thread only). Returns false if the quote was dropped.
+    bool publish(const QuoteRecord& quote) {
+        if (conflator && conflator->offer(quote)) {
+            published.store(published.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return true;
+        }
+        if (ring.tryPush(quote)) {
+            published.store(published.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            overflowing = false;
+            return true;
+        }
+        dropped.store(dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (!overflowing) {
+            overflowing = true;
+            overflows.store(overflows.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+        return false;
+    }
+
+    // Pull API (single consumer thread, not to be mixed with start())
+    bool poll(QuoteRecord& quote, uint32_t* updates = nullptr) {
+        uint32_t merged = 1;
+        if (!ring.tryPop(quote) && !(conflator && conflator->take(quote, merged))) {
+            return false;
+        }
+        if (updates) {
+            *updates = merged;
+        }
+        consumed.store(consumed.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // fn takes (const QuoteRecord&) or (const QuoteRecord&, uint32_t updates)
+    template <typename Fn>
+    size_t drain(Fn&& fn, size_t maxRecords = 1024) {
+        constexpr bool counted = std::is_invocable_v<Fn&, const QuoteRecord&, uint32_t>;
+        size_t count = ring.popBatch([&fn](const QuoteRecord& quote) {
+            if constexpr (counted) {
+                fn(quote, 1u);
+            } else {
+                fn(quote);
+            }
+        }, maxRecords);
+        if (conflator) {
+            QuoteRecord quote;
+            uint32_t updates;
+            while (count < maxRecords && conflator->take(quote, updates)) {
+                if constexpr (counted) {
+                    fn(static_cast<const QuoteRecord&>(quote), updates);
+                } else {
+                    fn(static_cast<const QuoteRecord&>(quote));
+                }
+                ++count;
+            }
+        }
+        consumed.store(consumed.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+        return count;
+    }
+
+    // Callback API: runs callback for every quote on a dedicated consumer thread. The thread
+    // backs off to short sleeps while nothing arrives (see IdleBackoff) rather than holding a core.
+    void start(Callback callback);
+    void start(CountedCallback callback);
+
+    // Stops the consumer thread after handing it everything published so far
+    void stop();
+
+    Stats stats() const;
+
+    size_t capacity() const { return ring.capacity(); }
+
+    // Quotes waiting for the consumer (approximate while both sides run)
+    size_t backlog() const { return ring.size() + (conflator ? conflator->backlog() : 0); }
+
+private:
+    SpscRing<QuoteRecord> ring;
+    std::unique_ptr<QuoteConflator> conflator;
+
+    // Producer-owned counters, written with plain relaxed stores and read by stats()
+    alignas(kCacheLineSize) std::atomic<uint64_t> published{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> overflows{0};
+    bool overflowing = false;
+
+    // Consumer-owned
+    alignas(kCacheLineSize) std::atomic<uint64_t> consumed{0};
+    std::atomic<bool> running{false};
+    std::thread consumerThread;
+
+    void consumeLoop(CountedCallback callback);
+};
+
+#endif // QUOTEDISPATCHER_HPP
@@ -0,0 +1,98 @@
+#include "QuoteHistory.hpp"
+#include <stdexcept>
+
+template <typename T>
+QuoteHistory::Column<T> QuoteHistory::allocateColumn(size_t count) {
+    T* data = static_cast<T*>(::operator new[](count * sizeof(T), std::align_val_t(kColumnAlignment)));
+    // Touch every page now so appends never fault
+    for (size_t i = 0; i < count; ++i) {
+        data[i] = T{};
+    }
+    return Column<T>(data);
+}
+
+QuoteHistory::QuoteHistory(size_t symbolCapacity, size_t depth) : symbols(symbolCapacity) {
+    if (symbolCapacity == 0 || depth == 0 || depth > (size_t{1} << 40)) {
+        throw std::invalid_argument("QuoteHistory capacity out of range");
+    }
+    ringDepth = 1;
+    while (ringDepth < depth) {
+        ringDepth <<= 1;
+    }
+    ringMask = ringDepth - 1;
+
+    size_t slots = symbols * ringDepth;
+    times = allocateColumn<int64_t>(slots);
+    bids = allocateColumn<double>(slots);
+    asks = allocateColumn<double>(slots);
+    bidSizes = allocateColumn<double>(slots);
+    askSizes = allocateColumn<double>(slots);
+    written.reset(new uint64_t[symbols]());
+}
+
+uint64_t QuoteHistory::appendedCount(int32_t symbolId) const {
+    if (symbolId < 0 || static_cast<size_t>(symbolId) >= symbols) {
+        return 0;
+    }
+    return written[static_cast<size_t>(symbolId)];
+}
+
+size_t QuoteHistory::size(int32_t symbolId) const {
+    uint64_t count = appendedCount(symbolId);
+    return count < ringDepth ? static_cast<size_t>(count) : ringDepth;
+}
+
+QuoteWindow QuoteHistory::latest(int32_t symbolId, size_t count) const {
+    QuoteWindow window;
+    size_t held = size(symbolId);
+    if (count > held) {
+        count = held;
+    }
+    if (count == 0) {
+        return window;
+    }
+
+    uint64_t first = written[static_cast<size_t>(symbolId)] - count;
+    size_t base = static_cast<size_t>(symbolId) * ringDepth;
+    size_t start = static_cast<size_t>(first) & ringMask;
+    size_t firstRun = count < ringDepth - start ? count : ringDepth - start;
+
+    auto segment = [this, base](size_t offset, size_t length) {
+        QuoteColumns columns;
+        columns.receiveTimeNs = times.get() + base + offset;
+        columns.bidPrice = bids.get() + base + offset;
+        columns.askPrice = asks.get() + base + offset;
+        columns.bidSize = bidSizes.get() + base + offset;
+        columns.askSize = askSizes.get() + base + offset;
+        columns.size = length;
+        return columns;
+    };
+    window.segments[0] = segment(start, firstRun);
+    window.segmentCount = 1;
+    if (firstRun < count) {
+        window.segments[1] = segment(0, count - firstRun);
+        window.segmentCount = 2;
+    }
+    return window;
+}
+
+QuoteWindow QuoteHistory::since(int32_t symbolId, int64_t fromNs) const {
+    size_t held = size(symbolId);
+    if (held == 0) {
+        return QuoteWindow{};
+    }
+    uint64_t first = written[static_cast<size_t>(symbolId)] - held;
+
+    // First held quote with receiveTimeNs >= fromNs
+    size_t low = 0;
+    size_t high = held;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (timeAt(symbolId, first, middle) < fromNs) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return latest(symbolId, held - low);
+}
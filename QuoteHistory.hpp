@@ -0,0 +1,118 @@
+#ifndef QUOTEHISTORY_HPP
+#define QUOTEHISTORY_HPP
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include "QuoteRecord.hpp"
+
+// One contiguous run of a symbol's history, oldest first. The pointers go straight into the
+// history's columns.
+struct QuoteColumns {
+    const int64_t* receiveTimeNs = nullptr;
+    const double* bidPrice = nullptr;
+    const double* askPrice = nullptr;
+    const double* bidSize = nullptr;
+    const double* askSize = nullptr;
+    size_t size = 0;
+};
+
+// A range of one symbol's quotes: at most two runs because the ring may wrap, oldest first
+struct QuoteWindow {
+    std::array<QuoteColumns, 2> segments;
+    size_t segmentCount = 0;
+
+    size_t size() const {
+        size_t total = 0;
+        for (size_t i = 0; i < segmentCount; ++i) {
+            total += segments[i].size;
+        }
+        return total;
+    }
+    bool empty() const { return size() == 0; }
+};
+
+// Recent quotes per symbol in fixed, preallocated structure-of-arrays columns: every column holds
+// depth slots per QuoteBook symbol id, used as a ring, so appending never allocates and each
+// field of a symbol's history is a contiguous array for the QuoteKernels (64-byte aligned for
+// depths of 8 or more).
+//
+// Single writer. Windows point into the rings, so read them on the appending thread (e.g. inside
+// the QuoteDispatcher callback) or while appends are paused; a window stays valid until depth
+// more quotes of that symbol have been appended.
+class QuoteHistory {
+public:
+    // depth is rounded up to a power of two
+    QuoteHistory(size_t symbolCapacity, size_t depth);
+
+    QuoteHistory(const QuoteHistory&) = delete;
+    QuoteHistory& operator=(const QuoteHistory&) = delete;
+
+    // Returns false for ids outside the capacity (including QuoteBook::kNotFound)
+    bool append(int32_t symbolId, int64_t receiveTimeNs, double bidPrice, double askPrice, double bidSize,
+                double askSize) {
+        if (symbolId < 0 || static_cast<size_t>(symbolId) >= symbols) {
+            return false;
+        }
+        uint64_t& count = written[static_cast<size_t>(symbolId)];
+        size_t slot = static_cast<size_t>(symbolId) * ringDepth + (static_cast<size_t>(count) & ringMask);
+        times[slot] = receiveTimeNs;
+        bids[slot] = bidPrice;
+        asks[slot] = askPrice;
+        bidSizes[slot] = bidSize;
+        askSizes[slot] = askSize;
+        ++count;
+        return true;
+    }
+
+    bool append(const QuoteRecord& quote) {
+        return append(quote.symbolId, quote.receiveTimeNs, quote.bidPrice, quote.askPrice, quote.bidSize,
+                      quote.askSize);
+    }
+
+    size_t depth() const { return ringDepth; }
+    size_t symbolCapacity() const { return symbols; }
+
+    // Quotes appended for the symbol so far, and how many of them are still held
+    uint64_t appendedCount(int32_t symbolId) const;
+    size_t size(int32_t symbolId) const;
+
+    // The newest count quotes (fewer if fewer are held)
+    QuoteWindow latest(int32_t symbolId, size_t count) const;
+
+    // Quotes received at or after fromNs, found by binary search (receive times only move forward)
+    QuoteWindow since(int32_t symbolId, int64_t fromNs) const;
+
+    QuoteWindow all(int32_t symbolId) const { return latest(symbolId, ringDepth); }
+
+private:
+    static constexpr size_t kColumnAlignment = 64;
+
+    template <typename T>
+    struct AlignedDelete {
+        void operator()(T* p) const { ::operator delete[](p, std::align_val_t(kColumnAlignment)); }
+    };
+    template <typename T>
+    using Column = std::unique_ptr<T[], AlignedDelete<T>>;
+
+    size_t symbols;
+    size_t ringDepth;
+    size_t ringMask;
+    Column<int64_t> times;
+    Column<double> bids;
+    Column<double> asks;
+    Column<double> bidSizes;
+    Column<double> askSizes;
+    std::unique_ptr<uint64_t[]> written;
+
+    template <typename T>
+    static Column<T> allocateColumn(size_t count);
+
+    // Time of the index-th held quote of the symbol, oldest first
+    int64_t timeAt(int32_t symbolId, uint64_t first, size_t index) const {
+        return times[static_cast<size_t>(symbolId) * ringDepth + (static_cast<size_t>(first + index) & ringMask)];
+    }
+};
+
+#endif // QUOTEHISTORY_HPP
@@ -0,0 +1,294 @@
+#include "QuoteKernels.hpp"
+#include <cmath>
+#include <limits>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Series loaders: at(i) is one value for the scalar loops, at4(i) four values for AVX2
+struct ColumnLoad {
+    const double* values;
+    double at(size_t i) const { return values[i]; }
+#if defined(__AVX2__)
+    __m256d at4(size_t i) const { return _mm256_loadu_pd(values + i); }
+#endif
+};
+
+struct MidLoad {
+    const double* bid;
+    const double* ask;
+    double at(size_t i) const { return (bid[i] + ask[i]) * 0.5; }
+#if defined(__AVX2__)
+    __m256d at4(size_t i) const {
+        return _mm256_mul_pd(_mm256_add_pd(_mm256_loadu_pd(bid + i), _mm256_loadu_pd(ask + i)), _mm256_set1_pd(0.5));
+    }
+#endif
+};
+
+struct SpreadLoad {
+    const double* bid;
+    const double* ask;
+    double at(size_t i) const { return ask[i] - bid[i]; }
+#if defined(__AVX2__)
+    __m256d at4(size_t i) const { return _mm256_sub_pd(_mm256_loadu_pd(ask + i), _mm256_loadu_pd(bid + i)); }
+#endif
+};
+
+struct WeightedMidLoad {
+    const double* bid;
+    const double* ask;
+    const double* bidSize;
+    const double* askSize;
+    double at(size_t i) const { return (bid[i] * askSize[i] + ask[i] * bidSize[i]) / (bidSize[i] + askSize[i]); }
+#if defined(__AVX2__)
+    __m256d at4(size_t i) const {
+        __m256d bids = _mm256_loadu_pd(bid + i);
+        __m256d asks = _mm256_loadu_pd(ask + i);
+        __m256d bidSizes = _mm256_loadu_pd(bidSize + i);
+        __m256d askSizes = _mm256_loadu_pd(askSize + i);
+        __m256d numerator = _mm256_add_pd(_mm256_mul_pd(bids, askSizes), _mm256_mul_pd(asks, bidSizes));
+        return _mm256_div_pd(numerator, _mm256_add_pd(bidSizes, askSizes));
+    }
+#endif
+};
+
+template <typename Fn>
+void withSeries(const QuoteColumns& columns, QuoteSeries series, Fn&& fn) {
+    switch (series) {
+        case QuoteSeries::Bid: fn(ColumnLoad{columns.bidPrice}); break;
+        case QuoteSeries::Ask: fn(ColumnLoad{columns.askPrice}); break;
+        case QuoteSeries::BidSize: fn(ColumnLoad{columns.bidSize}); break;
+        case QuoteSeries::AskSize: fn(ColumnLoad{columns.askSize}); break;
+        case QuoteSeries::Mid: fn(MidLoad{columns.bidPrice, columns.askPrice}); break;
+        case QuoteSeries::Spread: fn(SpreadLoad{columns.bidPrice, columns.askPrice}); break;
+        case QuoteSeries::WeightedMid:
+            fn(WeightedMidLoad{columns.bidPrice, columns.askPrice, columns.bidSize, columns.askSize});
+            break;
+    }
+}
+
+// First-pass totals; min/max start at +/-inf and only move for non-NaN values
+struct Partial {
+    size_t count = 0;
+    double sum = 0;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+};
+
+struct ScalarPasses {
+    template <typename Load>
+    static void fill(const Load& load, double* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = load.at(i);
+        }
+    }
+
+    template <typename Load>
+    static void sumMinMax(const Load& load, size_t n, Partial& partial) {
+        for (size_t i = 0; i < n; ++i) {
+            double value = load.at(i);
+            if (value == value) {
+                ++partial.count;
+                partial.sum += value;
+            }
+            if (value < partial.min) {
+                partial.min = value;
+            }
+            if (value > partial.max) {
+                partial.max = value;
+            }
+        }
+    }
+
+    template <typename Load>
+    static double squaredDeviations(const Load& load, size_t n, double mean) {
+        double total = 0;
+        for (size_t i = 0; i < n; ++i) {
+            double value = load.at(i);
+            if (value == value) {
+                double deviation = value - mean;
+                total += deviation * deviation;
+            }
+        }
+        return total;
+    }
+};
+
+#if defined(__AVX2__)
+double horizontalSum(__m256d values) {
+    __m128d pairs = _mm_add_pd(_mm256_castpd256_pd128(values), _mm256_extractf128_pd(values, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(pairs, _mm_unpackhi_pd(pairs, pairs)));
+}
+
+struct Avx2Passes {
+    template <typename Load>
+    static void fill(const Load& load, double* out, size_t n) {
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            _mm256_storeu_pd(out + i, load.at4(i));
+        }
+        ScalarPasses::fill(Tail<Load>{load, i}, out + i, n - i);
+    }
+
+    template <typename Load>
+    static void sumMinMax(const Load& load, size_t n, Partial& partial) {
+        const __m256d one = _mm256_set1_pd(1.0);
+        __m256d sum = _mm256_setzero_pd();
+        __m256d count = _mm256_setzero_pd();
+        __m256d low = _mm256_set1_pd(partial.min);
+        __m256d high = _mm256_set1_pd(partial.max);
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256d values = load.at4(i);
+            // All ones for non-NaN lanes
+            __m256d ordered = _mm256_cmp_pd(values, values, _CMP_ORD_Q);
+            sum = _mm256_add_pd(sum, _mm256_and_pd(ordered, values));
+            count = _mm256_add_pd(count, _mm256_and_pd(ordered, one));
+            // min/max return the second operand when either is NaN, so NaN lanes keep the old value
+            low = _mm256_min_pd(values, low);
+            high = _mm256_max_pd(values, high);
+        }
+        partial.sum += horizontalSum(sum);
+        partial.count += static_cast<size_t>(horizontalSum(count));
+        alignas(32) double lows[4];
+        alignas(32) double highs[4];
+        _mm256_store_pd(lows, low);
+        _mm256_store_pd(highs, high);
+        for (int lane = 0; lane < 4; ++lane) {
+            partial.min = lows[lane] < partial.min ? lows[lane] : partial.min;
+            partial.max = highs[lane] > partial.max ? highs[lane] : partial.max;
+        }
+        ScalarPasses::sumMinMax(Tail<Load>{load, i}, n - i, partial);
+    }
+
+    template <typename Load>
+    static double squaredDeviations(const Load& load, size_t n, double mean) {
+        const __m256d center = _mm256_set1_pd(mean);
+        __m256d total = _mm256_setzero_pd();
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256d values = load.at4(i);
+            __m256d ordered = _mm256_cmp_pd(values, values, _CMP_ORD_Q);
+            __m256d deviation = _mm256_sub_pd(values, center);
+            total = _mm256_add_pd(total, _mm256_and_pd(ordered, _mm256_mul_pd(deviation, deviation)));
+        }
+        return horizontalSum(total) + ScalarPasses::squaredDeviations(Tail<Load>{load, i}, n - i, mean);
+    }
+
+private:
+    // The last n % 4 values, for the scalar loops
+    template <typename Load>
+    struct Tail {
+        const Load& load;
+        size_t offset;
+        double at(size_t i) const { return load.at(offset + i); }
+    };
+};
+#endif
+
+template <typename Passes>
+void fillWindow(const QuoteWindow& window, QuoteSeries series, double* out) {
+    for (size_t s = 0; s < window.segmentCount; ++s) {
+        const QuoteColumns& columns = window.segments[s];
+        withSeries(columns, series, [&](const auto& load) { Passes::fill(load, out, columns.size); });
+        out += columns.size;
+    }
+}
+
+template <typename Passes>
+SeriesStats windowStats(const QuoteWindow& window, QuoteSeries series) {
+    Partial partial;
+    for (size_t s = 0; s < window.segmentCount; ++s) {
+        const QuoteColumns& columns = window.segments[s];
+        withSeries(columns, series, [&](const auto& load) { Passes::sumMinMax(load, columns.size, partial); });
+    }
+    if (partial.count == 0) {
+        double nan = std::numeric_limits<double>::quiet_NaN();
+        return SeriesStats{0, nan, nan, nan, nan};
+    }
+
+    // Second pass around the mean; sum of squares minus squared mean loses everything at price scale
+    double mean = partial.sum / static_cast<double>(partial.count);
+    double squares = 0;
+    for (size_t s = 0; s < window.segmentCount; ++s) {
+        const QuoteColumns& columns = window.segments[s];
+        withSeries(columns, series, [&](const auto& load) {
+            squares += Passes::squaredDeviations(load, columns.size, mean);
+        });
+    }
+    return SeriesStats{partial.count, mean, std::sqrt(squares / static_cast<double>(partial.count)), partial.min,
+                       partial.max};
+}
+
+#if defined(__AVX2__)
+using DefaultPasses = Avx2Passes;
+#else
+using DefaultPasses = ScalarPasses;
+#endif
+
+} // namespace
+
+namespace QuoteKernels {
+
+const char* instructionSet() {
+#if defined(__AVX2__)
+    return "avx2";
+#else
+    return "scalar";
+#endif
+}
+
+void mid(const double* bid, const double* ask, double* out, size_t n) {
+    DefaultPasses::fill(MidLoad{bid, ask}, out, n);
+}
+
+void spread(const double* bid, const double* ask, double* out, size_t n) {
+    DefaultPasses::fill(SpreadLoad{bid, ask}, out, n);
+}
+
+void weightedMid(const double* bid, const double* ask, const double* bidSize, const double* askSize, double* out,
+                 size_t n) {
+    DefaultPasses::fill(WeightedMidLoad{bid, ask, bidSize, askSize}, out, n);
+}
+
+void fill(const QuoteWindow& window, QuoteSeries series, double* out) {
+    fillWindow<DefaultPasses>(window, series, out);
+}
+
+SeriesStats stats(const QuoteWindow& window, QuoteSeries series) {
+    return windowStats<DefaultPasses>(window, series);
+}
+
+SeriesStats rollingStats(const QuoteHistory& history, int32_t symbolId, QuoteSeries series, int64_t windowNs,
+                         int64_t nowNs) {
+    return stats(history.since(symbolId, nowNs - windowNs + 1), series);
+}
+
+namespace scalar {
+
+void mid(const double* bid, const double* ask, double* out, size_t n) {
+    ScalarPasses::fill(MidLoad{bid, ask}, out, n);
+}
+
+void spread(const double* bid, const double* ask, double* out, size_t n) {
+    ScalarPasses::fill(SpreadLoad{bid, ask}, out, n);
+}
+
+void weightedMid(const double* bid, const double* ask, const double* bidSize, const double* askSize, double* out,
+                 size_t n) {
+    ScalarPasses::fill(WeightedMidLoad{bid, ask, bidSize, askSize}, out, n);
+}
+
+void fill(const QuoteWindow& window, QuoteSeries series, double* out) {
+    fillWindow<ScalarPasses>(window, series, out);
+}
+
+SeriesStats stats(const QuoteWindow& window, QuoteSeries series) {
+    return windowStats<ScalarPasses>(window, series);
+}
+
+} // namespace scalar
+
+} // namespace QuoteKernels
@@ -0,0 +1,65 @@
+#ifndef QUOTEKERNELS_HPP
+#define QUOTEKERNELS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "QuoteHistory.hpp"
+
+// Derived series the kernels compute from the QuoteHistory columns
+enum class QuoteSeries {
+    Bid,
+    Ask,
+    BidSize,
+    AskSize,
+    Mid,            // (bid + ask) / 2
+    Spread,         // ask - bid
+    WeightedMid     // Size-weighted mid (microprice): (bid * askSize + ask * bidSize) / (bidSize + askSize)
+};
+
+// Summary of a series over a window. NaN values (a missing side) are skipped, so count is the
+// number of values that contributed. Empty or all-NaN windows give count 0 and NaN fields.
+struct SeriesStats {
+    size_t count;
+    double mean;
+    double stddev;      // Population standard deviation, computed in two passes for precision
+    double min;
+    double max;
+};
+
+// Column kernels over QuoteHistory windows. Built with AVX2 (-mavx2 or -march=native) they process
+// four quotes per instruction; otherwise they are the scalar loops in QuoteKernels::scalar, which
+// are always available as the reference.
+namespace QuoteKernels {
+
+// "avx2" or "scalar", whichever the default kernels were compiled as
+const char* instructionSet();
+
+// Element-wise into out[0..n)
+void mid(const double* bid, const double* ask, double* out, size_t n);
+void spread(const double* bid, const double* ask, double* out, size_t n);
+void weightedMid(const double* bid, const double* ask, const double* bidSize, const double* askSize, double* out,
+                 size_t n);
+
+// The series of a window into out, oldest first; out must hold window.size() values
+void fill(const QuoteWindow& window, QuoteSeries series, double* out);
+
+SeriesStats stats(const QuoteWindow& window, QuoteSeries series);
+
+// Stats of the quotes received after nowNs - windowNs, i.e. the trailing window; call again as it rolls
+SeriesStats rollingStats(const QuoteHistory& history, int32_t symbolId, QuoteSeries series, int64_t windowNs,
+                         int64_t nowNs);
+
+namespace scalar {
+
+void mid(const double* bid, const double* ask, double* out, size_t n);
+void spread(const double* bid, const double* ask, double* out, size_t n);
+void weightedMid(const double* bid, const double* ask, const double* bidSize, const double* askSize, double* out,
+                 size_t n);
+void fill(const QuoteWindow& window, QuoteSeries series, double* out);
+SeriesStats stats(const QuoteWindow& window, QuoteSeries series);
+
+} // namespace scalar
+
+} // namespace QuoteKernels
+
+#endif // QUOTEKERNELS_HPP
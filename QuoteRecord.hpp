@@ -0,0 +1,36 @@
+#ifndef QUOTERECORD_HPP
+#define QUOTERECORD_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+// Fixed-size decoded quote handed from the feed I/O thread to consumers (one cache line)
+struct alignas(64) QuoteRecord {
+    static constexpr size_t kMaxSymbolLength = 19;
+
+    int64_t receiveTimeNs; // Kernel receive time of the frame when the transport has it, else monotonicNowNs()
+                           // when the frame reached onMessage (both on the monotonicNowNs() scale)
+    double bidPrice;
+    double askPrice;
+    double bidSize;
+    double askSize;
+    int32_t symbolId;      // QuoteBook id, or QuoteBook::kNotFound for untracked symbols
+    uint8_t symbolLength;
+    char symbol[kMaxSymbolLength];
+
+    // Longer symbols are truncated; symbolId resolves the full name through the QuoteBook
+    void setSymbol(std::string_view name) {
+        symbolLength = static_cast<uint8_t>(std::min(name.size(), kMaxSymbolLength));
+        std::memcpy(symbol, name.data(), symbolLength);
+    }
+
+    std::string_view symbolView() const { return std::string_view(symbol, symbolLength); }
+
+    double midPrice() const { return (bidPrice + askPrice) / 2; }
+};
+
+static_assert(sizeof(QuoteRecord) == 64, "QuoteRecord should fill exactly one cache line");
+
+#endif // QUOTERECORD_HPP
@@ -0,0 +1,163 @@
+#include "RestConnection.hpp"
+#include <iostream>
+#include <stdexcept>
+#include <boost/asio/connect.hpp>
+#include <boost/asio/ssl/error.hpp>
+#include <boost/asio/ssl/host_name_verification.hpp>
+#include "MonotonicClock.hpp"
+#include "SocketTuning.hpp"
+
+namespace http = boost::beast::http;
+
+namespace {
+
+// Responses are a few KB read synchronously: TCP_NODELAY for the requests, no large buffer or stamps
+const SocketTuning kRestSocketTuning{true, 0, false};
+
+// Errors that mean the server closed a kept-alive stream before handling our request
+bool isStaleConnectionError(const boost::system::error_code& ec) {
+    return ec == http::error::end_of_stream ||
+           ec == boost::asio::error::eof ||
+           ec == boost::asio::error::connection_reset ||
+           ec == boost::asio::error::connection_aborted ||
+           ec == boost::asio::error::broken_pipe ||
+           ec == boost::asio::ssl::error::stream_truncated;
+}
+
+} // namespace
+
+RestConnection::RestConnection(std::string host, std::string port, SessionTimeline& timeline)
+    : apiHost(std::move(host)),
+      apiPort(std::move(port)),
+      sessionTimeline(timeline),
+      sslContext(boost::asio::ssl::context::tls_client) {
+    sslContext.set_options(boost::asio::ssl::context::no_sslv2 | boost::asio::ssl::context::no_sslv3 |
+                           boost::asio::ssl::context::no_tlsv1 | boost::asio::ssl::context::no_tlsv1_1);
+    sslContext.set_default_verify_paths();
+    sslContext.set_verify_mode(boost::asio::ssl::verify_peer);
+    sslContext.set_verify_callback(boost::asio::ssl::host_name_verification(apiHost));
+    // Keep client sessions so a reconnect can resume instead of doing a full handshake
+    SSL_CTX_set_session_cache_mode(sslContext.native_handle(), SSL_SESS_CACHE_CLIENT);
+}
+
+RestConnection::~RestConnection() {
+    try {
+        close();
+    } catch (...) {
+    }
+    if (tlsSession != nullptr) {
+        SSL_SESSION_free(tlsSession);
+    }
+}
+
+void RestConnection::setCaFile(const std::string& caFile) {
+    sslContext.load_verify_file(caFile);
+}
+
+void RestConnection::connect() {
+    if (endpoints.empty()) {
+        int64_t start = monotonicNowNs();
+        boost::asio::ip::tcp::resolver resolver(ioc);
+        endpoints = resolver.resolve(apiHost, apiPort);
+        sessionTimeline.record(SessionStage::RestResolve, start, monotonicNowNs());
+    }
+
+    stream = std::make_unique<Stream>(ioc, sslContext);
+    buffer.clear();
+
+    // SNI, and the ticket from the previous connection if there is one
+    if (!SSL_set_tlsext_host_name(stream->native_handle(), apiHost.c_str())) {
+        throw std::runtime_error("Failed to set TLS SNI host name");
+    }
+    if (tlsSession != nullptr) {
+        SSL_set_session(stream->native_handle(), tlsSession);
+    }
+
+    int64_t start = monotonicNowNs();
+    boost::beast::get_lowest_layer(*stream).connect(endpoints);
+    applySocketTuning(boost::beast::get_lowest_layer(*stream).socket().native_handle(), kRestSocketTuning);
+    int64_t connected = monotonicNowNs();
+    sessionTimeline.record(SessionStage::RestTcpConnect, start, connected);
+
+    stream->handshake(boost::asio::ssl::stream_base::client);
+    sessionTimeline.record(SessionStage::RestTlsHandshake, connected, monotonicNowNs());
+
+    ++counters.handshakes;
+    if (SSL_session_reused(stream->native_handle())) {
+        ++counters.resumedHandshakes;
+    }
+}
+
+void RestConnection::saveTlsSession() {
+    // TLS 1.3 tickets arrive after the handshake, so this runs once a response has been read
+    SSL_SESSION* session = SSL_get0_session(stream->native_handle());
+    if (session == nullptr || !SSL_SESSION_is_resumable(session)) {
+        return;
+    }
+    // Keep a private copy: OpenSSL marks the live session unresumable if the stream later dies
+    // with an error, which is exactly the case a reconnect has to handle
+    SSL_SESSION* copy = SSL_SESSION_dup(session);
+    if (copy == nullptr) {
+        return;
+    }
+    if (tlsSession != nullptr) {
+        SSL_SESSION_free(tlsSession);
+    }
+    tlsSession = copy;
+}
+
+void RestConnection::dropStream() {
+    if (stream) {
+        boost::system::error_code ignored;
+        boost::beast::get_lowest_layer(*stream).socket().close(ignored);
+        stream.reset();
+    }
+}
+
+RestConnection::Response RestConnection::send(Request& req) {
+    req.set(http::field::host, apiHost);
+    req.keep_alive(true);
+    req.prepare_payload();
+    ++counters.requests;
+
+    for (int attempt = 0;; ++attempt) {
+        bool reused = static_cast<bool>(stream);
+        if (!reused) {
+            connect();
+        }
+
+        boost::system::error_code ec;
+        Response res;
+        http::write(*stream, req, ec);
+        if (!ec) {
+            http::read(*stream, buffer, res, ec);
+        }
+
+        if (!ec) {
+            saveTlsSession();
+            if (!res.keep_alive()) {
+                close();
+            }
+            return res;
+        }
+
+        dropStream();
+        // Only a stream we reused can have gone stale; a fresh connection failing is a real error
+        if (!reused || attempt > 0 || !isStaleConnectionError(ec)) {
+            throw boost::system::system_error(ec, "REST request to " + apiHost + " failed");
+        }
+        ++counters.reconnects;
+    }
+}
+
+void RestConnection::close() {
+    if (!stream) {
+        return;
+    }
+    boost::system::error_code ec;
+    stream->shutdown(ec);
+    if (ec && ec != boost::asio::error::eof && ec != boost::asio::ssl::error::stream_truncated) {
+        std::cerr << "SSL Shutdown Warning: " << ec.message() << std::endl;
+    }
+    dropStream();
+}
@@ -0,0 +1,69 @@
+#ifndef RESTCONNECTION_HPP
+#define RESTCONNECTION_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/ssl/context.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <boost/beast/ssl.hpp>
+#include <openssl/ssl.h>
+#include "SessionTimeline.hpp"
+
+// One persistent HTTPS/1.1 connection to a REST host. The host is resolved once, and the TLS stream
+// is kept open between requests. If the server has closed an idle stream, the request is retried
+// once on a fresh connection, and that reconnect resumes the previous TLS session from its ticket.
+class RestConnection {
+public:
+    using Request = boost::beast::http::request<boost::beast::http::string_body>;
+    using Response = boost::beast::http::response<boost::beast::http::string_body>;
+
+    struct Stats {
+        uint64_t requests;
+        uint64_t handshakes;         // Full and resumed TLS handshakes
+        uint64_t resumedHandshakes;  // Handshakes that reused a saved TLS session
+        uint64_t reconnects;         // Requests retried because a reused stream had been closed
+    };
+
+    RestConnection(std::string host, std::string port, SessionTimeline& timeline);
+    ~RestConnection();
+
+    RestConnection(const RestConnection&) = delete;
+    RestConnection& operator=(const RestConnection&) = delete;
+
+    // Trust this CA bundle instead of the system default paths (e.g. for a local stand-in server)
+    void setCaFile(const std::string& caFile);
+
+    // Sends req (Host and keep-alive are filled in) and returns the response
+    Response send(Request& req);
+
+    // Gracefully shuts the TLS stream down; the next send() reconnects
+    void close();
+
+    const std::string& host() const { return apiHost; }
+    Stats stats() const { return counters; }
+
+private:
+    using Stream = boost::beast::ssl_stream<boost::beast::tcp_stream>;
+
+    std::string apiHost;
+    std::string apiPort;
+    SessionTimeline& sessionTimeline;
+
+    boost::asio::io_context ioc;
+    boost::asio::ssl::context sslContext;
+    boost::asio::ip::tcp::resolver::results_type endpoints;
+    std::unique_ptr<Stream> stream;
+    boost::beast::flat_buffer buffer;
+    SSL_SESSION* tlsSession = nullptr;
+    Stats counters{};
+
+    void connect();
+    void saveTlsSession();
+    void dropStream();
+};
+
+#endif // RESTCONNECTION_HPP
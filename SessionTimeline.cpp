@@ -0,0 +1,50 @@
+#include "SessionTimeline.hpp"
+#include <iomanip>
+
+const char* SessionTimeline::stageName(SessionStage stage) {
+    switch (stage) {
+        case SessionStage::RestResolve: return "rest_resolve";
+        case SessionStage::RestTcpConnect: return "rest_tcp_connect";
+        case SessionStage::RestTlsHandshake: return "rest_tls_handshake";
+        case SessionStage::RestAuthenticate: return "rest_authenticate";
+        case SessionStage::RestQuoteToken: return "rest_quote_token";
+        case SessionStage::RestCloseSession: return "rest_close_session";
+        case SessionStage::WsTlsContextInit: return "ws_tls_context_init";
+        case SessionStage::WsResolveConnect: return "ws_resolve_connect";
+        case SessionStage::WsTlsHandshake: return "ws_tls_handshake";
+        case SessionStage::WsUpgrade: return "ws_upgrade";
+        case SessionStage::SetupToAuthState: return "setup_to_auth_state";
+        case SessionStage::TokenWait: return "token_wait";
+        case SessionStage::AuthToChannelOpened: return "auth_to_channel_opened";
+        case SessionStage::FeedSetupToFeedConfig: return "feed_setup_to_feed_config";
+        case SessionStage::SubscriptionToFirstQuote: return "subscription_to_first_quote";
+        case SessionStage::SubscriptionToFullCoverage: return "subscription_to_full_coverage";
+        case SessionStage::ReconnectGap: return "reconnect_gap";
+        case SessionStage::Count: break;
+    }
+    return "unknown";
+}
+
+void SessionTimeline::merge(const SessionTimeline& other) {
+    for (size_t i = 0; i < kStageCount; ++i) {
+        histograms[i].merge(other.histograms[i]);
+    }
+}
+
+void SessionTimeline::reset() {
+    for (auto& histogram : histograms) {
+        histogram.reset();
+    }
+}
+
+void SessionTimeline::report(std::ostream& out) const {
+    std::ios_base::fmtflags flags = out.flags();
+    for (size_t i = 0; i < kStageCount; ++i) {
+        if (histograms[i].count() == 0) {
+            continue;
+        }
+        out << std::left << std::setw(30) << stageName(static_cast<SessionStage>(i))
+            << histograms[i].summary() << '\n';
+    }
+    out.flags(flags);
+}
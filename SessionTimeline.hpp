@@ -0,0 +1,61 @@
+#ifndef SESSIONTIMELINE_HPP
+#define SESSIONTIMELINE_HPP
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include "LatencyHistogram.hpp"
+
+// Phases of a session, from the REST login to the first quote of every subscribed symbol
+enum class SessionStage {
+    // dxFeedSession REST calls (each call records its own resolve/connect/TLS samples)
+    RestResolve,
+    RestTcpConnect,
+    RestTlsHandshake,
+    RestAuthenticate,       // POST /sessions request + response
+    RestQuoteToken,         // GET /api-quote-tokens request + response
+    RestCloseSession,       // DELETE /sessions request + response
+
+    // dxLink websocket
+    WsTlsContextInit,       // TLS context and CA bundle load (every connection on websocketpp, once on beast)
+    WsResolveConnect,       // FeedTransport::open() until the TCP socket is connected (DNS + TCP)
+    WsTlsHandshake,         // TCP connected until the TLS handshake completes
+    WsUpgrade,              // TLS done until the HTTP upgrade response (open handler)
+    SetupToAuthState,       // SETUP sent until the first AUTH_STATE
+    TokenWait,              // First AUTH_STATE until the token arrives (overlapped bootstrap only)
+    AuthToChannelOpened,    // AUTH sent until CHANNEL_OPENED
+    FeedSetupToFeedConfig,  // FEED_SETUP sent until FEED_CONFIG
+    SubscriptionToFirstQuote, // FEED_SUBSCRIPTION sent until the first quote, one sample per symbol
+    SubscriptionToFullCoverage, // FEED_SUBSCRIPTION sent until every subscribed symbol has quoted, per change
+    ReconnectGap,           // Streaming: connection lost until the first quote on the new connection
+
+    Count
+};
+
+// Per-connection stage latencies. Each stage feeds a LatencyHistogram so timelines from several
+// connections or runs can be merged and reported as p50/p99/p99.9/max.
+class SessionTimeline {
+public:
+    static constexpr size_t kStageCount = static_cast<size_t>(SessionStage::Count);
+
+    void record(SessionStage stage, int64_t startNs, int64_t endNs) {
+        histograms[static_cast<size_t>(stage)].recordDuration(startNs, endNs);
+    }
+
+    const LatencyHistogram& histogram(SessionStage stage) const {
+        return histograms[static_cast<size_t>(stage)];
+    }
+
+    void merge(const SessionTimeline& other);
+    void reset();
+
+    // One line per stage that has samples
+    void report(std::ostream& out) const;
+
+    static const char* stageName(SessionStage stage);
+
+private:
+    std::array<LatencyHistogram, kStageCount> histograms;
+};
+
+#endif // SESSIONTIMELINE_HPP
@@ -0,0 +1,160 @@
+#include "ShardedFeedEngine.hpp"
+#include "IdleBackoff.hpp"
+#include "MonotonicClock.hpp"
+#include "ThreadAffinity.hpp"
+#include <iomanip>
+#include <stdexcept>
+
+ShardedFeedEngine::ShardedFeedEngine(const ShardedFeedConfig& engineConfig, const std::vector<std::string>& symbols)
+    : config(engineConfig), quoteBook(symbols) {
+    if (config.shardCount == 0) {
+        throw std::runtime_error("ShardedFeedEngine needs at least one shard");
+    }
+    for (size_t i = 0; i < config.shardCount; ++i) {
+        shards.push_back(std::make_unique<Shard>());
+    }
+
+    // Round-robin over the interned ids, so each slot has exactly one writing shard even if the
+    // input list repeats a symbol
+    for (int32_t id = 0; id < static_cast<int32_t>(quoteBook.size()); ++id) {
+        shards[static_cast<size_t>(id) % shards.size()]->symbols.emplace_back(quoteBook.symbol(id));
+    }
+
+    for (size_t i = 0; i < shards.size(); ++i) {
+        Shard& shard = *shards[i];
+        shard.client = std::make_unique<MarketDataWebSocket>(config.wsUrl, config.token,
+                                                             config.baseChannel + static_cast<int>(i),
+                                                             config.transport);
+        if (!config.caFile.empty()) {
+            shard.client->setCaFile(config.caFile);
+        }
+        shard.client->useSharedBook(quoteBook);
+        shard.client->setSymbolsToTrack(shard.symbols);
+        if (config.streaming) {
+            shard.client->enableStreaming(config.streamingConfig);
+        }
+    }
+}
+
+ShardedFeedEngine::~ShardedFeedEngine() {
+    stop();
+    wait();
+}
+
+void ShardedFeedEngine::start(Callback onQuote) {
+    if (merging.exchange(true)) {
+        throw std::runtime_error("ShardedFeedEngine already started");
+    }
+    startNs = monotonicNowNs();
+    mergerThread = std::thread(&ShardedFeedEngine::mergeLoop, this, std::move(onQuote));
+    for (size_t i = 0; i < shards.size(); ++i) {
+        shards[i]->thread = std::thread(&ShardedFeedEngine::runShard, this, i);
+    }
+}
+
+void ShardedFeedEngine::runShard(size_t index) {
+    Shard& shard = *shards[index];
+    if (config.firstCpu >= 0) {
+        shard.pinned = pinCurrentThread(config.firstCpu + static_cast<int>(index));
+    }
+    shard.client->connect();
+    shard.finishedNs = monotonicNowNs();
+}
+
+void ShardedFeedEngine::wait() {
+    for (auto& shard : shards) {
+        if (shard->thread.joinable()) {
+            shard->thread.join();
+        }
+    }
+    merging = false;
+    if (mergerThread.joinable()) {
+        mergerThread.join();
+    }
+}
+
+void ShardedFeedEngine::stop() {
+    for (auto& shard : shards) {
+        shard->client->stop();
+    }
+}
+
+size_t ShardedFeedEngine::drainShards(const Callback& onQuote) {
+    size_t total = 0;
+    for (size_t i = 0; i < shards.size(); ++i) {
+        Shard& shard = *shards[i];
+        // One clock read per batch; every record in the batch was already published at this point
+        int64_t nowNs = monotonicNowNs();
+        size_t count = shard.client->quotes().drain([&](const QuoteRecord& quote) {
+            shard.handoffLatency.recordDuration(quote.receiveTimeNs, nowNs);
+            onQuote(quote, i);
+        }, 256);
+        shard.quotes += count;
+        total += count;
+    }
+    return total;
+}
+
+void ShardedFeedEngine::mergeLoop(Callback onQuote) {
+    // Same idle policy as the QuoteDispatcher consumer
+    IdleBackoff backoff;
+    while (merging.load(std::memory_order_acquire)) {
+        if (drainShards(onQuote) > 0) {
+            backoff.reset();
+        } else {
+            backoff.idle();
+        }
+    }
+
+    // The shards have exited; deliver what they published last
+    while (drainShards(onQuote) > 0) {
+    }
+}
+
+ShardedFeedEngine::ShardStats ShardedFeedEngine::shardStats(size_t index) const {
+    const Shard& shard = *shards[index];
+    const MarketDataWebSocket& client = *shard.client;
+    double seconds = static_cast<double>(shard.finishedNs - startNs) / 1e9;
+
+    ShardStats stats;
+    stats.symbols = shard.symbols.size();
+    stats.frames = client.frameCount();
+    stats.quotes = shard.quotes;
+    stats.dropped = shard.client->quotes().stats().dropped;
+    stats.reconnects = client.streamingStats().reconnects;
+    stats.quotesPerSecond = seconds > 0 ? static_cast<double>(shard.quotes) / seconds : 0.0;
+    stats.frameLatency = client.frameLatency();
+    stats.handoffLatency = shard.handoffLatency;
+    return stats;
+}
+
+SessionTimeline ShardedFeedEngine::timeline() const {
+    SessionTimeline merged;
+    for (const auto& shard : shards) {
+        merged.merge(shard->client->timeline());
+    }
+    return merged;
+}
+
+void ShardedFeedEngine::report(std::ostream& out) const {
+    uint64_t totalQuotes = 0;
+    double totalRate = 0;
+    for (size_t i = 0; i < shards.size(); ++i) {
+        ShardStats stats = shardStats(i);
+        totalQuotes += stats.quotes;
+        totalRate += stats.quotesPerSecond;
+        out << "shard " << i << (shards[i]->pinned ? " (pinned)" : "")
+            << " | symbols: " << stats.symbols
+            << " | frames: " << stats.frames
+            << " | quotes: " << stats.quotes
+            << " | dropped: " << stats.dropped
+            << " | reconnects: " << stats.reconnects
+            << " | quotes/s: " << std::fixed << std::setprecision(0) << stats.quotesPerSecond
+            << std::defaultfloat << '\n'
+            << "  frame latency:   " << stats.frameLatency.summary() << '\n'
+            << "  handoff latency: " << stats.handoffLatency.summary() << '\n';
+    }
+    out << "total | shards: " << shards.size()
+        << " | quotes: " << totalQuotes
+        << " | quotes/s: " << std::fixed << std::setprecision(0) << totalRate << std::defaultfloat << std::endl;
+}
@@ -0,0 +1,99 @@
+#ifndef SHARDEDFEEDENGINE_HPP
+#define SHARDEDFEEDENGINE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "LatencyHistogram.hpp"
+#include "MarketDataWebSocket.hpp"
+#include "QuoteBook.hpp"
+#include "SessionTimeline.hpp"
+
+struct ShardedFeedConfig {
+    std::string wsUrl = "wss://tasty-openapi-ws.dxfeed.com/realtime";
+    std::string token;
+    std::string caFile;               // Empty: the default CA bundle
+    size_t shardCount = 2;
+    int baseChannel = 3;              // Shard i uses channel baseChannel + i
+    int firstCpu = 0;                 // Shard i is pinned to allowed CPU firstCpu + i; -1 disables pinning
+    bool streaming = false;           // Otherwise every shard stops after its snapshot
+    StreamingConfig streamingConfig;
+    TransportKind transport = TransportKind::Websocketpp;
+};
+
+// Splits a large symbol universe across N dxLink connections. Each shard is a MarketDataWebSocket
+// with its own io_context running on its own pinned thread and its own channel. All shards write
+// disjoint slots of one shared QuoteBook and hand quotes off through their own SPSC ring; a single
+// merger thread drains the rings into one callback.
+class ShardedFeedEngine {
+public:
+    // Called on the merger thread for every quote, with the index of the shard it came from
+    using Callback = std::function<void(const QuoteRecord&, size_t shard)>;
+
+    struct ShardStats {
+        size_t symbols;
+        uint64_t frames;                 // FEED_DATA frames decoded
+        uint64_t quotes;                 // Quotes delivered to the merged callback
+        uint64_t dropped;                // Quotes lost to a full shard ring
+        uint64_t reconnects;
+        double quotesPerSecond;          // quotes over the time between start() and the shard's exit
+        LatencyHistogram frameLatency;   // Receive -> published, per FEED_DATA frame
+        LatencyHistogram handoffLatency; // Receive -> merged callback, per quote
+    };
+
+    ShardedFeedEngine(const ShardedFeedConfig& config, const std::vector<std::string>& symbols);
+    ~ShardedFeedEngine();
+
+    ShardedFeedEngine(const ShardedFeedEngine&) = delete;
+    ShardedFeedEngine& operator=(const ShardedFeedEngine&) = delete;
+
+    // Starts the shard threads and the merger thread
+    void start(Callback onQuote);
+
+    // Blocks until every shard has returned (snapshot complete, stop(), or token rejected), then
+    // delivers the remaining quotes and stops the merger
+    void wait();
+
+    // Makes every shard return, from any thread
+    void stop();
+
+    size_t shardCount() const { return shards.size(); }
+    const QuoteBook& book() const { return quoteBook; }
+
+    // Read after wait()
+    ShardStats shardStats(size_t shard) const;
+    SessionTimeline timeline() const;
+    void report(std::ostream& out) const;
+
+private:
+    struct Shard {
+        std::vector<std::string> symbols;
+        std::unique_ptr<MarketDataWebSocket> client;
+        std::thread thread;
+        int64_t finishedNs = 0;
+        bool pinned = false;
+
+        // Owned by the merger thread
+        uint64_t quotes = 0;
+        LatencyHistogram handoffLatency;
+    };
+
+    ShardedFeedConfig config;
+    QuoteBook quoteBook;
+    std::vector<std::unique_ptr<Shard>> shards;
+
+    std::thread mergerThread;
+    std::atomic<bool> merging{false};
+    int64_t startNs = 0;
+
+    void runShard(size_t index);
+    void mergeLoop(Callback onQuote);
+    size_t drainShards(const Callback& onQuote);
+};
+
+#endif // SHARDEDFEEDENGINE_HPP
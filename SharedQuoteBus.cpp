@@ -0,0 +1,236 @@
+#include "SharedQuoteBus.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char kMagic[8] = {'D', 'X', 'S', 'H', 'M', 'Q', '0', '1'};
+constexpr uint32_t kVersion = 1;
+
+static_assert(sizeof(SharedQuoteHeader) == 128, "segment header must stay 128 bytes");
+static_assert(sizeof(SharedQuoteSlot) == 128, "ring slots must stay two cache lines");
+static_assert(sizeof(SharedLastValue) == 128, "last values must stay two cache lines");
+static_assert(sizeof(SharedSymbolName) == 64, "directory entries must stay one cache line");
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+              "shared atomics must be lock-free to work across processes");
+
+size_t roundUpToPowerOfTwo(size_t value) {
+    size_t capacity = 2;
+    while (capacity < value) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+bool processAlive(int64_t pid) {
+    return pid > 0 && (::kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM);
+}
+
+// Pid of the publisher that created an existing segment, or 0 if it is not a ready segment
+int64_t existingPublisher(const std::string& name) {
+    int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return 0;
+    }
+    int64_t pid = 0;
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= sizeof(SharedQuoteHeader)) {
+        void* mapping = ::mmap(nullptr, sizeof(SharedQuoteHeader), PROT_READ, MAP_SHARED, fd, 0);
+        if (mapping != MAP_FAILED) {
+            const auto* header = static_cast<const SharedQuoteHeader*>(mapping);
+            if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) == 0 &&
+                header->closed.load(std::memory_order_acquire) == 0) {
+                pid = header->publisherPid;
+            }
+            ::munmap(mapping, sizeof(SharedQuoteHeader));
+        }
+    }
+    ::close(fd);
+    return pid;
+}
+
+} // namespace
+
+SharedQuotePublisher::SharedQuotePublisher(const std::string& segmentName, size_t ringCapacity,
+                                           size_t symbolCapacity)
+    : name(segmentName) {
+    int64_t owner = existingPublisher(name);
+    if (processAlive(owner)) {
+        throw std::runtime_error("Shared quote segment " + name + " is published by running process " +
+                                 std::to_string(owner));
+    }
+    // Left behind by a publisher that died; readers still attached keep their mapping
+    ::shm_unlink(name.c_str());
+
+    int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to create shared quote segment: " + name);
+    }
+    size_t slots = roundUpToPowerOfTwo(ringCapacity);
+    size_t ringOffset = sizeof(SharedQuoteHeader);
+    size_t lastValueOffset = ringOffset + slots * sizeof(SharedQuoteSlot);
+    size_t directoryOffset = lastValueOffset + symbolCapacity * sizeof(SharedLastValue);
+    mappingSize = directoryOffset + symbolCapacity * sizeof(SharedSymbolName);
+    if (::ftruncate(fd, static_cast<off_t>(mappingSize)) != 0) {
+        ::close(fd);
+        ::shm_unlink(name.c_str());
+        throw std::runtime_error("Failed to size shared quote segment: " + name);
+    }
+
+    int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+    flags |= MAP_POPULATE;
+#endif
+    mapping = ::mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, flags, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        ::shm_unlink(name.c_str());
+        throw std::runtime_error("Failed to map shared quote segment: " + name);
+    }
+
+    // ftruncate zero-filled the segment: every slot and last value starts at sequence/version 0
+    char* base = static_cast<char*>(mapping);
+    header = reinterpret_cast<SharedQuoteHeader*>(base);
+    ring = reinterpret_cast<SharedQuoteSlot*>(base + ringOffset);
+    lastValues = reinterpret_cast<SharedLastValue*>(base + lastValueOffset);
+    directory = reinterpret_cast<SharedSymbolName*>(base + directoryOffset);
+    ringMask = slots - 1;
+
+    header->version = kVersion;
+    header->headerSize = sizeof(SharedQuoteHeader);
+    header->ringCapacity = slots;
+    header->symbolCapacity = symbolCapacity;
+    header->ringOffset = ringOffset;
+    header->lastValueOffset = lastValueOffset;
+    header->directoryOffset = directoryOffset;
+    header->publisherPid = ::getpid();
+
+    // Readers check the magic first, so it goes in once everything else is in place
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(header->magic, kMagic, sizeof(kMagic));
+}
+
+SharedQuotePublisher::~SharedQuotePublisher() {
+    if (!mapping) {
+        return;
+    }
+    header->closed.store(1, std::memory_order_release);
+    ::munmap(mapping, mappingSize);
+    ::shm_unlink(name.c_str());
+}
+
+bool SharedQuotePublisher::defineSymbol(int32_t symbolId, std::string_view symbol) {
+    if (symbolId < 0 || static_cast<uint64_t>(symbolId) >= header->symbolCapacity) {
+        return false;
+    }
+    SharedSymbolName& entry = directory[symbolId];
+    entry.length = static_cast<uint8_t>(std::min(symbol.size(), sizeof(entry.name)));
+    std::memcpy(entry.name, symbol.data(), entry.length);
+    uint32_t count = header->symbolCount.load(std::memory_order_relaxed);
+    if (static_cast<uint32_t>(symbolId) >= count) {
+        header->symbolCount.store(static_cast<uint32_t>(symbolId) + 1, std::memory_order_release);
+    }
+    return true;
+}
+
+SharedQuoteReader::SharedQuoteReader(const std::string& name, bool fromOldest) {
+    int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        throw std::runtime_error("No shared quote segment " + name + " (is the publisher running?)");
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(SharedQuoteHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Not a shared quote segment: " + name);
+    }
+    mappingSize = static_cast<size_t>(info.st_size);
+    mapping = ::mmap(nullptr, mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        throw std::runtime_error("Failed to map shared quote segment: " + name);
+    }
+
+    const char* base = static_cast<const char*>(mapping);
+    header = reinterpret_cast<const SharedQuoteHeader*>(base);
+    bool ready = std::memcmp(header->magic, kMagic, sizeof(kMagic)) == 0;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (!ready || header->version != kVersion ||
+        header->directoryOffset + header->symbolCapacity * sizeof(SharedSymbolName) > mappingSize) {
+        ::munmap(mapping, mappingSize);
+        mapping = nullptr;
+        throw std::runtime_error("Not a shared quote segment (or not ready yet): " + name);
+    }
+    ring = reinterpret_cast<const SharedQuoteSlot*>(base + header->ringOffset);
+    lastValues = reinterpret_cast<const SharedLastValue*>(base + header->lastValueOffset);
+    directory = reinterpret_cast<const SharedSymbolName*>(base + header->directoryOffset);
+    ringCapacity = header->ringCapacity;
+    ringMask = ringCapacity - 1;
+
+    uint64_t published = publishedSequence();
+    if (fromOldest) {
+        nextSequence = published >= ringCapacity ? published - ringCapacity + 1 : 1;
+    } else {
+        nextSequence = published + 1;
+    }
+    lastReadSequence = nextSequence - 1;
+}
+
+SharedQuoteReader::~SharedQuoteReader() {
+    if (mapping) {
+        ::munmap(mapping, mappingSize);
+    }
+}
+
+bool SharedQuoteReader::latest(int32_t symbolId, QuoteRecord& quote, uint64_t* sequence) const {
+    if (symbolId < 0 || static_cast<uint64_t>(symbolId) >= header->symbolCapacity) {
+        return false;
+    }
+    const SharedLastValue& last = lastValues[symbolId];
+    for (;;) {
+        uint64_t before = last.version.load(std::memory_order_acquire);
+        if (before == 0) {
+            return false;
+        }
+        if ((before & 1) == 0) {
+            uint64_t recordSequence = last.sequence;
+            std::memcpy(static_cast<void*>(&quote), &last.record, sizeof(QuoteRecord));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (last.version.load(std::memory_order_relaxed) == before) {
+                if (sequence) {
+                    *sequence = recordSequence;
+                }
+                return true;
+            }
+        }
+    }
+}
+
+int32_t SharedQuoteReader::find(std::string_view symbol) const {
+    size_t count = symbolCount();
+    for (size_t id = 0; id < count; ++id) {
+        if (this->symbol(static_cast<int32_t>(id)) == symbol) {
+            return static_cast<int32_t>(id);
+        }
+    }
+    return -1;
+}
+
+std::string_view SharedQuoteReader::symbol(int32_t symbolId) const {
+    if (symbolId < 0 || static_cast<size_t>(symbolId) >= symbolCount()) {
+        return std::string_view();
+    }
+    const SharedSymbolName& entry = directory[symbolId];
+    return std::string_view(entry.name, entry.length);
+}
+
+bool SharedQuoteReader::closed() const {
+    return header->closed.load(std::memory_order_acquire) != 0 || !processAlive(header->publisherPid);
+}
@@ -0,0 +1,197 @@
+#ifndef SHAREDQUOTEBUS_HPP
+#define SHAREDQUOTEBUS_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include "QuoteRecord.hpp"
+
+// Segment layout (POSIX shared memory, all offsets from the start): a 128-byte header, the broadcast
+// ring of ringCapacity slots, the last-value table of symbolCapacity entries and the symbol
+// directory of symbolCapacity names. Every slot and entry is cache-line aligned.
+struct SharedQuoteHeader {
+    char magic[8];                  // "DXSHMQ01", written last when the segment is ready
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t ringCapacity;          // Power of two
+    uint64_t symbolCapacity;
+    uint64_t ringOffset;
+    uint64_t lastValueOffset;
+    uint64_t directoryOffset;
+    int64_t publisherPid;
+    alignas(64) std::atomic<uint64_t> publishedSequence;   // Newest sequence in the ring (0: none yet)
+    std::atomic<uint32_t> symbolCount;                     // Directory entries defined so far
+    std::atomic<uint32_t> closed;                          // Set when the publisher shuts down
+    uint64_t reserved[6];
+};
+
+// One broadcast ring slot: the record and the sequence it was published under (kBusy while the
+// publisher overwrites it)
+struct alignas(64) SharedQuoteSlot {
+    static constexpr uint64_t kBusy = UINT64_MAX;
+
+    std::atomic<uint64_t> sequence;
+    QuoteRecord record;
+};
+
+// Newest record of one symbol; version is odd while the publisher writes it (seqlock)
+struct alignas(64) SharedLastValue {
+    std::atomic<uint64_t> version;
+    uint64_t sequence;              // Ring sequence the record was published under
+    QuoteRecord record;
+};
+
+struct SharedSymbolName {
+    uint8_t length;
+    char name[63];
+};
+
+// Fans normalized top-of-book updates out to any number of processes on the host. Every published
+// QuoteRecord gets the next sequence number and goes into the broadcast ring, and the last-value
+// table keeps the newest record per symbol id, so a reader that joins late or falls a whole ring
+// behind can still rebuild the current book. Nothing locks: ring slots and last values are
+// seqlocks that readers validate after copying, and readers never write to the segment.
+//
+// One publishing thread. The segment is created owner-only (0600), like the frame journal and the
+// token cache, so readers must run as the same user. It is unlinked when the publisher is destroyed;
+// readers that still have it mapped see closed().
+class SharedQuotePublisher {
+public:
+    // Creates the segment name ("/dxfeed-quotes"). A segment left behind by a publisher that is no
+    // longer running is replaced; one whose publisher is still alive is an error.
+    SharedQuotePublisher(const std::string& name, size_t ringCapacity, size_t symbolCapacity);
+    ~SharedQuotePublisher();
+
+    SharedQuotePublisher(const SharedQuotePublisher&) = delete;
+    SharedQuotePublisher& operator=(const SharedQuotePublisher&) = delete;
+
+    // Names symbolId in the directory (QuoteBook ids, so readers can look symbols up by name).
+    // Returns false if the id is outside the capacity.
+    bool defineSymbol(int32_t symbolId, std::string_view symbol);
+
+    // Returns the record's sequence number
+    uint64_t publish(const QuoteRecord& quote) {
+        uint64_t sequence = ++lastSequence;
+        SharedQuoteSlot& slot = ring[sequence & ringMask];
+        slot.sequence.store(SharedQuoteSlot::kBusy, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(static_cast<void*>(&slot.record), &quote, sizeof(QuoteRecord));
+        slot.sequence.store(sequence, std::memory_order_release);
+
+        if (quote.symbolId >= 0 && static_cast<uint64_t>(quote.symbolId) < header->symbolCapacity) {
+            SharedLastValue& last = lastValues[quote.symbolId];
+            uint64_t version = last.version.load(std::memory_order_relaxed);
+            last.version.store(version + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            last.sequence = sequence;
+            std::memcpy(static_cast<void*>(&last.record), &quote, sizeof(QuoteRecord));
+            last.version.store(version + 2, std::memory_order_release);
+        }
+
+        header->publishedSequence.store(sequence, std::memory_order_release);
+        return sequence;
+    }
+
+    uint64_t publishedCount() const { return lastSequence; }
+    size_t ringCapacity() const { return ringMask + 1; }
+    const std::string& segmentName() const { return name; }
+
+private:
+    std::string name;
+    void* mapping = nullptr;
+    size_t mappingSize = 0;
+    SharedQuoteHeader* header = nullptr;
+    SharedQuoteSlot* ring = nullptr;
+    SharedLastValue* lastValues = nullptr;
+    SharedSymbolName* directory = nullptr;
+    size_t ringMask = 0;
+    uint64_t lastSequence = 0;
+};
+
+// One consumer process's view of a publisher's segment, mapped read-only. poll() walks the
+// broadcast ring in sequence order; if the publisher laps the reader, the records it overwrote are
+// counted as lost and reading resumes at the oldest record still in the ring. latest() reads the
+// last-value table. Single thread per reader; open one reader per consuming thread.
+class SharedQuoteReader {
+public:
+    // Attaches to a published segment. Starts after the newest record unless fromOldest, in which
+    // case it starts at the oldest one still in the ring.
+    explicit SharedQuoteReader(const std::string& name, bool fromOldest = false);
+    ~SharedQuoteReader();
+
+    SharedQuoteReader(const SharedQuoteReader&) = delete;
+    SharedQuoteReader& operator=(const SharedQuoteReader&) = delete;
+
+    // Copies the next record; returns false if there is none yet
+    bool poll(QuoteRecord& quote) {
+        uint64_t published = header->publishedSequence.load(std::memory_order_acquire);
+        if (nextSequence > published) {
+            return false;
+        }
+        if (published - nextSequence >= ringCapacity) {
+            skipTo(published - ringCapacity + 1);
+        }
+        for (;;) {
+            const SharedQuoteSlot& slot = ring[nextSequence & ringMask];
+            uint64_t before = slot.sequence.load(std::memory_order_acquire);
+            if (before == nextSequence) {
+                std::memcpy(static_cast<void*>(&quote), &slot.record, sizeof(QuoteRecord));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_relaxed) == nextSequence) {
+                    lastReadSequence = nextSequence++;
+                    return true;
+                }
+            }
+            // Overwritten before or while it was copied: the publisher is a whole ring ahead
+            published = header->publishedSequence.load(std::memory_order_acquire);
+            if (published >= nextSequence + ringCapacity) {
+                skipTo(published - ringCapacity + 1);
+            }
+        }
+    }
+
+    // Sequence number of the record poll() returned last
+    uint64_t sequence() const { return lastReadSequence; }
+
+    // Records overwritten before this reader got to them, and how many times that happened
+    uint64_t lostCount() const { return lost; }
+    uint64_t gapCount() const { return gaps; }
+
+    // Newest record of symbolId; false if it has none yet or the id is out of range
+    bool latest(int32_t symbolId, QuoteRecord& quote, uint64_t* sequence = nullptr) const;
+
+    // Directory lookups; find() returns -1 for unknown symbols
+    int32_t find(std::string_view symbol) const;
+    std::string_view symbol(int32_t symbolId) const;
+    size_t symbolCount() const { return header->symbolCount.load(std::memory_order_acquire); }
+
+    uint64_t publishedSequence() const { return header->publishedSequence.load(std::memory_order_acquire); }
+    size_t capacity() const { return ringCapacity; }
+
+    // The publisher shut down cleanly, or its process is gone
+    bool closed() const;
+
+private:
+    void* mapping = nullptr;
+    size_t mappingSize = 0;
+    const SharedQuoteHeader* header = nullptr;
+    const SharedQuoteSlot* ring = nullptr;
+    const SharedLastValue* lastValues = nullptr;
+    const SharedSymbolName* directory = nullptr;
+    uint64_t ringCapacity = 0;
+    uint64_t ringMask = 0;
+    uint64_t nextSequence = 1;
+    uint64_t lastReadSequence = 0;
+    uint64_t lost = 0;
+    uint64_t gaps = 0;
+
+    void skipTo(uint64_t sequence) {
+        lost += sequence - nextSequence;
+        ++gaps;
+        nextSequence = sequence;
+    }
+};
+
+#endif // SHAREDQUOTEBUS_HPP
@@ -0,0 +1,87 @@
+#include "SnapshotClient.hpp"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+SnapshotClient::SnapshotClient(const std::string& path) {
+    sockaddr_un address{};
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Invalid snapshot socket path: " + path);
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throw std::runtime_error(std::string("socket failed: ") + std::strerror(errno));
+    }
+    if (::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        int error = errno;
+        ::close(fd);
+        throw std::runtime_error("Cannot connect to the snapshot daemon at " + path + ": " + std::strerror(error));
+    }
+}
+
+SnapshotClient::~SnapshotClient() {
+    ::close(fd);
+}
+
+void SnapshotClient::sendAll(const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t sent = ::send(fd, data, size, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent <= 0) {
+            throw std::runtime_error(std::string("Snapshot request failed: ") + std::strerror(errno));
+        }
+        data += sent;
+        size -= static_cast<size_t>(sent);
+    }
+}
+
+void SnapshotClient::receiveAll(char* data, size_t size) {
+    while (size > 0) {
+        ssize_t received = ::recv(fd, data, size, 0);
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received < 0) {
+            throw std::runtime_error(std::string("Snapshot response failed: ") + std::strerror(errno));
+        }
+        if (received == 0) {
+            throw std::runtime_error("The snapshot daemon closed the connection");
+        }
+        data += received;
+        size -= static_cast<size_t>(received);
+    }
+}
+
+void SnapshotClient::get(const std::vector<std::string>& symbols, uint32_t waitMicros,
+                         std::vector<SnapshotEntry>& entries) {
+    request.clear();
+    encodeSnapshotRequest(symbols, waitMicros, request);
+    sendAll(request.data(), request.size());
+
+    SnapshotResponseHeader header;
+    receiveAll(reinterpret_cast<char*>(&header), sizeof(header));
+    if (header.magic != kSnapshotMagic || header.count != symbols.size()) {
+        throw std::runtime_error("Unexpected snapshot response");
+    }
+    serverTimeNs = header.serverTimeNs;
+    entries.resize(header.count);
+    receiveAll(reinterpret_cast<char*>(entries.data()), entries.size() * sizeof(SnapshotEntry));
+}
+
+std::vector<SnapshotEntry> SnapshotClient::get(const std::vector<std::string>& symbols, uint32_t waitMicros) {
+    std::vector<SnapshotEntry> entries;
+    get(symbols, waitMicros, entries);
+    return entries;
+}
+
+SnapshotEntry SnapshotClient::getOne(const std::string& symbol, uint32_t waitMicros) {
+    return get(std::vector<std::string>{symbol}, waitMicros).front();
+}
@@ -0,0 +1,40 @@
+#ifndef SNAPSHOTCLIENT_HPP
+#define SNAPSHOTCLIENT_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SnapshotProtocol.hpp"
+
+// Blocking client of the snapshot daemon (main --serve PATH). Keeps one connection open, so a
+// lookup is a write and a read on a Unix socket: no login, no websocket, no subscription.
+// One thread at a time.
+class SnapshotClient {
+public:
+    // Throws std::runtime_error if nothing listens at path
+    explicit SnapshotClient(const std::string& path);
+    ~SnapshotClient();
+
+    SnapshotClient(const SnapshotClient&) = delete;
+    SnapshotClient& operator=(const SnapshotClient&) = delete;
+
+    // One entry per symbol, in order. Symbols the daemon does not track yet are subscribed and come
+    // back Pending unless their first quote arrives within waitMicros. Throws std::runtime_error if
+    // the daemon closed the connection or answered out of protocol.
+    void get(const std::vector<std::string>& symbols, uint32_t waitMicros, std::vector<SnapshotEntry>& entries);
+    std::vector<SnapshotEntry> get(const std::vector<std::string>& symbols, uint32_t waitMicros = 0);
+    SnapshotEntry getOne(const std::string& symbol, uint32_t waitMicros = 0);
+
+    // serverTimeNs of the last response (CLOCK_MONOTONIC on the daemon's host, which is this one)
+    int64_t lastServerTimeNs() const { return serverTimeNs; }
+
+private:
+    int fd = -1;
+    std::string request;
+    int64_t serverTimeNs = 0;
+
+    void sendAll(const char* data, size_t size);
+    void receiveAll(char* data, size_t size);
+};
+
+#endif // SNAPSHOTCLIENT_HPP
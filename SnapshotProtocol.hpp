@@ -0,0 +1,96 @@
+#ifndef SNAPSHOTPROTOCOL_HPP
+#define SNAPSHOTPROTOCOL_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Binary request/response format of the snapshot daemon (main --serve PATH), spoken over a Unix
+// socket. Both ends are on one host, so every field is in its (little-endian) byte order.
+//
+// Request:  SnapshotRequestHeader, then symbolCount symbols of a one-byte length and the name
+//           (bodyBytes in total).
+// Response: SnapshotResponseHeader, then one SnapshotEntry per requested symbol, in request order.
+//
+// A connection carries any number of request/response pairs, one at a time. A malformed request
+// closes the connection. python/px_snapshot_client.py mirrors these layouts.
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "The snapshot protocol is little-endian");
+
+constexpr uint32_t kSnapshotMagic = 0x31535850;    // "PXS1"
+constexpr uint16_t kSnapshotMaxSymbols = 4096;     // Per request
+constexpr size_t kSnapshotMaxSymbolLength = 255;
+
+struct SnapshotRequestHeader {
+    uint32_t magic;
+    uint16_t symbolCount;
+    uint16_t reserved;
+    // For symbols the daemon has no quote for yet: hold the response up to this long for their
+    // first quote (0: answer at once, with those symbols Pending)
+    uint32_t waitMicros;
+    uint32_t bodyBytes;
+};
+static_assert(sizeof(SnapshotRequestHeader) == 16, "Snapshot request header is 16 bytes on the wire");
+
+struct SnapshotResponseHeader {
+    uint32_t magic;
+    uint16_t count;
+    uint16_t reserved;
+    int64_t serverTimeNs;           // CLOCK_MONOTONIC when the response was built
+};
+static_assert(sizeof(SnapshotResponseHeader) == 16, "Snapshot response header is 16 bytes on the wire");
+
+enum class SnapshotStatus : uint8_t {
+    Ok = 0,                         // Quoted; the fields below are the newest quote
+    Pending = 1,                    // Subscribed (possibly by this request) but not quoted yet
+    Unavailable = 2,                // Cannot be tracked: the daemon's quote book is full
+};
+
+struct SnapshotEntry {
+    SnapshotStatus status;
+    uint8_t reserved[7];
+    double bidPrice;
+    double askPrice;
+    double bidSize;
+    double askSize;
+    int64_t ageNs;                  // serverTimeNs minus the quote's receive time
+    uint64_t updateCount;           // Quotes received for the symbol so far
+
+    bool ok() const { return status == SnapshotStatus::Ok; }
+    double midPrice() const { return (bidPrice + askPrice) / 2; }
+};
+static_assert(sizeof(SnapshotEntry) == 56, "Snapshot entry is 56 bytes on the wire");
+
+inline const char* snapshotStatusName(SnapshotStatus status) {
+    switch (status) {
+        case SnapshotStatus::Ok: return "ok";
+        case SnapshotStatus::Pending: return "pending";
+        case SnapshotStatus::Unavailable: return "unavailable";
+    }
+    return "unknown";
+}
+
+// Appends a complete request for symbols to out. Throws std::runtime_error for an empty list, more
+// than kSnapshotMaxSymbols symbols or a name that is empty or longer than kSnapshotMaxSymbolLength.
+inline void encodeSnapshotRequest(const std::vector<std::string>& symbols, uint32_t waitMicros, std::string& out) {
+    if (symbols.empty() || symbols.size() > kSnapshotMaxSymbols) {
+        throw std::runtime_error("A snapshot request takes 1 to " + std::to_string(kSnapshotMaxSymbols) + " symbols");
+    }
+    SnapshotRequestHeader header{kSnapshotMagic, static_cast<uint16_t>(symbols.size()), 0, waitMicros, 0};
+    for (const auto& symbol : symbols) {
+        if (symbol.empty() || symbol.size() > kSnapshotMaxSymbolLength) {
+            throw std::runtime_error("Invalid symbol for a snapshot request: '" + symbol + "'");
+        }
+        header.bodyBytes += static_cast<uint32_t>(1 + symbol.size());
+    }
+    size_t start = out.size();
+    out.resize(start + sizeof(header));
+    std::memcpy(&out[start], &header, sizeof(header));
+    for (const auto& symbol : symbols) {
+        out += static_cast<char>(symbol.size());
+        out += symbol;
+    }
+}
+
+#endif // SNAPSHOTPROTOCOL_HPP
@@ -0,0 +1,195 @@
+#include "SnapshotServer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <boost/asio/read.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/write.hpp>
+#include "MonotonicClock.hpp"
+#include "SnapshotProtocol.hpp"
+
+using boost::asio::local::stream_protocol;
+
+namespace {
+
+// How often a held request looks for the first quote of its pending symbols
+constexpr int64_t kPendingPollNs = 200000;
+
+} // namespace
+
+struct SnapshotServer::Connection {
+    explicit Connection(stream_protocol::socket connected)
+        : socket(std::move(connected)), timer(socket.get_executor()) {}
+
+    stream_protocol::socket socket;
+    boost::asio::steady_timer timer;
+    SnapshotRequestHeader header{};
+    std::string body;
+    std::vector<std::string_view> symbols; // Into body
+    std::vector<int32_t> ids;
+    std::string response;
+    int64_t deadlineNs = 0;
+};
+
+SnapshotServer::SnapshotServer(const std::string& path, const QuoteBook& quoteBook, Subscribe subscribeSymbols)
+    : acceptor(ioc), socketPath(path), book(quoteBook), subscribe(std::move(subscribeSymbols)) {
+    if (socketPath.empty()) {
+        throw std::runtime_error("Empty snapshot socket path");
+    }
+    // Left behind by a previous run that did not exit cleanly; anything else at path is kept
+    struct stat existing;
+    if (::lstat(socketPath.c_str(), &existing) == 0 && S_ISSOCK(existing.st_mode)) {
+        ::unlink(socketPath.c_str());
+    }
+    try {
+        stream_protocol::endpoint endpoint(socketPath);
+        acceptor.open(endpoint.protocol());
+        acceptor.bind(endpoint);
+        acceptor.listen();
+    } catch (const boost::system::system_error& e) {
+        throw std::runtime_error("Cannot serve snapshots on " + socketPath + ": " + e.code().message());
+    }
+    accept();
+    thread = std::thread([this] { ioc.run(); });
+}
+
+SnapshotServer::~SnapshotServer() {
+    ioc.stop();
+    thread.join();
+    ::unlink(socketPath.c_str());
+}
+
+SnapshotServer::Stats SnapshotServer::stats() const {
+    return {requestCount.load(std::memory_order_relaxed), symbolCount.load(std::memory_order_relaxed),
+            subscribeCount.load(std::memory_order_relaxed), rejectCount.load(std::memory_order_relaxed)};
+}
+
+void SnapshotServer::accept() {
+    acceptor.async_accept([this](const boost::system::error_code& ec, stream_protocol::socket socket) {
+        if (!ec) {
+            readHeader(std::make_shared<Connection>(std::move(socket)));
+        }
+        if (ec != boost::asio::error::operation_aborted) {
+            accept();
+        }
+    });
+}
+
+void SnapshotServer::readHeader(std::shared_ptr<Connection> connection) {
+    boost::asio::async_read(connection->socket, boost::asio::buffer(&connection->header, sizeof(SnapshotRequestHeader)),
+                            [this, connection](const boost::system::error_code& ec, size_t) {
+        if (ec) {
+            return; // Client went away
+        }
+        const SnapshotRequestHeader& header = connection->header;
+        if (header.magic != kSnapshotMagic || header.symbolCount == 0 || header.symbolCount > kSnapshotMaxSymbols ||
+            header.bodyBytes > header.symbolCount * (1 + kSnapshotMaxSymbolLength)) {
+            rejectCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        readBody(connection);
+    });
+}
+
+void SnapshotServer::readBody(std::shared_ptr<Connection> connection) {
+    connection->body.resize(connection->header.bodyBytes);
+    boost::asio::async_read(connection->socket, boost::asio::buffer(connection->body),
+                            [this, connection](const boost::system::error_code& ec, size_t) {
+        if (ec) {
+            return;
+        }
+        // symbolCount length-prefixed names that fill the body exactly
+        std::string_view body = connection->body;
+        auto& symbols = connection->symbols;
+        symbols.clear();
+        size_t offset = 0;
+        while (offset < body.size() && symbols.size() < connection->header.symbolCount) {
+            size_t length = static_cast<uint8_t>(body[offset]);
+            if (length == 0 || offset + 1 + length > body.size()) {
+                break;
+            }
+            symbols.push_back(body.substr(offset + 1, length));
+            offset += 1 + length;
+        }
+        if (offset != body.size() || symbols.size() != connection->header.symbolCount) {
+            rejectCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        connection->ids.assign(symbols.size(), QuoteBook::kNotFound);
+        connection->deadlineNs = monotonicNowNs() + static_cast<int64_t>(connection->header.waitMicros) * 1000;
+        resolve(connection);
+    });
+}
+
+bool SnapshotServer::lookUp(Connection& connection) {
+    int64_t nowNs = monotonicNowNs();
+    auto& response = connection.response;
+    response.resize(sizeof(SnapshotResponseHeader) + connection.symbols.size() * sizeof(SnapshotEntry));
+    SnapshotResponseHeader header{kSnapshotMagic, static_cast<uint16_t>(connection.symbols.size()), 0, nowNs};
+    std::memcpy(&response[0], &header, sizeof(header));
+
+    std::vector<std::string> missing;
+    bool complete = true;
+    for (size_t i = 0; i < connection.symbols.size(); ++i) {
+        SnapshotEntry entry{};
+        entry.ageNs = -1;
+        int32_t& id = connection.ids[i];
+        if (id == QuoteBook::kNotFound) {
+            id = book.find(connection.symbols[i]);
+        }
+        QuoteSnapshot snapshot;
+        if (id != QuoteBook::kNotFound && book.read(id, snapshot)) {
+            entry.status = SnapshotStatus::Ok;
+            entry.bidPrice = snapshot.bidPrice;
+            entry.askPrice = snapshot.askPrice;
+            entry.bidSize = snapshot.bidSize;
+            entry.askSize = snapshot.askSize;
+            entry.ageNs = nowNs - snapshot.receiveTimeNs;
+            entry.updateCount = snapshot.updateCount;
+        } else if (id == QuoteBook::kNotFound && book.size() >= book.capacity()) {
+            entry.status = SnapshotStatus::Unavailable;
+        } else {
+            // Subscribed once per daemon; until the feed thread interns it, find() keeps missing
+            if (id == QuoteBook::kNotFound && subscribedSymbols.emplace(connection.symbols[i]).second) {
+                missing.emplace_back(connection.symbols[i]);
+            }
+            entry.status = SnapshotStatus::Pending;
+            complete = false;
+        }
+        std::memcpy(&response[sizeof(SnapshotResponseHeader) + i * sizeof(SnapshotEntry)], &entry, sizeof(entry));
+    }
+    if (!missing.empty()) {
+        subscribeCount.fetch_add(missing.size(), std::memory_order_relaxed);
+        subscribe(missing);
+    }
+    return complete;
+}
+
+void SnapshotServer::resolve(std::shared_ptr<Connection> connection) {
+    int64_t remainingNs = connection->deadlineNs - monotonicNowNs();
+    if (lookUp(*connection) || remainingNs <= 0) {
+        respond(connection);
+        return;
+    }
+    connection->timer.expires_after(std::chrono::nanoseconds(std::min(remainingNs, kPendingPollNs)));
+    connection->timer.async_wait([this, connection](const boost::system::error_code& ec) {
+        if (!ec) {
+            resolve(connection);
+        }
+    });
+}
+
+void SnapshotServer::respond(std::shared_ptr<Connection> connection) {
+    requestCount.fetch_add(1, std::memory_order_relaxed);
+    symbolCount.fetch_add(connection->symbols.size(), std::memory_order_relaxed);
+    boost::asio::async_write(connection->socket, boost::asio::buffer(connection->response),
+                             [this, connection](const boost::system::error_code& ec, size_t) {
+        if (!ec) {
+            readHeader(connection);
+        }
+    });
+}
@@ -0,0 +1,70 @@
+#ifndef SNAPSHOTSERVER_HPP
+#define SNAPSHOTSERVER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include "QuoteBook.hpp"
+
+// Answers snapshot requests (SnapshotProtocol.hpp) from a live QuoteBook over a Unix socket, on its
+// own thread: each symbol is a seqlock read of its book slot, so a warm request never waits on the
+// feed. A symbol the book does not track yet is handed to subscribe once and reported Pending; a
+// request may ask to be held until such symbols have their first quote.
+class SnapshotServer {
+public:
+    // Called on the server thread with symbols missing from the book. It must intern them into the
+    // book and subscribe them (MarketDataWebSocket::addSymbols does both on the feed thread).
+    using Subscribe = std::function<void(const std::vector<std::string>&)>;
+
+    struct Stats {
+        uint64_t requests;
+        uint64_t symbols;           // Entries answered
+        uint64_t subscribed;        // Symbols passed to subscribe
+        uint64_t rejected;          // Malformed requests (their connection was closed)
+    };
+
+    // book must outlive the server. A socket left at path by an earlier run is replaced. Throws
+    // std::runtime_error if it cannot listen.
+    SnapshotServer(const std::string& path, const QuoteBook& book, Subscribe subscribe);
+    ~SnapshotServer();
+
+    SnapshotServer(const SnapshotServer&) = delete;
+    SnapshotServer& operator=(const SnapshotServer&) = delete;
+
+    const std::string& path() const { return socketPath; }
+
+    // Readable from any thread
+    Stats stats() const;
+
+private:
+    struct Connection;
+
+    boost::asio::io_context ioc;
+    boost::asio::local::stream_protocol::acceptor acceptor;
+    std::string socketPath;
+    const QuoteBook& book;
+    Subscribe subscribe;
+    std::unordered_set<std::string> subscribedSymbols; // Server thread only
+    std::thread thread;
+
+    std::atomic<uint64_t> requestCount{0};
+    std::atomic<uint64_t> symbolCount{0};
+    std::atomic<uint64_t> subscribeCount{0};
+    std::atomic<uint64_t> rejectCount{0};
+
+    void accept();
+    void readHeader(std::shared_ptr<Connection> connection);
+    void readBody(std::shared_ptr<Connection> connection);
+    void resolve(std::shared_ptr<Connection> connection);
+    void respond(std::shared_ptr<Connection> connection);
+    bool lookUp(Connection& connection);
+};
+
+#endif // SNAPSHOTSERVER_HPP
@@ -0,0 +1,85 @@
+#include "SocketTuning.hpp"
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#ifdef __linux__
+#include <linux/net_tstamp.h>
+#endif
+#include "MonotonicClock.hpp"
+
+namespace {
+
+// Software receive stamps are CLOCK_REALTIME; shift them onto the steady clock the rest of the
+// code measures with. Sampled per read, so clock steps between reads do not accumulate.
+int64_t realtimeToMonotonicNs(const timespec& stamp) {
+    int64_t monotonicNs = monotonicNowNs();
+    int64_t realtimeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    int64_t stampNs = static_cast<int64_t>(stamp.tv_sec) * 1000000000 + stamp.tv_nsec;
+    return stampNs - (realtimeNs - monotonicNs);
+}
+
+} // namespace
+
+AppliedSocketTuning applySocketTuning(int fd, const SocketTuning& tuning) {
+    AppliedSocketTuning applied;
+    if (tuning.noDelay) {
+        int on = 1;
+        applied.noDelay = ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on)) == 0;
+    }
+    if (tuning.receiveBufferBytes > 0) {
+        int bytes = tuning.receiveBufferBytes;
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &bytes, sizeof(bytes));
+    }
+    socklen_t length = sizeof(applied.receiveBufferBytes);
+    ::getsockopt(fd, SOL_SOCKET, SO_RCVBUF, &applied.receiveBufferBytes, &length);
+#ifdef SO_TIMESTAMPING
+    if (tuning.receiveTimestamps) {
+        int flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+        applied.receiveTimestamps = ::setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) == 0;
+    }
+#endif
+#ifdef SO_BUSY_POLL
+    if (tuning.busyPollMicros > 0) {
+        int micros = tuning.busyPollMicros;
+        ::setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &micros, sizeof(micros));
+    }
+    length = sizeof(applied.busyPollMicros);
+    ::getsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &applied.busyPollMicros, &length);
+#endif
+    return applied;
+}
+
+ptrdiff_t receiveWithTimestamp(int fd, iovec* iov, size_t iovCount, int64_t* kernelReceiveNs) {
+    alignas(cmsghdr) char control[CMSG_SPACE(3 * sizeof(timespec))];
+    msghdr message{};
+    message.msg_iov = iov;
+    message.msg_iovlen = iovCount;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+
+    ssize_t received;
+    do {
+        received = ::recvmsg(fd, &message, MSG_DONTWAIT);
+    } while (received < 0 && errno == EINTR);
+    if (received <= 0) {
+        return received;
+    }
+#ifdef SO_TIMESTAMPING
+    for (cmsghdr* header = CMSG_FIRSTHDR(&message); header != nullptr; header = CMSG_NXTHDR(&message, header)) {
+        if (header->cmsg_level == SOL_SOCKET && header->cmsg_type == SO_TIMESTAMPING) {
+            // scm_timestamping: [0] software, [1] deprecated, [2] hardware
+            timespec stamps[3];
+            std::memcpy(stamps, CMSG_DATA(header), sizeof(stamps));
+            if (stamps[0].tv_sec != 0 || stamps[0].tv_nsec != 0) {
+                *kernelReceiveNs = realtimeToMonotonicNs(stamps[0]);
+            }
+        }
+    }
+#endif
+    return received;
+}
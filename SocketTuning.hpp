@@ -0,0 +1,40 @@
+#ifndef SOCKETTUNING_HPP
+#define SOCKETTUNING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <sys/uio.h>
+
+// Options for the TCP socket under a TLS stream, applied once it is connected. The window scale is
+// negotiated in the SYN from the rmem limits, so a larger SO_RCVBUF set afterwards still takes effect.
+struct SocketTuning {
+    bool noDelay = true;                    // TCP_NODELAY: AUTH, subscriptions and keepalives go out at once
+    // SO_RCVBUF (the kernel doubles it and caps it at rmem_max). 0 keeps receive autotuning, which a
+    // fixed size turns off; a large fixed buffer lets a fast sender queue milliseconds of stale data.
+    int receiveBufferBytes = 0;
+    bool receiveTimestamps = true;          // SO_TIMESTAMPING software receive stamps (see receiveWithTimestamp)
+    // SO_BUSY_POLL: a read that finds the socket empty polls the NIC queue for up to this long
+    // instead of waiting for the interrupt. Raising it above net.core.busy_read needs CAP_NET_ADMIN.
+    // Devices without NAPI polling (loopback) ignore it. 0 leaves the system default.
+    int busyPollMicros = 0;
+};
+
+// What the kernel actually granted
+struct AppliedSocketTuning {
+    bool noDelay = false;
+    int receiveBufferBytes = 0;             // SO_RCVBUF as read back
+    bool receiveTimestamps = false;
+    int busyPollMicros = 0;                 // SO_BUSY_POLL as read back
+};
+
+// Applies tuning to a connected TCP socket. Options the kernel refuses are left off and show up
+// as such in the result; nothing throws.
+AppliedSocketTuning applySocketTuning(int fd, const SocketTuning& tuning);
+
+// Non-blocking recvmsg into iov. Returns the byte count (0 at end of stream), or -1 with errno set
+// (EAGAIN when nothing is queued). If the socket has receive timestamps on, *kernelReceiveNs gets
+// the kernel's receive time of the newest segment read, on the monotonicNowNs() scale; it is left
+// alone otherwise.
+ptrdiff_t receiveWithTimestamp(int fd, iovec* iov, size_t iovCount, int64_t* kernelReceiveNs);
+
+#endif // SOCKETTUNING_HPP
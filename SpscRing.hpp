@@ -0,0 +1,117 @@
+#ifndef SPSCRING_HPP
+#define SPSCRING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+constexpr size_t kCacheLineSize = 64;
+
+// Bounded lock-free single-producer/single-consumer ring. Capacity is rounded up to a power of two.
+// The producer and consumer indices live on separate cache lines, and each side keeps a cached copy
+// of the other side's index so the shared line is only touched when the cached view runs out.
+template <typename T>
+class SpscRing {
+    static_assert(std::is_trivially_copyable<T>::value, "SpscRing holds fixed-size, trivially copyable records");
+
+public:
+    explicit SpscRing(size_t requestedCapacity)
+        : mask(roundUpToPowerOfTwo(requestedCapacity) - 1), slots(new T[mask + 1]) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Producer side. Returns false if the ring is full.
+    bool tryPush(const T& item) {
+        const size_t tail = producer.tail.load(std::memory_order_relaxed);
+        if (tail - producer.cachedHead > mask) {
+            producer.cachedHead = consumer.head.load(std::memory_order_acquire);
+            if (tail - producer.cachedHead > mask) {
+                return false;
+            }
+        }
+        slots[tail & mask] = item;
+        producer.tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Producer side. Lets fill write the next slot in place instead of copying a finished record in;
+    // returns false (without calling fill) if the ring is full.
+    template <typename Fill>
+    bool tryPushWith(Fill&& fill) {
+        const size_t tail = producer.tail.load(std::memory_order_relaxed);
+        if (tail - producer.cachedHead > mask) {
+            producer.cachedHead = consumer.head.load(std::memory_order_acquire);
+            if (tail - producer.cachedHead > mask) {
+                return false;
+            }
+        }
+        fill(slots[tail & mask]);
+        producer.tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Returns false if the ring is empty.
+    bool tryPop(T& item) {
+        const size_t head = consumer.head.load(std::memory_order_relaxed);
+        if (head == consumer.cachedTail) {
+            consumer.cachedTail = producer.tail.load(std::memory_order_acquire);
+            if (head == consumer.cachedTail) {
+                return false;
+            }
+        }
+        item = slots[head & mask];
+        consumer.head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Hands up to maxItems records to fn in place and releases them with one store.
+    template <typename Fn>
+    size_t popBatch(Fn&& fn, size_t maxItems) {
+        const size_t head = consumer.head.load(std::memory_order_relaxed);
+        consumer.cachedTail = producer.tail.load(std::memory_order_acquire);
+        size_t available = consumer.cachedTail - head;
+        size_t count = available < maxItems ? available : maxItems;
+        for (size_t i = 0; i < count; ++i) {
+            fn(static_cast<const T&>(slots[(head + i) & mask]));
+        }
+        if (count > 0) {
+            consumer.head.store(head + count, std::memory_order_release);
+        }
+        return count;
+    }
+
+    size_t capacity() const { return mask + 1; }
+
+    // Approximate when called concurrently with the other side
+    size_t size() const {
+        return producer.tail.load(std::memory_order_acquire) - consumer.head.load(std::memory_order_acquire);
+    }
+
+private:
+    struct alignas(kCacheLineSize) ProducerIndex {
+        std::atomic<size_t> tail{0};
+        size_t cachedHead = 0;
+    };
+
+    struct alignas(kCacheLineSize) ConsumerIndex {
+        std::atomic<size_t> head{0};
+        size_t cachedTail = 0;
+    };
+
+    static size_t roundUpToPowerOfTwo(size_t value) {
+        size_t capacity = 2;
+        while (capacity < value) {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+    alignas(kCacheLineSize) const size_t mask;
+    const std::unique_ptr<T[]> slots;
+    ProducerIndex producer;
+    ConsumerIndex consumer;
+};
+
+#endif // SPSCRING_HPP
@@ -0,0 +1,239 @@
+#include "SubscriptionManager.hpp"
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+// Smallest budget that still fits the frame envelope and a typical entry
+constexpr size_t kMinFrameBytes = 256;
+
+void appendJsonString(std::string& out, std::string_view text) {
+    out += '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+            out += escaped;
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+} // namespace
+
+SubscriptionManager::SubscriptionManager(QuoteBook& book, SessionTimeline& timeline, int64_t channel,
+                                         size_t maxFrameBytes)
+    : quoteBook(&book), sessionTimeline(timeline), channelNumber(channel),
+      frameBudget(std::max(maxFrameBytes, kMinFrameBytes)) {}
+
+void SubscriptionManager::setBook(QuoteBook& book) {
+    quoteBook = &book;
+    states.clear();
+    entries.clear();
+    pendingAdds.clear();
+    pendingRemoves.clear();
+    resetFrames.clear();
+    resetFramesValid = false;
+    coverageStartNs = 0;
+    subscribedCount.store(0, std::memory_order_relaxed);
+    setLive(0);
+}
+
+void SubscriptionManager::setMaxFrameBytes(size_t bytes) {
+    frameBudget = std::max(bytes, kMinFrameBytes);
+    resetFramesValid = false;
+}
+
+void SubscriptionManager::setEventTypes(EventTypeSet types) {
+    subscribedTypes = types | eventTypeBit(EventType::Quote);
+    entries.clear();
+    resetFramesValid = false;
+}
+
+SubscriptionManager::State& SubscriptionManager::state(int32_t id) {
+    size_t index = static_cast<size_t>(id);
+    if (index >= states.size()) {
+        states.resize(std::max(index + 1, quoteBook->size()), State::Unsubscribed);
+    }
+    return states[index];
+}
+
+const std::string& SubscriptionManager::entry(int32_t id) {
+    size_t index = static_cast<size_t>(id);
+    if (index >= entries.size()) {
+        entries.resize(std::max(index + 1, quoteBook->size()));
+    }
+    std::string& text = entries[index];
+    if (text.empty()) {
+        // One entry per event type; they always travel in the same frame
+        forEachEventSchema([&](auto schema) {
+            if ((subscribedTypes & eventTypeBit(decltype(schema)::type)) == 0) {
+                return;
+            }
+            if (!text.empty()) {
+                text += ',';
+            }
+            text += "{\"type\":\"";
+            text += decltype(schema)::name;
+            text += "\",\"symbol\":";
+            appendJsonString(text, quoteBook->symbol(id));
+            text += '}';
+        });
+    }
+    return text;
+}
+
+bool SubscriptionManager::add(int32_t id) {
+    if (id < 0 || static_cast<size_t>(id) >= quoteBook->size()) {
+        return false;
+    }
+    State& current = state(id);
+    if (current == State::Unsubscribed) {
+        current = State::PendingAdd;
+        pendingAdds.push_back(id);
+    } else if (current == State::PendingRemove) {
+        // The server still has it; the stale pendingRemoves entry is skipped
+        current = State::Sent;
+    } else {
+        return false;
+    }
+    subscribedCount.fetch_add(1, std::memory_order_relaxed);
+    resetFramesValid = false;
+    return true;
+}
+
+bool SubscriptionManager::remove(int32_t id) {
+    if (id < 0 || static_cast<size_t>(id) >= states.size()) {
+        return false;
+    }
+    State& current = states[static_cast<size_t>(id)];
+    if (current == State::PendingAdd) {
+        current = State::Unsubscribed;
+    } else if (current == State::Sent || current == State::Live) {
+        if (current == State::Live) {
+            setLive(liveCount.load(std::memory_order_relaxed) - 1);
+        }
+        current = State::PendingRemove;
+        pendingRemoves.push_back(id);
+    } else {
+        return false;
+    }
+    subscribedCount.fetch_sub(1, std::memory_order_relaxed);
+    resetFramesValid = false;
+    return true;
+}
+
+const std::vector<std::string>& SubscriptionManager::resubscribeAll(int64_t nowNs) {
+    // A fresh channel has no subscriptions, so everything wanted goes out again and nothing is live
+    std::vector<int32_t> ids;
+    ids.reserve(subscribedCount.load(std::memory_order_relaxed));
+    for (size_t i = 0; i < states.size(); ++i) {
+        State& current = states[i];
+        if (current == State::PendingRemove) {
+            current = State::Unsubscribed;
+        } else if (current != State::Unsubscribed) {
+            current = State::Sent;
+            ids.push_back(static_cast<int32_t>(i));
+        }
+    }
+    pendingAdds.clear();
+    pendingRemoves.clear();
+    setLive(0);
+
+    if (!resetFramesValid) {
+        resetFrames.clear();
+        buildFrames(resetFrames, "add", ids, true);
+        resetFramesValid = true;
+    }
+    framesBuilt.fetch_add(resetFrames.size(), std::memory_order_relaxed);
+    coverageStartNs = 0;
+    if (!ids.empty()) {
+        startCoverage(nowNs);
+    }
+    return resetFrames;
+}
+
+std::vector<std::string> SubscriptionManager::takePending(int64_t nowNs) {
+    std::vector<int32_t> removes;
+    for (int32_t id : pendingRemoves) {
+        State& current = states[static_cast<size_t>(id)];
+        if (current == State::PendingRemove) {
+            current = State::Unsubscribed;
+            removes.push_back(id);
+        }
+    }
+    std::vector<int32_t> adds;
+    for (int32_t id : pendingAdds) {
+        State& current = states[static_cast<size_t>(id)];
+        if (current == State::PendingAdd) {
+            current = State::Sent;
+            adds.push_back(id);
+        }
+    }
+    pendingRemoves.clear();
+    pendingAdds.clear();
+
+    std::vector<std::string> frames;
+    buildFrames(frames, "remove", removes, false);
+    buildFrames(frames, "add", adds, false);
+    framesBuilt.fetch_add(frames.size(), std::memory_order_relaxed);
+    if (!adds.empty()) {
+        startCoverage(nowNs);
+    } else if (coverageStartNs != 0 && fullyLive()) {
+        // Removing the last silent symbols completes coverage too
+        sessionTimeline.record(SessionStage::SubscriptionToFullCoverage, coverageStartNs, nowNs);
+        coverageStartNs = 0;
+    }
+    return frames;
+}
+
+void SubscriptionManager::buildFrames(std::vector<std::string>& frames, const char* key,
+                                      const std::vector<int32_t>& ids, bool reset) {
+    std::string prefix = "{\"type\":\"FEED_SUBSCRIPTION\",\"channel\":" + std::to_string(channelNumber);
+    if (reset) {
+        prefix += ",\"reset\":true";
+    }
+    if (ids.empty()) {
+        if (reset) {
+            frames.push_back(prefix + "}");
+        }
+        return;
+    }
+    prefix += ",\"";
+    prefix += key;
+    prefix += "\":[";
+    const std::string continuation = "{\"type\":\"FEED_SUBSCRIPTION\",\"channel\":" + std::to_string(channelNumber) +
+                                     ",\"" + key + "\":[";
+
+    std::string frame = prefix;
+    size_t inFrame = 0;
+    for (int32_t id : ids) {
+        const std::string& text = entry(id);
+        // Close the frame if this entry would push it over the budget ("]}" included)
+        if (inFrame > 0 && frame.size() + 1 + text.size() + 2 > frameBudget) {
+            frame += "]}";
+            frames.push_back(std::move(frame));
+            frame = continuation;
+            inFrame = 0;
+        }
+        if (inFrame > 0) {
+            frame += ',';
+        }
+        frame += text;
+        ++inFrame;
+    }
+    frame += "]}";
+    frames.push_back(std::move(frame));
+}
+
+void SubscriptionManager::startCoverage(int64_t nowNs) {
+    // With changes still in flight the stage runs from the oldest one
+    if (coverageStartNs == 0) {
+        coverageStartNs = nowNs;
+    }
+}
@@ -0,0 +1,124 @@
+#ifndef SUBSCRIPTIONMANAGER_HPP
+#define SUBSCRIPTIONMANAGER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "EventSchema.hpp"
+#include "QuoteBook.hpp"
+#include "SessionTimeline.hpp"
+
+// Live count of one connection's subscription, readable from any thread
+struct SubscriptionCoverage {
+    size_t subscribed;      // Symbols we want quotes for
+    size_t live;            // Of those, symbols quoted since their FEED_SUBSCRIPTION went out
+    uint64_t framesSent;    // FEED_SUBSCRIPTION frames built so far
+};
+
+// The FEED_SUBSCRIPTION state of one dxLink channel, keyed by QuoteBook symbol id. Symbols are added
+// and removed as diffs at any time; the outbound frames are built from entries serialized once per
+// symbol and split so that no frame exceeds maxFrameBytes. A symbol counts as live once a quote for
+// it arrives after its subscription was sent, and the SubscriptionToFullCoverage stage is recorded
+// whenever every subscribed symbol is live again after a change. Every symbol is subscribed to the
+// same set of event types; liveness is judged by its quotes.
+//
+// Everything except coverage() belongs to the connection's event-loop thread.
+class SubscriptionManager {
+public:
+    static constexpr size_t kDefaultMaxFrameBytes = 64 * 1024;
+
+    SubscriptionManager(QuoteBook& book, SessionTimeline& timeline, int64_t channel,
+                        size_t maxFrameBytes = kDefaultMaxFrameBytes);
+
+    // Drops every subscription and starts over on another book (ids are per book)
+    void setBook(QuoteBook& book);
+
+    void setMaxFrameBytes(size_t bytes);
+    size_t maxFrameBytes() const { return frameBudget; }
+
+    // Event types each symbol is subscribed to (Quote is always included). Set it before the first
+    // frames go out: symbols already on the server are not re-sent for added or dropped types.
+    void setEventTypes(EventTypeSet types);
+    EventTypeSet eventTypes() const { return subscribedTypes; }
+
+    // Queue a subscribe/unsubscribe. Unknown ids and no-ops are ignored; returns false if ignored.
+    bool add(int32_t id);
+    bool remove(int32_t id);
+
+    // Frames for a channel that has just been configured: reset, then every subscribed symbol.
+    // The frames are cached until the next add() or remove(), so reconnects reuse them.
+    const std::vector<std::string>& resubscribeAll(int64_t nowNs);
+
+    // Frames for the adds and removes queued since the last call; empty if there are none
+    std::vector<std::string> takePending(int64_t nowNs);
+
+    bool hasPending() const { return !pendingAdds.empty() || !pendingRemoves.empty(); }
+
+    // FeedProcessor calls this for every quote of a known symbol; returns true on its first quote
+    bool onQuote(int32_t id, int64_t receiveTimeNs) {
+        if (static_cast<size_t>(id) >= states.size() || states[static_cast<size_t>(id)] != State::Sent) {
+            return false;
+        }
+        states[static_cast<size_t>(id)] = State::Live;
+        size_t live = liveCount.load(std::memory_order_relaxed) + 1;
+        liveCount.store(live, std::memory_order_relaxed);
+        if (live == subscribedCount.load(std::memory_order_relaxed) && coverageStartNs != 0) {
+            sessionTimeline.record(SessionStage::SubscriptionToFullCoverage, coverageStartNs, receiveTimeNs);
+            coverageStartNs = 0;
+        }
+        return true;
+    }
+
+    // Every subscribed symbol has quoted (and there is at least one)
+    bool fullyLive() const {
+        size_t subscribed = subscribedCount.load(std::memory_order_relaxed);
+        return subscribed != 0 && liveCount.load(std::memory_order_relaxed) == subscribed;
+    }
+
+    SubscriptionCoverage coverage() const {
+        return SubscriptionCoverage{subscribedCount.load(std::memory_order_relaxed),
+                                    liveCount.load(std::memory_order_relaxed),
+                                    framesBuilt.load(std::memory_order_relaxed)};
+    }
+
+private:
+    enum class State : uint8_t {
+        Unsubscribed,
+        PendingAdd,     // Wanted, not sent on this connection yet
+        Sent,           // Subscribed, waiting for the first quote
+        Live,           // Subscribed and quoted
+        PendingRemove   // Not wanted any more, remove not sent yet
+    };
+
+    QuoteBook* quoteBook;
+    SessionTimeline& sessionTimeline;
+    int64_t channelNumber;
+    size_t frameBudget;
+    EventTypeSet subscribedTypes = eventTypeBit(EventType::Quote);
+
+    std::vector<State> states;          // Per book id, grown on demand
+    std::vector<std::string> entries;   // Per book id: {"type":"Quote","symbol":"..."} per event type, built on first use
+    std::vector<int32_t> pendingAdds;   // May hold stale ids; the state decides
+    std::vector<int32_t> pendingRemoves;
+
+    std::vector<std::string> resetFrames;
+    bool resetFramesValid = false;
+    int64_t coverageStartNs = 0;
+
+    std::atomic<size_t> subscribedCount{0};
+    std::atomic<size_t> liveCount{0};
+    std::atomic<uint64_t> framesBuilt{0};
+
+    State& state(int32_t id);
+    const std::string& entry(int32_t id);
+    void setLive(size_t live) { liveCount.store(live, std::memory_order_relaxed); }
+
+    // Appends frames carrying ids under key ("add" or "remove"); the first one carries reset if asked
+    void buildFrames(std::vector<std::string>& frames, const char* key, const std::vector<int32_t>& ids,
+                     bool reset);
+    void startCoverage(int64_t nowNs);
+};
+
+#endif // SUBSCRIPTIONMANAGER_HPP
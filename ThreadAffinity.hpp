@@ -0,0 +1,109 @@
+#ifndef THREADAFFINITY_HPP
+#define THREADAFFINITY_HPP
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Pins the calling thread to the index-th CPU it is allowed to run on (wrapping around), so shard
+// threads spread over the CPUs of the process's cpuset. Returns false if pinning is unsupported or
+// refused; the thread then keeps running unpinned.
+inline bool pinCurrentThread(int index) {
+#ifdef __linux__
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (index < 0 || sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return false;
+    }
+    int allowedCount = CPU_COUNT(&allowed);
+    if (allowedCount == 0) {
+        return false;
+    }
+    int target = index % allowedCount;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &allowed) && target-- == 0) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+        }
+    }
+    return false;
+#else
+    (void)index;
+    return false;
+#endif
+}
+
+// Pins the calling thread to one CPU by its kernel number (e.g. a core set aside with isolcpus),
+// not by its position in the allowed set. Returns false if the CPU does not exist or is refused.
+inline bool pinCurrentThreadToCpu(int cpu) {
+#ifdef __linux__
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+// Pins the calling thread to cpu (pinCurrentThreadToCpu) for the lifetime of the object and puts
+// the thread's previous mask back on destruction. Must be destroyed on the thread that created it.
+class ScopedCpuPin {
+public:
+    explicit ScopedCpuPin(int cpu) {
+#ifdef __linux__
+        CPU_ZERO(&previous);
+        pinnedNow = pthread_getaffinity_np(pthread_self(), sizeof(previous), &previous) == 0 &&
+                    pinCurrentThreadToCpu(cpu);
+#else
+        (void)cpu;
+#endif
+    }
+    ~ScopedCpuPin() {
+#ifdef __linux__
+        if (pinnedNow) {
+            pthread_setaffinity_np(pthread_self(), sizeof(previous), &previous);
+        }
+#endif
+    }
+    ScopedCpuPin(const ScopedCpuPin&) = delete;
+    ScopedCpuPin& operator=(const ScopedCpuPin&) = delete;
+
+    bool pinned() const { return pinnedNow; }
+
+private:
+#ifdef __linux__
+    cpu_set_t previous;
+#endif
+    bool pinnedNow = false;
+};
+
+// Takes cpu out of the calling thread's affinity mask. Threads started afterwards inherit the mask,
+// so calling this before they start keeps them off a core reserved for one thread. Returns false
+// if cpu is the only one left or the mask cannot be changed.
+inline bool excludeCpuFromCurrentThread(int cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (cpu < 0 || cpu >= CPU_SETSIZE || pthread_getaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        return false;
+    }
+    if (!CPU_ISSET(cpu, &set)) {
+        return true;
+    }
+    CPU_CLR(cpu, &set);
+    return CPU_COUNT(&set) > 0 && pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+#endif // THREADAFFINITY_HPP
@@ -0,0 +1,131 @@
+#ifndef TIMESTAMPEDTCPSTREAM_HPP
+#define TIMESTAMPEDTCPSTREAM_HPP
+
+#include <cerrno>
+#include <cstdint>
+#include <utility>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/socket_base.hpp>
+#include <boost/beast/core/async_base.hpp>
+#include <boost/beast/core/tcp_stream.hpp>
+#include "SocketTuning.hpp"
+
+// beast::tcp_stream whose reads go through recvmsg, so the kernel's software receive stamp of the
+// bytes comes back with them. Sits between the TLS layer and the socket
+// (ssl_stream<TimestampedTcpStream>); get_lowest_layer() still reaches the tcp_stream for connect,
+// timeouts and close. lastReceiveNs() is the stamp of the newest segment read so far, so once a
+// websocket message is complete it is when the message's last bytes reached the host.
+class TimestampedTcpStream {
+public:
+    using next_layer_type = boost::beast::tcp_stream;
+    using lowest_layer_type = next_layer_type::socket_type;   // For asio's ssl::stream
+    using executor_type = next_layer_type::executor_type;
+
+    template <typename ExecutionContext>
+    explicit TimestampedTcpStream(ExecutionContext& context) : stream(context) {}
+
+    executor_type get_executor() noexcept { return stream.get_executor(); }
+    next_layer_type& next_layer() noexcept { return stream; }
+    const next_layer_type& next_layer() const noexcept { return stream; }
+    lowest_layer_type& lowest_layer() noexcept { return stream.socket(); }
+    const lowest_layer_type& lowest_layer() const noexcept { return stream.socket(); }
+
+    // Applies tuning to the connected socket; call once the connect has completed
+    AppliedSocketTuning tune(const SocketTuning& tuning) {
+        return applySocketTuning(stream.socket().native_handle(), tuning);
+    }
+
+    // Kernel receive time of the newest bytes read (monotonicNowNs() scale), 0 without stamps
+    int64_t lastReceiveNs() const { return receiveNs; }
+
+    template <typename MutableBufferSequence, typename ReadHandler>
+    BOOST_BEAST_ASYNC_RESULT2(ReadHandler)
+    async_read_some(const MutableBufferSequence& buffers, ReadHandler&& handler) {
+        using HandlerType = BOOST_ASIO_HANDLER_TYPE(ReadHandler, void(boost::system::error_code, std::size_t));
+        boost::asio::async_completion<ReadHandler, void(boost::system::error_code, std::size_t)> init{handler};
+        ReadOp<MutableBufferSequence, HandlerType>(*this, buffers, init.completion_handler);
+        return init.result.get();
+    }
+
+    template <typename ConstBufferSequence, typename WriteHandler>
+    BOOST_BEAST_ASYNC_RESULT2(WriteHandler)
+    async_write_some(const ConstBufferSequence& buffers, WriteHandler&& handler) {
+        return stream.async_write_some(buffers, std::forward<WriteHandler>(handler));
+    }
+
+    // Blocking forms (TLS shutdown in teardown); these reads carry no stamp
+    template <typename MutableBufferSequence>
+    std::size_t read_some(const MutableBufferSequence& buffers, boost::system::error_code& ec) {
+        return stream.read_some(buffers, ec);
+    }
+    template <typename MutableBufferSequence>
+    std::size_t read_some(const MutableBufferSequence& buffers) {
+        return stream.read_some(buffers);
+    }
+    template <typename ConstBufferSequence>
+    std::size_t write_some(const ConstBufferSequence& buffers, boost::system::error_code& ec) {
+        return stream.write_some(buffers, ec);
+    }
+    template <typename ConstBufferSequence>
+    std::size_t write_some(const ConstBufferSequence& buffers) {
+        return stream.write_some(buffers);
+    }
+
+private:
+    static constexpr size_t kMaxBuffers = 16;
+
+    next_layer_type stream;
+    int64_t receiveNs = 0;
+
+    // Tries the read right away and waits for readability only when nothing is queued
+    template <typename MutableBufferSequence, typename Handler>
+    class ReadOp : public boost::beast::async_base<Handler, executor_type> {
+    public:
+        ReadOp(TimestampedTcpStream& owner, const MutableBufferSequence& bufs, Handler& handler)
+            : boost::beast::async_base<Handler, executor_type>(std::move(handler), owner.get_executor()),
+              self(owner), buffers(bufs) {
+            (*this)({}, false);
+        }
+
+        void operator()(boost::system::error_code ec, bool isContinuation = true) {
+            std::size_t transferred = 0;
+            if (!ec) {
+                iovec iov[kMaxBuffers];
+                size_t count = 0;
+                size_t requested = 0;
+                for (auto it = boost::asio::buffer_sequence_begin(buffers);
+                     it != boost::asio::buffer_sequence_end(buffers) && count < kMaxBuffers; ++it) {
+                    boost::asio::mutable_buffer buffer(*it);
+                    if (buffer.size() > 0) {
+                        iov[count].iov_base = buffer.data();
+                        iov[count].iov_len = buffer.size();
+                        requested += buffer.size();
+                        ++count;
+                    }
+                }
+                if (requested > 0) {
+                    ptrdiff_t received = receiveWithTimestamp(self.stream.socket().native_handle(), iov, count,
+                                                              &self.receiveNs);
+                    if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                        self.stream.socket().async_wait(boost::asio::socket_base::wait_read, std::move(*this));
+                        return;
+                    }
+                    if (received < 0) {
+                        ec.assign(errno, boost::system::system_category());
+                    } else if (received == 0) {
+                        ec = boost::asio::error::eof;
+                    } else {
+                        transferred = static_cast<std::size_t>(received);
+                    }
+                }
+            }
+            this->complete(isContinuation, ec, transferred);
+        }
+
+    private:
+        TimestampedTcpStream& self;
+        MutableBufferSequence buffers;
+    };
+};
+
+#endif // TIMESTAMPEDTCPSTREAM_HPP
@@ -0,0 +1,105 @@
+#include "TokenCache.hpp"
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <fcntl.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <boost/json.hpp>
+
+TokenCache::TokenCache(std::string path) : cachePath(std::move(path)) {}
+
+std::string TokenCache::pathNextTo(const std::string& configPath) {
+    auto slash = configPath.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : configPath.substr(0, slash);
+    return directory + "/token_cache.json";
+}
+
+int64_t TokenCache::nowSeconds() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+int64_t TokenCache::parseIsoTimestamp(const std::string& text) {
+    std::tm tm{};
+    std::istringstream in(text);
+    in >> std::get_time(&tm, "%Y-%m-%dT%H:%M:%S");
+    if (in.fail()) {
+        return 0;
+    }
+    return static_cast<int64_t>(timegm(&tm));
+}
+
+void TokenCache::load() {
+    std::ifstream file(cachePath);
+    if (!file.is_open()) {
+        return;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+
+    try {
+        auto cache = boost::json::parse(buffer.str()).as_object();
+        auto readEntry = [&cache](const char* name, Entry& entry) {
+            if (!cache.contains(name)) {
+                return;
+            }
+            const auto& object = cache.at(name).as_object();
+            entry.token = object.at("token").as_string().c_str();
+            entry.expiresAt = object.at("expires-at").as_int64();
+        };
+        readEntry("session", sessionToken);
+        readEntry("websocket", websocketToken);
+    } catch (const std::exception& e) {
+        std::cerr << "Ignoring unreadable token cache " << cachePath << ": " << e.what() << std::endl;
+        clear();
+    }
+}
+
+bool TokenCache::save() const {
+    boost::json::object cache{
+        {"session", boost::json::object{{"token", sessionToken.token}, {"expires-at", sessionToken.expiresAt}}},
+        {"websocket", boost::json::object{{"token", websocketToken.token}, {"expires-at", websocketToken.expiresAt}}}
+    };
+    std::string text = boost::json::serialize(cache);
+
+    // Created owner-only so the tokens are never readable by others, not even briefly. A leftover
+    // temp file keeps its mode through O_CREAT, so tighten it before writing.
+    std::string tempPath = cachePath + ".tmp";
+    int fd = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        std::cerr << "Failed to write token cache: " << tempPath << std::endl;
+        return false;
+    }
+    bool written = ::fchmod(fd, S_IRUSR | S_IWUSR) == 0;
+    for (size_t offset = 0; written && offset < text.size();) {
+        ssize_t count = ::write(fd, text.data() + offset, text.size() - offset);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        written = count > 0;
+        offset += written ? static_cast<size_t>(count) : 0;
+    }
+    written = ::close(fd) == 0 && written;
+    if (!written) {
+        std::cerr << "Failed to write token cache: " << tempPath << std::endl;
+        ::unlink(tempPath.c_str());
+        return false;
+    }
+    if (std::rename(tempPath.c_str(), cachePath.c_str()) != 0) {
+        std::cerr << "Failed to replace token cache: " << cachePath << std::endl;
+        ::unlink(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+void TokenCache::clear() {
+    sessionToken = Entry{};
+    websocketToken = Entry{};
+}
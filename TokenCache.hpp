@@ -0,0 +1,49 @@
+#ifndef TOKENCACHE_HPP
+#define TOKENCACHE_HPP
+
+#include <cstdint>
+#include <string>
+
+// Session and quote (websocket) tokens with their expiry, persisted in a small JSON file so a
+// new process can skip the REST login while the tokens are still valid.
+class TokenCache {
+public:
+    struct Entry {
+        std::string token;
+        int64_t expiresAt = 0; // Unix seconds, 0 if unknown
+
+        bool validAt(int64_t now) const { return !token.empty() && expiresAt > now; }
+    };
+
+    // Tokens closer than this to their expiry are treated as expired
+    static constexpr int64_t kExpiryMarginSeconds = 60;
+
+    explicit TokenCache(std::string path);
+
+    // Missing or unreadable files leave the cache empty
+    void load();
+
+    // Writes atomically (temp file + rename), readable by the owner only. Returns false, leaving
+    // the previous file in place, if any step fails.
+    bool save() const;
+
+    void clear();
+
+    Entry sessionToken;
+    Entry websocketToken;
+
+    const std::string& path() const { return cachePath; }
+
+    // Cache file next to the credentials file
+    static std::string pathNextTo(const std::string& configPath);
+
+    // Parses "2024-11-29T17:27:53.447Z"-style UTC timestamps; returns 0 on failure
+    static int64_t parseIsoTimestamp(const std::string& text);
+
+    static int64_t nowSeconds();
+
+private:
+    std::string cachePath;
+};
+
+#endif // TOKENCACHE_HPP
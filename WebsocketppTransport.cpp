@@ -0,0 +1,91 @@
+#include "WebsocketppTransport.hpp"
+#include "MonotonicClock.hpp"
+#include <stdexcept>
+
+WebsocketppTransport::WebsocketppTransport(SessionTimeline& timeline) : sessionTimeline(timeline) {
+    setSocketTuning(SocketTuning{});
+
+    // Initialized here rather than in open() so the io_context can take posted work and timers
+    // before the event loop thread has started running it
+    client.init_asio();
+
+    // Set the TLS initialization handler
+    client.set_tls_init_handler([this](websocketpp::connection_hdl hdl) {
+        int64_t start = monotonicNowNs();
+        auto ctx = custom_tls_config::on_tls_init(hdl, caFile);
+        sessionTimeline.record(SessionStage::WsTlsContextInit, start, monotonicNowNs());
+        return ctx;
+    });
+
+    // websocketpp resolves and connects internally, so DNS and TCP are timed as one stage.
+    // tcp_pre_init fires once the socket is connected, tcp_post_init once TLS is established.
+    client.set_tcp_pre_init_handler([this](websocketpp::connection_hdl hdl) {
+        tcpConnectedNs = monotonicNowNs();
+        sessionTimeline.record(SessionStage::WsResolveConnect, connectStartNs, tcpConnectedNs);
+        websocketpp::lib::error_code ec;
+        auto con = client.get_con_from_hdl(hdl, ec);
+        if (!ec) {
+            appliedTuning = applySocketTuning(con->get_socket().lowest_layer().native_handle(), requestedTuning);
+        }
+    });
+
+    client.set_tcp_post_init_handler([this](websocketpp::connection_hdl) {
+        tlsDoneNs = monotonicNowNs();
+        sessionTimeline.record(SessionStage::WsTlsHandshake, tcpConnectedNs, tlsDoneNs);
+    });
+
+    // Set up connection handlers
+    client.set_open_handler([this](websocketpp::connection_hdl hdl) {
+        sessionTimeline.record(SessionStage::WsUpgrade, tlsDoneNs, monotonicNowNs());
+        connectionHdl = hdl;
+        handlers.onOpen();
+    });
+
+    client.set_message_handler([this](websocketpp::connection_hdl, WebSocketClient::message_ptr msg) {
+        handlers.onMessage(msg->get_payload());
+    });
+
+    client.set_fail_handler([this](websocketpp::connection_hdl) {
+        handlers.onClose("failed");
+    });
+
+    client.set_close_handler([this](websocketpp::connection_hdl) {
+        handlers.onClose("closed");
+    });
+}
+
+void WebsocketppTransport::setSocketTuning(const SocketTuning& tuning) {
+    requestedTuning = tuning;
+    // Stamps only arrive with recvmsg, which websocketpp does not use
+    requestedTuning.receiveTimestamps = false;
+}
+
+void WebsocketppTransport::open(const std::string& url, const std::string& authorization) {
+    // Create WebSocket connection
+    websocketpp::lib::error_code ec;
+    WebSocketClient::connection_ptr con = client.get_connection(url, ec);
+    if (ec) {
+        throw std::runtime_error("Connection initialization error: " + ec.message());
+    }
+
+    // Add the Authorization header for the token
+    if (!authorization.empty()) {
+        con->append_header("Authorization", authorization);
+    }
+
+    connectStartNs = monotonicNowNs();
+    client.connect(con);
+}
+
+void WebsocketppTransport::send(const std::string& payload) {
+    client.send(connectionHdl, payload, websocketpp::frame::opcode::text);
+}
+
+void WebsocketppTransport::drop() {
+    websocketpp::lib::error_code ec;
+    auto con = client.get_con_from_hdl(connectionHdl, ec);
+    if (!ec) {
+        boost::system::error_code closeEc;
+        con->get_socket().lowest_layer().close(closeEc);
+    }
+}
@@ -0,0 +1,115 @@
+#ifndef WEBSOCKETPPTRANSPORT_HPP
+#define WEBSOCKETPPTRANSPORT_HPP
+
+#include <websocketpp/config/core_client.hpp>
+#include <websocketpp/transport/asio/endpoint.hpp>
+#include <websocketpp/transport/asio/security/tls.hpp>
+#include <websocketpp/client.hpp>
+#include <boost/asio/ssl.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <fstream> // For file existence check
+#include <openssl/ssl.h> // For OpenSSL configuration
+#include "AsyncLogger.hpp"
+#include "FeedTransport.hpp"
+
+// Custom TLS configuration for WebSocket++ client
+struct custom_tls_config : public websocketpp::config::core_client {
+    typedef custom_tls_config type;
+    typedef core_client base;
+
+    typedef base::concurrency_type concurrency_type;
+    typedef base::request_type request_type;
+    typedef base::response_type response_type;
+    typedef base::message_type message_type;
+    typedef base::con_msg_manager_type con_msg_manager_type;
+    typedef base::endpoint_msg_manager_type endpoint_msg_manager_type;
+    typedef base::alog_type alog_type;
+    typedef base::elog_type elog_type;
+    typedef base::rng_type rng_type;
+
+    struct transport_config : public base::transport_config {
+        typedef type::concurrency_type concurrency_type;
+        typedef type::alog_type alog_type;
+        typedef type::elog_type elog_type;
+        typedef type::request_type request_type;
+        typedef type::response_type response_type;
+        typedef websocketpp::transport::asio::tls_socket::endpoint socket_type;
+    };
+
+    typedef websocketpp::transport::asio::endpoint<transport_config> transport_type;
+
+    static constexpr const char* kDefaultCaFile = "/etc/ssl/certs/ca-bundle.crt";
+
+    // TLS context initialization
+    static std::shared_ptr<boost::asio::ssl::context> on_tls_init(websocketpp::connection_hdl,
+                                                                  const std::string& caFile = kDefaultCaFile) {
+        const char* cert_file = caFile.c_str();
+
+        // Debug: Check if the CA file exists
+        std::ifstream file(cert_file);
+        if (file) {
+            PX_LOG_DEBUG("[DEBUG] CA file found: {}", cert_file);
+        } else {
+            PX_LOG_ERROR("[ERROR] CA file not found: {}", cert_file);
+        }
+
+        // Create and configure the SSL context
+        auto ctx = std::make_shared<boost::asio::ssl::context>(boost::asio::ssl::context::tlsv12);
+        try {
+            ctx->set_verify_mode(boost::asio::ssl::verify_peer); // Verify peers
+
+            // Directly set the CA file path for OpenSSL
+            if (SSL_CTX_load_verify_locations(ctx->native_handle(), cert_file, nullptr) != 1) {
+                PX_LOG_ERROR("[ERROR] Failed to load CA file: {}", cert_file);
+                throw std::runtime_error("Failed to load CA file");
+            }
+
+            PX_LOG_DEBUG("[DEBUG] Successfully loaded CA file: {}", cert_file);
+        } catch (const std::exception& e) {
+            PX_LOG_ERROR("[ERROR] SSL context configuration failed: {}", e.what());
+            throw;
+        }
+
+        return ctx;
+    }
+};
+
+// WebSocket client typedef
+typedef websocketpp::client<custom_tls_config> WebSocketClient;
+
+// FeedTransport on websocketpp. Payloads arrive as the std::string websocketpp allocates for every
+// message; the TLS context, with its CA bundle, is built for every connection in on_tls_init.
+// websocketpp reads the socket itself, so there are no kernel receive stamps on this transport.
+class WebsocketppTransport : public FeedTransport {
+public:
+    explicit WebsocketppTransport(SessionTimeline& timeline);
+
+    const char* name() const override { return "websocketpp"; }
+    void setHandlers(TransportHandlers transportHandlers) override { handlers = std::move(transportHandlers); }
+    void setCaFile(const std::string& path) override { caFile = path; }
+    void setSocketTuning(const SocketTuning& tuning) override;
+    AppliedSocketTuning socketTuning() const override { return appliedTuning; }
+    void open(const std::string& url, const std::string& authorization) override;
+    void send(const std::string& payload) override;
+    void drop() override;
+    void run() override { client.run(); }
+    void stop() override { client.stop(); }
+    boost::asio::io_context& ioContext() override { return client.get_io_service(); }
+
+private:
+    WebSocketClient client;
+    websocketpp::connection_hdl connectionHdl;
+    TransportHandlers handlers;
+    std::string caFile = custom_tls_config::kDefaultCaFile;
+    SocketTuning requestedTuning;
+    AppliedSocketTuning appliedTuning;
+
+    SessionTimeline& sessionTimeline;
+    int64_t connectStartNs = 0;
+    int64_t tcpConnectedNs = 0;
+    int64_t tlsDoneNs = 0;
+};
+
+#endif // WEBSOCKETPPTRANSPORT_HPP
@@ -0,0 +1,153 @@
+// Quote handler latency with console output done in place vs through the AsyncLogger. A handler
+// prints the line main prints per quote ("Symbol: ... | Bid: ... | Ask: ..."), for a stream of
+// quotes paced at a fixed interval, with stdout redirected to a file:
+//  - std::cout with std::endl: a flush (write syscall) per quote, as onMessage used to do;
+//  - std::cout with '\n': formatting in the handler, stdio's buffer flushes now and then;
+//  - PX_LOG_INFO: the handler only copies the raw fields into its thread's ring;
+//  - PX_LOG_DEBUG: compiled out at the default PX_LOG_LEVEL, i.e. the floor.
+// Every case must write the same text; the files are compared at the end.
+//
+// Build: g++ -O2 -std=c++17 -pthread -I.. AsyncLoggerBench.cpp ../AsyncLogger.cpp ../LatencyHistogram.cpp
+//        -o async_logger_bench
+// Usage: async_logger_bench [quotes per case] [interval ns] [output directory]
+#include <fcntl.h>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+#include "AsyncLogger.hpp"
+#include "LatencyHistogram.hpp"
+#include "MonotonicClock.hpp"
+#include "QuoteRecord.hpp"
+
+namespace {
+
+std::vector<QuoteRecord> makeQuotes(size_t count) {
+    std::vector<QuoteRecord> quotes(count);
+    for (size_t i = 0; i < count; ++i) {
+        QuoteRecord& quote = quotes[i];
+        quote.receiveTimeNs = 0;
+        quote.bidPrice = 1.2 + static_cast<double>(i % 997) * 0.0001;
+        quote.askPrice = quote.bidPrice + 0.0001;
+        quote.bidSize = static_cast<double>(1 + i % 13);
+        quote.askSize = static_cast<double>(1 + i % 7);
+        quote.symbolId = static_cast<int32_t>(i % 64);
+        quote.setSymbol("/SYN" + std::to_string(i % 64) + ":XCME");
+    }
+    return quotes;
+}
+
+struct CaseResult {
+    LatencyHistogram handler;
+    std::string path;
+};
+
+// Runs handler over quotes at the given pace with fd 1 pointed at path
+CaseResult runCase(const std::vector<QuoteRecord>& quotes, int64_t intervalNs, const std::string& path,
+                   const std::function<void(const QuoteRecord&)>& handler) {
+    CaseResult result;
+    result.path = path;
+    std::cout.flush();
+    std::fflush(stdout);
+    int saved = ::dup(1);
+    int file = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (file < 0 || saved < 0) {
+        std::perror("Cannot redirect stdout");
+        std::exit(1);
+    }
+    ::dup2(file, 1);
+    ::close(file);
+
+    int64_t next = monotonicNowNs();
+    for (const auto& quote : quotes) {
+        next += intervalNs;
+        while (monotonicNowNs() < next) {
+        }
+        int64_t start = monotonicNowNs();
+        handler(quote);
+        result.handler.recordDuration(start, monotonicNowNs());
+    }
+
+    std::cout.flush();
+    AsyncLogger::instance().flush();
+    std::fflush(stdout);
+    ::dup2(saved, 1);
+    ::close(saved);
+    return result;
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::ostringstream text;
+    text << in.rdbuf();
+    return text.str();
+}
+
+void printRow(const char* name, const LatencyHistogram& histogram) {
+    std::cout << std::left << std::setw(22) << name << std::right << std::setw(10) << histogram.percentile(50)
+              << std::setw(10) << histogram.percentile(99) << std::setw(10) << histogram.percentile(99.9)
+              << std::setw(10) << histogram.max() << std::setw(10) << static_cast<uint64_t>(histogram.mean())
+              << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+    int64_t intervalNs = argc > 2 ? std::atoll(argv[2]) : 2000;
+    std::string directory = argc > 3 ? argv[3] : "/tmp";
+    if (count == 0 || intervalNs < 0) {
+        std::cerr << "Need at least one quote and a non-negative interval" << std::endl;
+        return 1;
+    }
+    std::vector<QuoteRecord> quotes = makeQuotes(count);
+    std::string prefix = directory + "/async_logger_bench." + std::to_string(::getpid());
+
+    CaseResult endl = runCase(quotes, intervalNs, prefix + ".endl", [](const QuoteRecord& quote) {
+        std::cout << "Symbol: " << quote.symbolView() << " | Bid: " << quote.bidPrice << " | Ask: " << quote.askPrice
+                  << " | Mid: " << quote.midPrice() << " | bidSize: " << quote.bidSize
+                  << " | askSize: " << quote.askSize << std::endl;
+    });
+    CaseResult newline = runCase(quotes, intervalNs, prefix + ".newline", [](const QuoteRecord& quote) {
+        std::cout << "Symbol: " << quote.symbolView() << " | Bid: " << quote.bidPrice << " | Ask: " << quote.askPrice
+                  << " | Mid: " << quote.midPrice() << " | bidSize: " << quote.bidSize
+                  << " | askSize: " << quote.askSize << '\n';
+    });
+    uint64_t droppedBefore = AsyncLogger::instance().droppedCount();
+    CaseResult logged = runCase(quotes, intervalNs, prefix + ".async", [](const QuoteRecord& quote) {
+        PX_LOG_INFO("Symbol: {} | Bid: {} | Ask: {} | Mid: {} | bidSize: {} | askSize: {}", quote.symbolView(),
+                    quote.bidPrice, quote.askPrice, quote.midPrice(), quote.bidSize, quote.askSize);
+    });
+    uint64_t dropped = AsyncLogger::instance().droppedCount() - droppedBefore;
+    CaseResult compiledOut = runCase(quotes, intervalNs, prefix + ".debug", [](const QuoteRecord& quote) {
+        PX_LOG_DEBUG("Symbol: {} | Bid: {} | Ask: {} | Mid: {} | bidSize: {} | askSize: {}", quote.symbolView(),
+                     quote.bidPrice, quote.askPrice, quote.midPrice(), quote.bidSize, quote.askSize);
+    });
+
+    std::cout << "Quote handler time, ns (" << count << " quotes, one every " << intervalNs
+              << " ns, stdout to a file)\n" << std::endl;
+    std::cout << std::left << std::setw(22) << "output" << std::right << std::setw(10) << "p50" << std::setw(10)
+              << "p99" << std::setw(10) << "p99.9" << std::setw(10) << "max" << std::setw(10) << "mean" << std::endl;
+    printRow("std::cout + endl", endl.handler);
+    printRow("std::cout + '\\n'", newline.handler);
+    printRow("AsyncLogger", logged.handler);
+    printRow("compiled out (debug)", compiledOut.handler);
+    std::cout << "\nAsyncLogger records dropped (ring full): " << dropped << std::endl;
+
+    std::string expected = readFile(endl.path);
+    bool same = expected == readFile(newline.path) && (dropped > 0 || expected == readFile(logged.path));
+    for (const auto* result : {&endl, &newline, &logged, &compiledOut}) {
+        std::remove(result->path.c_str());
+    }
+    if (!same) {
+        std::cerr << "The outputs differ" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,125 @@
+// Time-to-first-quote of a cold start (no token cache): the sequential bootstrap (login, quote
+// token, then connect the websocket) against the overlapped one, where DNS/TCP/TLS, the upgrade
+// and SETUP run while the REST calls are in flight. Needs a local stand-in with some delay, e.g.
+//
+//   python3 tools/dxlink_standin.py --port 8443 --connect-delay-ms 20 --rest-delay-ms 40 --ws-delay-ms 10
+//
+// Build: g++ -O2 -std=c++17 -I.. BootstrapBench.cpp ../dxFeedSession.cpp ../RestConnection.cpp
+//        ../TokenCache.cpp ../MarketDataWebSocket.cpp ../SubscriptionManager.cpp ../FeedTransport.cpp
+//        ../BeastTransport.cpp ../WebsocketppTransport.cpp ../QuoteBook.cpp ../QuoteDispatcher.cpp
+//        ../SocketTuning.cpp ../AsyncLogger.cpp ../FeedMetrics.cpp ../LatencyHistogram.cpp ../SessionTimeline.cpp
+//        ../CompactFeedDecoder.cpp -lboost_json -lssl -lcrypto -pthread -o bootstrap_bench
+// Usage: bootstrap_bench [runs] [port] [CA file]
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "dxFeedSession.hpp"
+#include "LatencyHistogram.hpp"
+#include "MarketDataWebSocket.hpp"
+#include "MonotonicClock.hpp"
+
+namespace {
+
+struct BenchConfig {
+    std::string port;
+    std::string caFile;
+    std::string credsPath;
+};
+
+// One cold start; returns nanoseconds from the start to the first quote, or -1 if none arrived
+int64_t timeToFirstQuote(const BenchConfig& config, bool overlapBootstrap, SessionTimeline& timeline) {
+    std::remove(TokenCache::pathNextTo(config.credsPath).c_str());
+
+    int64_t startNs = monotonicNowNs();
+    dxFeedSession session(config.credsPath, "127.0.0.1", config.port);
+    session.setCaFile(config.caFile);
+    if (!overlapBootstrap) {
+        session.ensureWebsocketToken();
+    }
+
+    MarketDataWebSocket wsClient("wss://127.0.0.1:" + config.port + "/realtime",
+                                 overlapBootstrap ? "" : session.websocketToken, 3);
+    wsClient.setCaFile(config.caFile);
+    wsClient.setSymbolsToTrack({"/6BZ24:XCME"});
+
+    if (overlapBootstrap) {
+        std::thread feedThread([&wsClient] { wsClient.connect(); });
+        try {
+            session.ensureWebsocketToken();
+        } catch (...) {
+            wsClient.stop();
+            feedThread.join();
+            throw;
+        }
+        wsClient.provideToken(session.websocketToken);
+        feedThread.join();
+    } else {
+        wsClient.connect();
+    }
+
+    timeline.merge(session.timeline());
+    timeline.merge(wsClient.timeline());
+
+    QuoteRecord first;
+    if (!wsClient.quotes().poll(first)) {
+        return -1;
+    }
+    return first.receiveTimeNs - startNs;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int runs = argc > 1 ? std::atoi(argv[1]) : 20;
+    BenchConfig config;
+    config.port = argc > 2 ? argv[2] : "8443";
+    config.caFile = argc > 3 ? argv[3] : "../tools/standin-cert.pem";
+    config.credsPath = "bootstrap_bench_creds.json";
+
+    // The stand-in accepts any credentials
+    std::ofstream(config.credsPath) << R"({"user": ["standin"], "pw": ["standin"]})";
+
+    int status = 0;
+    try {
+        LatencyHistogram results[2];
+        SessionTimeline timelines[2];
+        for (int i = 0; i < runs; ++i) {
+            // Interleave the modes so drift on the machine affects both alike
+            for (int mode = 0; mode < 2; ++mode) {
+                int64_t ns = timeToFirstQuote(config, mode == 1, timelines[mode]);
+                if (ns < 0) {
+                    std::cerr << "No quote received" << std::endl;
+                    status = 1;
+                    continue;
+                }
+                results[mode].record(static_cast<uint64_t>(ns));
+            }
+        }
+
+        const char* names[2] = {"sequential", "overlapped"};
+        for (int mode = 0; mode < 2; ++mode) {
+            std::cout << names[mode] << " time-to-first-quote: " << results[mode].summary() << std::endl;
+        }
+        if (results[0].count() > 0 && results[1].count() > 0) {
+            std::cout << "p50 saving: "
+                      << (static_cast<double>(results[0].percentile(50.0)) -
+                          static_cast<double>(results[1].percentile(50.0))) / 1000.0
+                      << " us" << std::endl;
+        }
+        for (int mode = 0; mode < 2; ++mode) {
+            std::cout << names[mode] << " stages:" << std::endl;
+            timelines[mode].report(std::cout);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        status = 1;
+    }
+
+    std::remove(config.credsPath.c_str());
+    std::remove(TokenCache::pathNextTo(config.credsPath).c_str());
+    return status;
+}
@@ -0,0 +1,86 @@
+// Compares the old boost::json FEED_DATA path in MarketDataWebSocket::onMessage with CompactFeedDecoder.
+//
+// Build: g++ -O2 -std=c++17 -I.. CompactFeedDecoderBench.cpp ../CompactFeedDecoder.cpp -lboost_json -o compact_feed_decoder_bench
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/json.hpp>
+#include "CompactFeedDecoder.hpp"
+#include "SyntheticFeed.hpp"
+
+namespace {
+
+// The FEED_DATA handling as it was before CompactFeedDecoder, minus the printing
+double legacyDecode(const std::string& message) {
+    double checksum = 0;
+    auto data = boost::json::parse(message).as_object();
+    if (data["type"].as_string() == "FEED_DATA" && data["channel"].as_int64() == 3) {
+        auto feedData = data["data"].as_array();
+        std::string feedType = std::string(feedData[0].as_string().c_str());
+        auto marketData = feedData[1].as_array();
+
+        for (size_t i = 0; i < marketData.size(); i += 6) {
+            std::string eventType = std::string(marketData[i + 0].as_string().c_str());
+            std::string eventSymbol = std::string(marketData[i + 1].as_string().c_str());
+            double bidPrice = marketData[i + 2].as_double();
+            double askPrice = marketData[i + 3].as_double();
+            double bidSize = marketData[i + 4].as_double();
+            double askSize = marketData[i + 5].as_double();
+            checksum += bidPrice + askPrice + bidSize + askSize + static_cast<double>(eventSymbol.size());
+        }
+    }
+    return checksum;
+}
+
+double compactDecode(const std::string& message) {
+    double checksum = 0;
+    DxLinkFrame frame;
+    if (CompactFeedDecoder::scanFrame(message, frame) && frame.type == DxLinkMessageType::FeedData &&
+        frame.channel == 3) {
+        CompactFeedDecoder::decodeQuotes(frame.data, [&checksum](const QuoteEvent& quote) {
+            checksum += quote.bidPrice + quote.askPrice + quote.bidSize + quote.askSize +
+                        static_cast<double>(quote.eventSymbol.size());
+        });
+    }
+    return checksum;
+}
+
+template <typename Decode>
+double nsPerQuote(const std::string& message, size_t quotesPerFrame, size_t iterations, Decode decode,
+                  double& checksum) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        checksum += decode(message);
+    }
+    auto end = std::chrono::steady_clock::now();
+    double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    return ns / static_cast<double>(iterations * quotesPerFrame);
+}
+
+} // namespace
+
+int main() {
+    double checksum = 0;
+    std::cout << "quotes/frame | legacy ns/quote | compact ns/quote | speedup" << std::endl;
+    for (size_t quotesPerFrame : {1, 10, 100, 500}) {
+        SyntheticFeedConfig config;
+        config.symbolCount = quotesPerFrame;
+        config.quotesPerFrame = quotesPerFrame;
+        config.frameCount = 1;
+        std::string message = makeSyntheticFrames(config).front();
+        size_t iterations = 2000000 / quotesPerFrame;
+
+        if (legacyDecode(message) != compactDecode(message)) {
+            std::cerr << "Decoders disagree for " << quotesPerFrame << " quotes/frame" << std::endl;
+            return 1;
+        }
+
+        double legacy = nsPerQuote(message, quotesPerFrame, iterations, legacyDecode, checksum);
+        double compact = nsPerQuote(message, quotesPerFrame, iterations, compactDecode, checksum);
+        std::cout << quotesPerFrame << " | " << legacy << " | " << compact << " | " << legacy / compact << "x"
+                  << std::endl;
+    }
+    std::cout << "(checksum " << checksum << ")" << std::endl;
+    return 0;
+}
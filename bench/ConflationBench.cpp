@@ -0,0 +1,152 @@
+// Consumer lag under bursts, with and without conflation. A producer thread plays the feed thread:
+// it publishes bursts of quotes across a set of symbols as fast as it can, pausing between bursts,
+// while the dispatcher's consumer thread spends a fixed amount of work on every quote it gets (a
+// strategy slower than the feed). Lag is the age of a quote when the consumer handles it
+// (monotonicNowNs() - receiveTimeNs), so with conflation it is the age of the newest merged update.
+// Reports the lag percentiles, the largest backlog seen, quotes dropped, updates merged and how long
+// the consumer needed after the last burst to catch up.
+//
+// Build: g++ -O2 -std=c++17 -pthread -I.. ConflationBench.cpp ../QuoteDispatcher.cpp ../LatencyHistogram.cpp
+//        -o conflation_bench
+// Usage: conflation_bench [quotes per burst] [bursts] [consumer work ns] [symbols]
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "LatencyHistogram.hpp"
+#include "MonotonicClock.hpp"
+#include "QuoteDispatcher.hpp"
+
+namespace {
+
+struct Scenario {
+    const char* name;
+    size_t ringCapacity;
+    bool conflate;
+};
+
+struct RunResult {
+    LatencyHistogram lag;
+    QuoteDispatcher::Stats stats{};
+    size_t maxBacklog = 0;
+    uint64_t handled = 0;
+    uint64_t updates = 0;            // Sum of the per-quote update counts the consumer was told
+    int64_t catchUpNs = 0;           // Last publish -> consumer idle
+    uint64_t lastValueMismatches = 0;
+};
+
+void spinFor(int64_t ns) {
+    int64_t until = monotonicNowNs() + ns;
+    while (monotonicNowNs() < until) {
+    }
+}
+
+RunResult run(const Scenario& scenario, uint64_t burstQuotes, int bursts, int64_t workNs, size_t symbols) {
+    RunResult result;
+    QuoteDispatcher dispatcher(scenario.ringCapacity);
+    if (scenario.conflate) {
+        dispatcher.enableConflation(symbols);
+    }
+
+    // bidSize carries the update's sequence within its symbol, so the last quote handled per symbol
+    // can be checked against the last one published
+    std::vector<double> lastSeen(symbols, -1);
+    std::atomic<int64_t> lastHandledNs{0};
+    dispatcher.start([&](const QuoteRecord& quote, uint32_t updates) {
+        result.lag.recordDuration(quote.receiveTimeNs, monotonicNowNs());
+        lastSeen[static_cast<size_t>(quote.symbolId)] = quote.bidSize;
+        ++result.handled;
+        result.updates += updates;
+        spinFor(workNs);
+        lastHandledNs.store(monotonicNowNs(), std::memory_order_relaxed);
+    });
+
+    std::vector<uint64_t> perSymbol(symbols, 0);
+    QuoteRecord quote{};
+    quote.setSymbol("/SYN:XCME");
+    int64_t lastPublishNs = 0;
+    for (int burst = 0; burst < bursts; ++burst) {
+        for (uint64_t i = 0; i < burstQuotes; ++i) {
+            size_t id = (i * 7 + static_cast<uint64_t>(burst)) % symbols;
+            quote.symbolId = static_cast<int32_t>(id);
+            quote.bidPrice = 1.25 + static_cast<double>(i % 100) * 0.0001;
+            quote.askPrice = quote.bidPrice + 0.0001;
+            quote.bidSize = static_cast<double>(perSymbol[id]++);
+            quote.receiveTimeNs = monotonicNowNs();
+            dispatcher.publish(quote);
+            if ((i & 255) == 0) {
+                result.maxBacklog = std::max(result.maxBacklog, dispatcher.backlog());
+            }
+        }
+        lastPublishNs = monotonicNowNs();
+        result.maxBacklog = std::max(result.maxBacklog, dispatcher.backlog());
+        // Quiet period between bursts, as after a news spike
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    while (dispatcher.backlog() > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    dispatcher.stop();
+    result.catchUpNs = std::max<int64_t>(0, lastHandledNs.load() - lastPublishNs);
+    result.stats = dispatcher.stats();
+
+    // Without drops the consumer must end on every symbol's final update
+    if (result.stats.dropped == 0) {
+        for (size_t id = 0; id < symbols; ++id) {
+            if (lastSeen[id] != static_cast<double>(perSymbol[id]) - 1) {
+                ++result.lastValueMismatches;
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    uint64_t burstQuotes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+    int bursts = argc > 2 ? std::atoi(argv[2]) : 5;
+    int64_t workNs = argc > 3 ? std::atoll(argv[3]) : 1000;
+    size_t symbols = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 64;
+
+    std::cout << "bursts: " << bursts << " x " << burstQuotes << " quotes over " << symbols
+              << " symbols | consumer work: " << workNs << " ns/quote | CPUs: " << ::sysconf(_SC_NPROCESSORS_ONLN)
+              << '\n' << std::endl;
+    std::cout << std::left << std::setw(22) << "mode" << std::right << std::setw(10) << "handled"
+              << std::setw(10) << "dropped" << std::setw(10) << "merged" << std::setw(10) << "backlog"
+              << std::setw(11) << "p50 us" << std::setw(11) << "p99 us" << std::setw(11) << "max us"
+              << std::setw(13) << "catch-up ms" << std::endl;
+
+    const Scenario scenarios[] = {
+        {"ring 64k, drop", 65536, false},
+        {"ring 4M, no drop", size_t{1} << 22, false},
+        {"conflate (ring 64k)", 65536, true},
+    };
+    bool ok = true;
+    for (const Scenario& scenario : scenarios) {
+        auto result = std::make_unique<RunResult>(run(scenario, burstQuotes, bursts, workNs, symbols));
+        const LatencyHistogram& lag = result->lag;
+        std::cout << std::left << std::setw(22) << scenario.name << std::right << std::setw(10) << result->handled
+                  << std::setw(10) << result->stats.dropped << std::setw(10) << result->stats.merged
+                  << std::setw(10) << result->maxBacklog << std::fixed << std::setprecision(1)
+                  << std::setw(11) << static_cast<double>(lag.percentile(50)) / 1000.0
+                  << std::setw(11) << static_cast<double>(lag.percentile(99)) / 1000.0
+                  << std::setw(11) << static_cast<double>(lag.max()) / 1000.0
+                  << std::setw(13) << static_cast<double>(result->catchUpNs) / 1e6 << std::defaultfloat << std::endl;
+        // Every published update is either handled, merged into a handled quote, or dropped
+        uint64_t published = burstQuotes * static_cast<uint64_t>(bursts);
+        if (result->updates + result->stats.dropped != published ||
+            result->handled + result->stats.merged != result->updates || result->lastValueMismatches != 0) {
+            std::cerr << "  inconsistent run: updates " << result->updates << " + dropped " << result->stats.dropped
+                      << " != " << published << ", last-value mismatches " << result->lastValueMismatches << std::endl;
+            ok = false;
+        }
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,191 @@
+// Cost of FeedMetrics on the message path. Three measurements, all in feed-thread CPU time:
+//  - the counters alone: onFrame() plus one onSymbolUpdate() per message over a spread of symbol ids,
+//    against the same loop without them;
+//  - the FEED_DATA hot path (FeedProcessor::onMessage on synthetic 1-quote frames) with and without
+//    metrics, interleaved so drift hits both alike; the difference is what the metrics add;
+//  - the same with a scraper thread rendering the Prometheus text every millisecond meanwhile, as a
+//    MetricsServer would.
+// The budget is 20 ns per message. The counts are checked against what was fed in.
+//
+// Build: g++ -O2 -std=c++17 -pthread -I.. FeedMetricsBench.cpp ../FeedMetrics.cpp ../CompactFeedDecoder.cpp
+//        ../QuoteBook.cpp ../QuoteDispatcher.cpp ../LatencyHistogram.cpp ../SessionTimeline.cpp
+//        -o feed_metrics_bench
+// Usage: feed_metrics_bench [messages per run] [runs]
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "FeedMetrics.hpp"
+#include "FeedProcessor.hpp"
+#include "MonotonicClock.hpp"
+#include "SyntheticFeed.hpp"
+
+namespace {
+
+constexpr double kBudgetNs = 20.0;
+
+int64_t threadCpuNowNs() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+// ns per message of the counters alone; returns {without, with}
+std::pair<double, double> countersAlone(size_t symbolCount, uint64_t messages, int runs, bool& consistent) {
+    QuoteBook book(syntheticSymbols(symbolCount));
+    std::vector<double> without;
+    std::vector<double> with;
+    volatile uint64_t sink = 0;
+    for (int run = 0; run < runs; ++run) {
+        FeedMetrics metrics(book.capacity());
+        // Baseline: the same id and timestamp arithmetic, no counters
+        int64_t start = threadCpuNowNs();
+        int64_t t = 1;
+        uint64_t id = 0;
+        for (uint64_t i = 0; i < messages; ++i) {
+            t += 997;
+            id = id + 7 < symbolCount ? id + 7 : (id + 7) % symbolCount;
+        }
+        sink = sink + id + static_cast<uint64_t>(t);
+        without.push_back(static_cast<double>(threadCpuNowNs() - start) / static_cast<double>(messages));
+
+        start = threadCpuNowNs();
+        t = 1;
+        id = 0;
+        for (uint64_t i = 0; i < messages; ++i) {
+            t += 997;
+            id = id + 7 < symbolCount ? id + 7 : (id + 7) % symbolCount;
+            metrics.onFrame(120, t);
+            metrics.onSymbolUpdate(static_cast<int32_t>(id), t);
+        }
+        sink = sink + id + static_cast<uint64_t>(t);
+        with.push_back(static_cast<double>(threadCpuNowNs() - start) / static_cast<double>(messages));
+
+        uint64_t updates = 0;
+        for (size_t s = 0; s < symbolCount; ++s) {
+            updates += metrics.symbolUpdates(static_cast<int32_t>(s));
+        }
+        if (metrics.frameCount() != messages || metrics.byteCount() != messages * 120 || updates != messages) {
+            consistent = false;
+        }
+    }
+    return {median(without), median(with)};
+}
+
+// ns per frame of FeedProcessor::onMessage; returns {without, with}
+std::pair<double, double> hotPath(size_t symbolCount, uint64_t messages, int runs, bool scrape, bool& consistent) {
+    SyntheticFeedConfig config;
+    config.symbolCount = symbolCount;
+    config.quotesPerFrame = 1;
+    config.frameCount = std::min<size_t>(4096, symbolCount * 2 + 64);
+    std::vector<std::string> frames = makeSyntheticFrames(config);
+    QuoteBook book(syntheticSymbols(symbolCount));
+    QuoteDispatcher dispatcher(1 << 16);
+    SessionTimeline timeline;
+    FeedProcessor processor(book, dispatcher, timeline);
+    double checksum = 0;
+    auto consume = [&checksum](const QuoteRecord& quote) { checksum += quote.bidPrice; };
+
+    std::vector<double> without;
+    std::vector<double> with;
+    for (int run = 0; run < runs * 2; ++run) {
+        bool withMetrics = (run & 1) != 0;
+        FeedMetrics metrics(book.capacity());
+        processor.setMetrics(withMetrics ? &metrics : nullptr);
+
+        std::atomic<bool> scraping{scrape && withMetrics};
+        std::thread scraper;
+        if (scraping) {
+            scraper = std::thread([&] {
+                while (scraping.load(std::memory_order_relaxed)) {
+                    std::ostringstream text;
+                    metrics.render(text, book, monotonicNowNs());
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            });
+        }
+
+        int64_t cpu = 0;
+        uint64_t done = 0;
+        while (done < messages) {
+            int64_t start = threadCpuNowNs();
+            for (const auto& frame : frames) {
+                int64_t receiveTimeNs = monotonicNowNs();
+                if (withMetrics) {
+                    metrics.onFrame(frame.size(), receiveTimeNs);
+                }
+                processor.onMessage(frame, config.channel, receiveTimeNs);
+            }
+            cpu += threadCpuNowNs() - start;
+            done += frames.size();
+            // Outside the timed part; a consumer thread would do this in production
+            dispatcher.drain(consume, SIZE_MAX);
+        }
+        scraping = false;
+        if (scraper.joinable()) {
+            scraper.join();
+        }
+        (withMetrics ? with : without).push_back(static_cast<double>(cpu) / static_cast<double>(done));
+        if (withMetrics && metrics.frameCount() != done) {
+            consistent = false;
+        }
+    }
+    processor.setMetrics(nullptr);
+    if (checksum == 0) {
+        std::cerr << "(empty checksum)" << std::endl;
+    }
+    return {median(without), median(with)};
+}
+
+void printRow(const char* name, size_t symbols, std::pair<double, double> result) {
+    double added = result.second - result.first;
+    std::cout << std::left << std::setw(26) << name << std::right << std::setw(9) << symbols << std::fixed
+              << std::setprecision(1) << std::setw(13) << result.first << std::setw(13) << result.second
+              << std::setw(12) << added << "  " << (added <= kBudgetNs ? "ok" : "over budget") << std::defaultfloat
+              << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    uint64_t messages = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    int runs = argc > 2 ? std::atoi(argv[2]) : 7;
+    if (messages == 0 || runs < 1) {
+        std::cerr << "Need at least one message and one run" << std::endl;
+        return 1;
+    }
+
+    std::cout << "ns per message (feed thread CPU), median of " << runs << " runs; budget " << kBudgetNs
+              << " ns added\n" << std::endl;
+    std::cout << std::left << std::setw(26) << "case" << std::right << std::setw(9) << "symbols"
+              << std::setw(13) << "without ns" << std::setw(13) << "with ns" << std::setw(12) << "added ns" << std::endl;
+
+    bool consistent = true;
+    for (size_t symbols : {1, 100, 10000}) {
+        printRow("counters alone", symbols, countersAlone(symbols, messages, runs, consistent));
+    }
+    uint64_t hotPathMessages = std::max<uint64_t>(1, messages / 4);
+    for (size_t symbols : {1, 100, 10000}) {
+        printRow("hot path", symbols, hotPath(symbols, hotPathMessages, runs, false, consistent));
+    }
+    for (size_t symbols : {100, 10000}) {
+        printRow("hot path, scraped 1/ms", symbols, hotPath(symbols, hotPathMessages, runs, true, consistent));
+    }
+
+    if (!consistent) {
+        std::cerr << "Counters do not match the messages fed in" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,139 @@
+// QuoteHistory and QuoteKernels over a million quotes of one symbol: append cost, then mid,
+// spread and size-weighted mid filled into an array and summarized (mean/stddev/min/max), each
+// with the default kernels (AVX2 when built with -mavx2) against the scalar reference loops, plus
+// rolling-window stats queries. Results of both paths are checked against each other.
+//
+// Build: g++ -O2 -mavx2 -std=c++17 -I.. QuoteHistoryBench.cpp ../QuoteHistory.cpp ../QuoteKernels.cpp
+//        -o quote_history_bench
+// Usage: quote_history_bench [quotes] [min seconds per case]
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "QuoteHistory.hpp"
+#include "QuoteKernels.hpp"
+
+namespace {
+
+// Runs fn until minSeconds have passed; returns ns per call
+template <typename Fn>
+double timePerCall(double minSeconds, Fn&& fn) {
+    uint64_t calls = 0;
+    auto start = std::chrono::steady_clock::now();
+    double elapsed = 0;
+    do {
+        fn();
+        ++calls;
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    } while (elapsed < minSeconds);
+    return elapsed * 1e9 / static_cast<double>(calls);
+}
+
+bool agrees(double a, double b) {
+    return (std::isnan(a) && std::isnan(b)) || std::fabs(a - b) <= 1e-9 * std::max(1.0, std::fabs(a));
+}
+
+const char* seriesName(QuoteSeries series) {
+    switch (series) {
+        case QuoteSeries::Bid: return "bid";
+        case QuoteSeries::Ask: return "ask";
+        case QuoteSeries::BidSize: return "bid size";
+        case QuoteSeries::AskSize: return "ask size";
+        case QuoteSeries::Mid: return "mid";
+        case QuoteSeries::Spread: return "spread";
+        case QuoteSeries::WeightedMid: return "weighted mid";
+    }
+    return "?";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t quoteCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    double minSeconds = argc > 2 ? std::atof(argv[2]) : 0.5;
+
+    // One symbol, a ring deep enough for every quote; a few more than the depth wrap it once
+    QuoteHistory history(1, quoteCount);
+    size_t appendCount = history.depth() + history.depth() / 8;
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    double bid = 100.0;
+    auto appendStart = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < appendCount; ++i) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        // Random walk pulled back towards 100
+        bid += (static_cast<int>((state >> 59) % 7) - 3) * 0.005 - (bid - 100.0) * 0.001;
+        double ask = bid + 0.01 * static_cast<double>(1 + (state >> 40) % 3);
+        // One missing bid in a thousand, like a one-sided book
+        double quotedBid = (state >> 20) % 1000 == 0 ? std::nan("") : bid;
+        history.append(0, static_cast<int64_t>(i) * 1000, quotedBid, ask, static_cast<double>(1 + (state >> 8) % 50),
+                       static_cast<double>(1 + (state >> 14) % 50));
+    }
+    double appendNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - appendStart).count() /
+                      static_cast<double>(appendCount);
+
+    QuoteWindow window = history.latest(0, quoteCount);
+    size_t n = window.size();
+    std::cout << "quotes: " << n << " (" << window.segmentCount << " segment(s)) | kernels: "
+              << QuoteKernels::instructionSet() << " | append: " << std::fixed << std::setprecision(2) << appendNs
+              << " ns/quote" << std::defaultfloat << '\n'
+              << std::endl;
+
+    std::vector<double> out(n);
+    std::vector<double> reference(n);
+    int mismatches = 0;
+
+    std::cout << std::setw(14) << "series" << std::setw(16) << "fill ns/quote" << std::setw(16) << "scalar"
+              << std::setw(10) << "speedup" << std::setw(16) << "stats ns/quote" << std::setw(16) << "scalar"
+              << std::setw(10) << "speedup" << std::endl;
+    for (QuoteSeries series : {QuoteSeries::Bid, QuoteSeries::Mid, QuoteSeries::Spread, QuoteSeries::WeightedMid}) {
+        double fillNs = timePerCall(minSeconds, [&] { QuoteKernels::fill(window, series, out.data()); });
+        double fillScalarNs = timePerCall(minSeconds, [&] { QuoteKernels::scalar::fill(window, series, reference.data()); });
+        SeriesStats stats{};
+        SeriesStats scalarStats{};
+        double statsNs = timePerCall(minSeconds, [&] { stats = QuoteKernels::stats(window, series); });
+        double statsScalarNs = timePerCall(minSeconds, [&] { scalarStats = QuoteKernels::scalar::stats(window, series); });
+
+        for (size_t i = 0; i < n; ++i) {
+            if (!agrees(out[i], reference[i])) {
+                ++mismatches;
+                break;
+            }
+        }
+        if (stats.count != scalarStats.count || !agrees(stats.mean, scalarStats.mean) ||
+            !agrees(stats.stddev, scalarStats.stddev) || stats.min != scalarStats.min || stats.max != scalarStats.max) {
+            std::cerr << seriesName(series) << ": default and scalar stats differ" << std::endl;
+            ++mismatches;
+        }
+
+        double perQuote = static_cast<double>(n);
+        std::cout << std::setw(14) << seriesName(series) << std::fixed << std::setprecision(3)
+                  << std::setw(16) << fillNs / perQuote << std::setw(16) << fillScalarNs / perQuote
+                  << std::setprecision(2) << std::setw(10) << fillScalarNs / fillNs << std::setprecision(3)
+                  << std::setw(16) << statsNs / perQuote << std::setw(16) << statsScalarNs / perQuote
+                  << std::setprecision(2) << std::setw(10) << statsScalarNs / statsNs << std::defaultfloat << std::endl;
+        std::cout << std::setw(14) << "" << "  n=" << stats.count << " mean=" << stats.mean << " stddev=" << stats.stddev
+                  << " min=" << stats.min << " max=" << stats.max << std::endl;
+    }
+
+    // Rolling as it would live: append a quote, then stats of the trailing 1 ms (1000 quotes at the
+    // synthetic 1 us spacing) ending at it
+    int64_t nowNs = static_cast<int64_t>(appendCount) * 1000;
+    double checksum = 0;
+    double rollingNs = timePerCall(minSeconds, [&] {
+        nowNs += 1000;
+        history.append(0, nowNs, bid, bid + 0.01, 10, 10);
+        checksum += QuoteKernels::rollingStats(history, 0, QuoteSeries::Mid, 1000000, nowNs).mean;
+    });
+    std::cout << "\nappend + rolling 1 ms mid stats (1000 quotes): " << std::fixed << std::setprecision(0)
+              << rollingNs << " ns/query" << std::defaultfloat << (checksum == 0 ? " (empty)" : "") << std::endl;
+
+    if (mismatches > 0) {
+        std::cerr << mismatches << " mismatches between default and scalar kernels" << std::endl;
+        return 1;
+    }
+    return 0;
+}
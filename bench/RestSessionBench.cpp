@@ -0,0 +1,70 @@
+// Runs the dxFeedSession REST sequence (authenticate, getQuoteToken, closeSession) against a local
+// stand-in and reports how many TLS handshakes it took. Before the persistent RestConnection every
+// session cost three full handshakes; now it should be one, plus one resumed handshake for every
+// time the server drops the kept-alive stream.
+//
+//   python3 tools/dxlink_standin.py --port 8443 [--close-after 1]
+//
+// Build: g++ -O2 -std=c++17 -I.. RestSessionBench.cpp ../dxFeedSession.cpp ../RestConnection.cpp
+//        ../TokenCache.cpp ../SocketTuning.cpp ../LatencyHistogram.cpp ../SessionTimeline.cpp -lboost_json
+//        -lssl -lcrypto -pthread -o rest_session_bench
+// Usage: rest_session_bench [sessions] [host] [port] [CA file]
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "dxFeedSession.hpp"
+
+int main(int argc, char* argv[]) {
+    int sessions = argc > 1 ? std::atoi(argv[1]) : 20;
+    std::string host = argc > 2 ? argv[2] : "127.0.0.1";
+    std::string port = argc > 3 ? argv[3] : "8443";
+    std::string caFile = argc > 4 ? argv[4] : "../tools/standin-cert.pem";
+
+    // The stand-in accepts any credentials
+    std::string credsPath = "rest_session_bench_creds.json";
+    std::ofstream(credsPath) << R"({"user": ["standin"], "pw": ["standin"]})";
+
+    try {
+        SessionTimeline timeline;
+        RestConnection::Stats total{};
+        for (int i = 0; i < sessions; ++i) {
+            dxFeedSession session(credsPath, host, port);
+            session.setCaFile(caFile);
+            session.authenticate();
+            session.getQuoteToken();
+            session.closeSession();
+
+            timeline.merge(session.timeline());
+            auto stats = session.connectionStats();
+            total.requests += stats.requests;
+            total.handshakes += stats.handshakes;
+            total.resumedHandshakes += stats.resumedHandshakes;
+            total.reconnects += stats.reconnects;
+        }
+
+        // Server-side view; /stats requests are not counted by the stand-in
+        SessionTimeline ignored;
+        RestConnection statsConnection(host, port, ignored);
+        statsConnection.setCaFile(caFile);
+        RestConnection::Request req(boost::beast::http::verb::get, "/stats", 11);
+        auto res = statsConnection.send(req);
+
+        std::cout << "sessions: " << sessions
+                  << " | requests: " << total.requests
+                  << " | TLS handshakes: " << total.handshakes
+                  << " (resumed " << total.resumedHandshakes << ")"
+                  << " | reconnects: " << total.reconnects
+                  << " | handshakes/session: " << static_cast<double>(total.handshakes) / sessions << std::endl;
+        std::cout << "stand-in counters: " << res.body() << std::endl;
+        timeline.report(std::cout);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        std::remove(credsPath.c_str());
+        return 1;
+    }
+
+    std::remove(credsPath.c_str());
+    return 0;
+}
@@ -0,0 +1,76 @@
+// Streams a large symbol universe through ShardedFeedEngine with 1, 2, 4, ... shards and reports
+// per-shard and total quotes/s plus frame and hand-off latency, to show how decoding scales across
+// cores. Needs a stand-in that streams quotes for every subscribed symbol, e.g.
+//
+//   python3 tools/dxlink_standin.py --port 8443 --quote-interval-ms 5 --quotes-per-frame 100
+//
+// The stand-in is single-process Python, so on small machines it saturates before the client does;
+// compare the per-shard frame latency as well as the totals.
+//
+// Build: g++ -O2 -std=c++17 -I.. ShardedFeedBench.cpp ../ShardedFeedEngine.cpp ../dxFeedSession.cpp
+//        ../RestConnection.cpp ../TokenCache.cpp ../MarketDataWebSocket.cpp ../SubscriptionManager.cpp
+//        ../FeedTransport.cpp ../BeastTransport.cpp ../WebsocketppTransport.cpp ../QuoteBook.cpp
+//        ../QuoteDispatcher.cpp ../SocketTuning.cpp ../AsyncLogger.cpp ../FeedMetrics.cpp ../LatencyHistogram.cpp
+//        ../SessionTimeline.cpp ../CompactFeedDecoder.cpp -lboost_json -lssl -lcrypto -pthread -o sharded_feed_bench
+// Usage: sharded_feed_bench [symbols] [max shards] [seconds per run] [port] [CA file]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "dxFeedSession.hpp"
+#include "ShardedFeedEngine.hpp"
+#include "SyntheticFeed.hpp"
+
+int main(int argc, char* argv[]) {
+    size_t symbolCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4000;
+    size_t maxShards = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 4;
+    int seconds = argc > 3 ? std::atoi(argv[3]) : 10;
+    std::string port = argc > 4 ? argv[4] : "8443";
+    std::string caFile = argc > 5 ? argv[5] : "../tools/standin-cert.pem";
+
+    // The stand-in accepts any credentials
+    std::string credsPath = "sharded_feed_bench_creds.json";
+    std::ofstream(credsPath) << R"({"user": ["standin"], "pw": ["standin"]})";
+
+    int status = 0;
+    try {
+        dxFeedSession session(credsPath, "127.0.0.1", port);
+        session.setCaFile(caFile);
+        session.ensureWebsocketToken();
+
+        std::vector<std::string> symbols = syntheticSymbols(symbolCount);
+        for (size_t shards = 1; shards <= maxShards; shards *= 2) {
+            ShardedFeedConfig config;
+            config.wsUrl = "wss://127.0.0.1:" + port + "/realtime";
+            config.token = session.websocketToken;
+            config.caFile = caFile;
+            config.shardCount = shards;
+            config.streaming = true;
+
+            ShardedFeedEngine engine(config, symbols);
+            uint64_t merged = 0;
+            engine.start([&merged](const QuoteRecord&, size_t) { ++merged; });
+            std::this_thread::sleep_for(std::chrono::seconds(seconds));
+            engine.stop();
+            engine.wait();
+
+            std::cout << "=== " << shards << " shard(s), " << symbolCount << " symbols, "
+                      << seconds << " s, " << engine.book().seenCount() << " symbols quoted, "
+                      << merged << " quotes merged" << std::endl;
+            engine.report(std::cout);
+            if (merged == 0) {
+                status = 1;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        status = 1;
+    }
+
+    std::remove(credsPath.c_str());
+    std::remove(TokenCache::pathNextTo(credsPath).c_str());
+    return status;
+}
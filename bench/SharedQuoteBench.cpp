@@ -0,0 +1,244 @@
+// SharedQuotePublisher -> SharedQuoteReader latency across processes on one host. For 1, 2, 4 and
+// 8 reader processes (forked, each attaching to the segment by name like a separate strategy), the
+// publisher writes quotes stamped with monotonicNowNs() at a fixed interval, then as one burst. Every
+// reader records stamp -> read latency and the records it lost to a full ring; per-reader
+// histograms come back over a pipe and are merged. Readers spin on poll() and yield after a short
+// spin, so runs with more readers than CPUs still finish (with the scheduler's latency in them).
+//
+// Build: g++ -O2 -std=c++17 -I.. SharedQuoteBench.cpp ../SharedQuoteBus.cpp ../LatencyHistogram.cpp -lrt
+//        -o shared_quote_bench
+// Usage: shared_quote_bench [quotes per run] [publish interval ns] [ring capacity]
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sched.h>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+#include "LatencyHistogram.hpp"
+#include "MonotonicClock.hpp"
+#include "SharedQuoteBus.hpp"
+#include "ThreadAffinity.hpp"
+
+namespace {
+
+constexpr size_t kSymbols = 64;
+
+struct ReaderResult {
+    LatencyHistogram latency;
+    uint64_t received = 0;
+    uint64_t lost = 0;
+    uint64_t gaps = 0;
+    uint64_t lastValueMismatches = 0;
+};
+
+bool writeAll(int fd, const void* data, size_t size) {
+    const char* p = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t written = ::write(fd, p, size);
+        if (written <= 0) {
+            return false;
+        }
+        p += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+bool readAll(int fd, void* data, size_t size) {
+    char* p = static_cast<char*>(data);
+    while (size > 0) {
+        ssize_t got = ::read(fd, p, size);
+        if (got <= 0) {
+            return false;
+        }
+        p += got;
+        size -= static_cast<size_t>(got);
+    }
+    return true;
+}
+
+// Child process: attach, signal ready, read until the last sequence, report
+[[noreturn]] void runReader(const std::string& name, int index, uint64_t lastSequence, int readyFd, int resultFd) {
+    pinCurrentThread(index + 1);
+    ReaderResult result;
+    try {
+        SharedQuoteReader reader(name);
+        char ready = 1;
+        writeAll(readyFd, &ready, 1);
+        int idlePolls = 0;
+        while (reader.sequence() < lastSequence) {
+            QuoteRecord quote;
+            if (!reader.poll(quote)) {
+                if (++idlePolls > 256) {
+                    if (reader.closed()) {
+                        break;
+                    }
+                    sched_yield();
+                    idlePolls = 0;
+                }
+                continue;
+            }
+            idlePolls = 0;
+            result.latency.recordDuration(quote.receiveTimeNs, monotonicNowNs());
+            ++result.received;
+        }
+        result.lost = reader.lostCount();
+        result.gaps = reader.gapCount();
+        // Once the publisher is done, the last-value table must hold each symbol's final quote: quote i
+        // (sequence i + 1) is for symbol i % kSymbols
+        for (size_t id = 0; id < kSymbols && id < lastSequence; ++id) {
+            QuoteRecord quote;
+            uint64_t sequence = 0;
+            uint64_t expected = lastSequence - (lastSequence - 1 - id) % kSymbols;
+            if (!reader.latest(static_cast<int32_t>(id), quote, &sequence) || sequence != expected) {
+                ++result.lastValueMismatches;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "reader " << index << ": " << e.what() << std::endl;
+    }
+    writeAll(resultFd, &result, sizeof(result));
+    ::_exit(0);
+}
+
+struct RunSummary {
+    LatencyHistogram merged;
+    uint64_t worstP99 = 0;
+    uint64_t received = 0;
+    uint64_t lost = 0;
+    uint64_t gaps = 0;
+    uint64_t lastValueMismatches = 0;
+    double publishNsPerQuote = 0;
+    bool ok = true;
+};
+
+RunSummary runCase(int readers, uint64_t quotes, int64_t intervalNs, size_t ringCapacity) {
+    RunSummary summary;
+    std::string name = "/dxfeed-quote-bench-" + std::to_string(::getpid());
+    SharedQuotePublisher publisher(name, ringCapacity, kSymbols);
+    for (size_t id = 0; id < kSymbols; ++id) {
+        publisher.defineSymbol(static_cast<int32_t>(id), "/SYN" + std::to_string(id) + ":XCME");
+    }
+
+    int readyPipe[2];
+    if (::pipe(readyPipe) != 0) {
+        summary.ok = false;
+        return summary;
+    }
+    std::vector<pid_t> children;
+    std::vector<int> resultFds;
+    for (int i = 0; i < readers; ++i) {
+        int resultPipe[2];
+        if (::pipe(resultPipe) != 0) {
+            summary.ok = false;
+            break;
+        }
+        pid_t pid = ::fork();
+        if (pid == 0) {
+            ::close(readyPipe[0]);
+            ::close(resultPipe[0]);
+            runReader(name, i, quotes, readyPipe[1], resultPipe[1]);
+        }
+        ::close(resultPipe[1]);
+        if (pid < 0) {
+            ::close(resultPipe[0]);
+            summary.ok = false;
+            break;
+        }
+        children.push_back(pid);
+        resultFds.push_back(resultPipe[0]);
+    }
+    ::close(readyPipe[1]);
+    for (size_t i = 0; i < children.size(); ++i) {
+        char ready;
+        if (!readAll(readyPipe[0], &ready, 1)) {
+            summary.ok = false;
+        }
+    }
+    ::close(readyPipe[0]);
+
+    pinCurrentThread(0);
+    QuoteRecord quote{};
+    int64_t startNs = monotonicNowNs();
+    for (uint64_t i = 0; i < quotes; ++i) {
+        if (intervalNs > 0) {
+            int64_t targetNs = startNs + static_cast<int64_t>(i) * intervalNs;
+            while (monotonicNowNs() < targetNs) {
+            }
+        }
+        int32_t id = static_cast<int32_t>(i % kSymbols);
+        quote.symbolId = id;
+        quote.bidPrice = 1.25 + static_cast<double>(i % 100) * 0.0001;
+        quote.askPrice = quote.bidPrice + 0.0001;
+        quote.bidSize = static_cast<double>(1 + i % 50);
+        quote.askSize = static_cast<double>(1 + (i * 3) % 50);
+        quote.receiveTimeNs = monotonicNowNs();
+        publisher.publish(quote);
+    }
+    summary.publishNsPerQuote = static_cast<double>(monotonicNowNs() - startNs) / static_cast<double>(quotes);
+
+    for (size_t i = 0; i < children.size(); ++i) {
+        // Each result is one large histogram; read it before reaping so the child never blocks
+        auto result = std::make_unique<ReaderResult>();
+        if (!readAll(resultFds[i], result.get(), sizeof(ReaderResult))) {
+            summary.ok = false;
+        } else {
+            summary.merged.merge(result->latency);
+            summary.worstP99 = std::max(summary.worstP99, result->latency.percentile(99));
+            summary.received += result->received;
+            summary.lost += result->lost;
+            summary.gaps += result->gaps;
+            summary.lastValueMismatches += result->lastValueMismatches;
+        }
+        ::close(resultFds[i]);
+        int status = 0;
+        ::waitpid(children[i], &status, 0);
+    }
+    return summary;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    uint64_t quotes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    int64_t intervalNs = argc > 2 ? std::atoll(argv[2]) : 1000;
+    size_t ringCapacity = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 65536;
+    long cpus = ::sysconf(_SC_NPROCESSORS_ONLN);
+
+    std::cout << "quotes/run: " << quotes << " | paced interval: " << intervalNs << " ns | ring: " << ringCapacity
+              << " slots | CPUs: " << cpus << '\n'
+              << std::endl;
+    std::cout << std::setw(7) << "mode" << std::setw(9) << "readers" << std::setw(14) << "publish ns/q"
+              << std::setw(10) << "p50 us" << std::setw(10) << "p99 us" << std::setw(11) << "p99.9 us"
+              << std::setw(11) << "max us" << std::setw(16) << "worst rdr p99" << std::setw(12) << "lost"
+              << std::setw(8) << "gaps" << std::endl;
+
+    bool ok = true;
+    for (int readers : {1, 2, 4, 8}) {
+        for (bool paced : {true, false}) {
+            RunSummary summary = runCase(readers, quotes, paced ? intervalNs : 0, ringCapacity);
+            const LatencyHistogram& h = summary.merged;
+            std::cout << std::setw(7) << (paced ? "paced" : "burst") << std::setw(9) << readers << std::fixed
+                      << std::setprecision(1) << std::setw(14) << summary.publishNsPerQuote << std::setprecision(2)
+                      << std::setw(10) << static_cast<double>(h.percentile(50)) / 1000.0
+                      << std::setw(10) << static_cast<double>(h.percentile(99)) / 1000.0
+                      << std::setw(11) << static_cast<double>(h.percentile(99.9)) / 1000.0
+                      << std::setw(11) << static_cast<double>(h.max()) / 1000.0
+                      << std::setw(16) << static_cast<double>(summary.worstP99) / 1000.0 << std::defaultfloat
+                      << std::setw(12) << summary.lost << std::setw(8) << summary.gaps << std::endl;
+            // Every record is either read or counted lost, and the last values are the final quotes
+            uint64_t expected = quotes * static_cast<uint64_t>(readers);
+            if (!summary.ok || summary.received + summary.lost != expected || summary.lastValueMismatches != 0) {
+                std::cerr << "  inconsistent run: received " << summary.received << " + lost " << summary.lost
+                          << " != " << expected << ", last-value mismatches " << summary.lastValueMismatches
+                          << std::endl;
+                ok = false;
+            }
+        }
+    }
+    return ok ? 0 : 1;
+}
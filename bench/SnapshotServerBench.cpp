@@ -0,0 +1,168 @@
+// Round trip of a snapshot request to the daemon's SnapshotServer over its Unix socket, as a
+// SnapshotClient in another process would see it. The server answers from a QuoteBook of 1000
+// quoted symbols while a feed thread keeps updating it (one quote every 100 us).
+//  - warm: requests for 1, 10, 100 and 1000 tracked symbols on one kept-open connection;
+//  - cold: one request per untracked symbol with a wait, answered once the feed thread has
+//    interned it and its first quote arrived after a simulated 1 ms subscription round trip.
+// Every answer is checked: warm entries must be Ok with the book's prices, cold ones Ok in the end.
+//
+// Build: g++ -O2 -std=c++17 -pthread -I.. SnapshotServerBench.cpp ../SnapshotServer.cpp ../SnapshotClient.cpp
+//        ../QuoteBook.cpp ../LatencyHistogram.cpp -o snapshot_server_bench
+// Usage: snapshot_server_bench [requests per case] [cold symbols]
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "LatencyHistogram.hpp"
+#include "MonotonicClock.hpp"
+#include "SnapshotClient.hpp"
+#include "SnapshotServer.hpp"
+#include "SyntheticFeed.hpp"
+
+namespace {
+
+constexpr size_t kTrackedSymbols = 1000;
+constexpr int64_t kSubscribeDelayNs = 1000000;
+
+double bidOf(size_t id) {
+    return 100.0 + static_cast<double>(id);
+}
+
+// Stands in for the feed thread: the only thread that interns into or updates the book
+class FakeFeed {
+public:
+    explicit FakeFeed(QuoteBook& quoteBook) : book(quoteBook), thread([this] { run(); }) {}
+
+    ~FakeFeed() {
+        running = false;
+        thread.join();
+    }
+
+    // SnapshotServer::Subscribe; runs on the server thread
+    void subscribe(const std::vector<std::string>& symbols) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& symbol : symbols) {
+            requested.push_back({symbol, monotonicNowNs() + kSubscribeDelayNs, QuoteBook::kNotFound});
+        }
+    }
+
+private:
+    struct Request {
+        std::string symbol;
+        int64_t firstQuoteNs;
+        int32_t id;
+    };
+
+    QuoteBook& book;
+    std::atomic<bool> running{true};
+    std::mutex mutex;
+    std::vector<Request> requested;
+    std::thread thread;
+
+    void run() {
+        size_t next = 0;
+        while (running) {
+            int64_t now = monotonicNowNs();
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (auto it = requested.begin(); it != requested.end();) {
+                    // Interned at once, like MarketDataWebSocket::addSymbols; quoted after the round trip
+                    if (it->id == QuoteBook::kNotFound) {
+                        it->id = book.intern(it->symbol);
+                    }
+                    if (it->id != QuoteBook::kNotFound && now >= it->firstQuoteNs) {
+                        size_t id = static_cast<size_t>(it->id);
+                        book.update(it->id, bidOf(id), bidOf(id) + 0.5, 1, 1, now);
+                        it = requested.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+            }
+            size_t id = next++ % kTrackedSymbols;
+            book.update(static_cast<int32_t>(id), bidOf(id), bidOf(id) + 0.5, 2, 3, now);
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+};
+
+void printRow(const char* name, size_t symbols, const LatencyHistogram& histogram) {
+    auto us = [](uint64_t ns) { return static_cast<double>(ns) / 1000; };
+    std::cout << std::left << std::setw(8) << name << std::right << std::setw(9) << symbols << std::fixed
+              << std::setprecision(1) << std::setw(11) << us(histogram.percentile(50)) << std::setw(11)
+              << us(histogram.percentile(99)) << std::setw(11) << us(histogram.percentile(99.9)) << std::setw(11)
+              << us(histogram.max()) << std::defaultfloat << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    long requests = argc > 1 ? std::atol(argv[1]) : 20000;
+    long coldSymbols = argc > 2 ? std::atol(argv[2]) : 50;
+    if (requests < 1 || coldSymbols < 0) {
+        std::cerr << "Need at least one request per case" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> symbols = syntheticSymbols(kTrackedSymbols);
+    QuoteBook book(symbols, kTrackedSymbols + static_cast<size_t>(coldSymbols));
+    for (size_t id = 0; id < kTrackedSymbols; ++id) {
+        book.update(static_cast<int32_t>(id), bidOf(id), bidOf(id) + 0.5, 2, 3, monotonicNowNs());
+    }
+    FakeFeed feed(book);
+
+    std::string path = "/tmp/snapshot_server_bench." + std::to_string(::getpid()) + ".sock";
+    SnapshotServer server(path, book, [&feed](const std::vector<std::string>& missing) { feed.subscribe(missing); });
+    SnapshotClient client(path);
+
+    std::cout << "Snapshot round trip over a Unix socket, us\n" << std::endl;
+    std::cout << std::left << std::setw(8) << "case" << std::right << std::setw(9) << "symbols" << std::setw(11)
+              << "p50" << std::setw(11) << "p99" << std::setw(11) << "p99.9" << std::setw(11) << "max" << std::endl;
+
+    bool correct = true;
+    std::vector<SnapshotEntry> entries;
+    for (size_t count : {1, 10, 100, 1000}) {
+        std::vector<std::string> batch(symbols.begin(), symbols.begin() + static_cast<long>(count));
+        LatencyHistogram roundTrips;
+        // Fewer requests for the big batches; each one carries more symbols
+        long runs = std::max<long>(100, requests / static_cast<long>(count > 10 ? count / 10 : 1));
+        for (long i = 0; i < runs; ++i) {
+            int64_t start = monotonicNowNs();
+            client.get(batch, 0, entries);
+            roundTrips.recordDuration(start, monotonicNowNs());
+            for (size_t s = 0; s < count; ++s) {
+                correct = correct && entries[s].ok() && entries[s].bidPrice == bidOf(s);
+            }
+        }
+        printRow("warm", count, roundTrips);
+    }
+
+    if (coldSymbols > 0) {
+        LatencyHistogram roundTrips;
+        for (long i = 0; i < coldSymbols; ++i) {
+            int64_t start = monotonicNowNs();
+            SnapshotEntry entry = client.getOne("COLD" + std::to_string(i), 100000);
+            roundTrips.recordDuration(start, monotonicNowNs());
+            correct = correct && entry.ok() && entry.updateCount == 1;
+        }
+        printRow("cold", 1, roundTrips);
+        std::cout << "(cold includes the simulated " << kSubscribeDelayNs / 1000 << " us subscription round trip)"
+                  << std::endl;
+    }
+
+    SnapshotServer::Stats stats = server.stats();
+    std::cout << "\nServer: " << stats.requests << " requests | " << stats.symbols << " symbols | "
+              << stats.subscribed << " subscribed on demand | " << stats.rejected << " rejected" << std::endl;
+    if (!correct) {
+        std::cerr << "Snapshot answers do not match the book" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,84 @@
+// Runs MarketDataWebSocket in streaming mode against a stand-in that drops or stalls every
+// websocket session on a schedule, then reports reconnects, stalls, keepalives and the reconnect
+// gap (connection lost -> first quote on the new connection).
+//
+//   python3 tools/dxlink_standin.py --port 8443 --quote-interval-ms 10 --keepalive-s 0.5 --drop-every-s 3 [--drop-mode stall]
+//
+// Build: g++ -O2 -std=c++17 -I.. StreamingReconnectBench.cpp ../dxFeedSession.cpp ../RestConnection.cpp
+//        ../TokenCache.cpp ../MarketDataWebSocket.cpp ../SubscriptionManager.cpp ../FeedTransport.cpp
+//        ../BeastTransport.cpp ../WebsocketppTransport.cpp ../QuoteBook.cpp ../QuoteDispatcher.cpp
+//        ../SocketTuning.cpp ../AsyncLogger.cpp ../FeedMetrics.cpp ../LatencyHistogram.cpp ../SessionTimeline.cpp
+//        ../CompactFeedDecoder.cpp -lboost_json -lssl -lcrypto -pthread -o streaming_reconnect_bench
+// Usage: streaming_reconnect_bench [seconds] [port] [CA file]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "dxFeedSession.hpp"
+#include "MarketDataWebSocket.hpp"
+
+int main(int argc, char* argv[]) {
+    int seconds = argc > 1 ? std::atoi(argv[1]) : 20;
+    std::string port = argc > 2 ? argv[2] : "8443";
+    std::string caFile = argc > 3 ? argv[3] : "../tools/standin-cert.pem";
+
+    // The stand-in accepts any credentials
+    std::string credsPath = "streaming_reconnect_bench_creds.json";
+    std::ofstream(credsPath) << R"({"user": ["standin"], "pw": ["standin"]})";
+
+    int status = 0;
+    try {
+        dxFeedSession session(credsPath, "127.0.0.1", port);
+        session.setCaFile(caFile);
+        session.ensureWebsocketToken();
+
+        MarketDataWebSocket wsClient("wss://127.0.0.1:" + port + "/realtime", session.websocketToken, 3);
+        wsClient.setCaFile(caFile);
+        wsClient.setSymbolsToTrack({"/6BZ24:XCME", "/6EZ24:XCME", "/ESZ24:XCME"});
+
+        // Short timeouts so a stalled session is noticed within the run
+        StreamingConfig config;
+        config.keepaliveIntervalMs = 500;
+        config.stallTimeoutMs = 1000;
+        config.reconnectInitialMs = 50;
+        config.reconnectMaxMs = 1000;
+        wsClient.enableStreaming(config);
+
+        size_t quotes = 0;
+        wsClient.quotes().start([&quotes](const QuoteRecord&) { ++quotes; });
+
+        std::thread stopper([&wsClient, seconds] {
+            std::this_thread::sleep_for(std::chrono::seconds(seconds));
+            wsClient.stop();
+        });
+        wsClient.connect();
+        stopper.join();
+        wsClient.quotes().stop();
+
+        auto stats = wsClient.streamingStats();
+        std::cout << "seconds: " << seconds
+                  << " | quotes: " << quotes
+                  << " | dropped: " << wsClient.quotes().stats().dropped
+                  << " | reconnects: " << stats.reconnects
+                  << " | stalls: " << stats.stalls
+                  << " | keepalives sent/received: " << stats.keepalivesSent << "/" << stats.keepalivesReceived
+                  << std::endl;
+        std::cout << "reconnect gap: " << wsClient.timeline().histogram(SessionStage::ReconnectGap).summary()
+                  << std::endl;
+        wsClient.timeline().report(std::cout);
+        if (stats.reconnects == 0) {
+            std::cerr << "No reconnects; is the stand-in running with --drop-every-s?" << std::endl;
+            status = 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        status = 1;
+    }
+
+    std::remove(credsPath.c_str());
+    std::remove(TokenCache::pathNextTo(credsPath).c_str());
+    return status;
+}
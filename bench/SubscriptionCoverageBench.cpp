@@ -0,0 +1,144 @@
+// Time to full coverage of a large subscription against the local stand-in: how long from the
+// first FEED_SUBSCRIPTION frame until every symbol has quoted, for several frame size limits.
+// Then, on one streaming connection, the same for incremental diffs that swap a slice of the
+// universe for new symbols with add/remove frames instead of a resubscribe.
+//
+//   python3 tools/dxlink_standin.py --port 8443 --quotes-per-frame 500 --max-message-bytes 65536
+//
+// With --max-message-bytes the unbounded case shows what a single-frame subscription of the whole
+// list runs into.
+//
+// Build: g++ -O2 -std=c++17 -I.. SubscriptionCoverageBench.cpp ../dxFeedSession.cpp ../RestConnection.cpp
+//        ../TokenCache.cpp ../MarketDataWebSocket.cpp ../SubscriptionManager.cpp ../FeedTransport.cpp
+//        ../BeastTransport.cpp ../WebsocketppTransport.cpp ../QuoteBook.cpp ../QuoteDispatcher.cpp
+//        ../SocketTuning.cpp ../AsyncLogger.cpp ../FeedMetrics.cpp ../LatencyHistogram.cpp ../SessionTimeline.cpp
+//        ../CompactFeedDecoder.cpp -lboost_json -lssl -lcrypto -pthread -o subscription_coverage_bench
+// Usage: subscription_coverage_bench [symbols] [port] [CA file] [diff rounds] [diff size]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "dxFeedSession.hpp"
+#include "MarketDataWebSocket.hpp"
+#include "SyntheticFeed.hpp"
+
+namespace {
+
+bool waitFor(MarketDataWebSocket& wsClient, uint64_t framesAtLeast, int timeoutMs) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (std::chrono::steady_clock::now() < deadline) {
+        SubscriptionCoverage coverage = wsClient.subscriptionCoverage();
+        if (coverage.framesSent >= framesAtLeast && coverage.subscribed != 0 && coverage.live == coverage.subscribed) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    return false;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t symbolCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000;
+    std::string port = argc > 2 ? argv[2] : "8443";
+    std::string caFile = argc > 3 ? argv[3] : "../tools/standin-cert.pem";
+    int diffRounds = argc > 4 ? std::atoi(argv[4]) : 10;
+    size_t diffSize = argc > 5 ? std::strtoull(argv[5], nullptr, 10) : 1000;
+
+    // The stand-in accepts any credentials
+    std::string credsPath = "subscription_coverage_bench_creds.json";
+    std::ofstream(credsPath) << R"({"user": ["standin"], "pw": ["standin"]})";
+
+    int status = 0;
+    try {
+        dxFeedSession session(credsPath, "127.0.0.1", port);
+        session.setCaFile(caFile);
+        session.ensureWebsocketToken();
+        std::string url = "wss://127.0.0.1:" + port + "/realtime";
+        std::vector<std::string> symbols = syntheticSymbols(symbolCount);
+
+        // Snapshot runs: connect() returns once every symbol has quoted or the connection is gone
+        for (size_t frameBytes : {size_t(1) << 30, size_t(256) << 10, size_t(64) << 10, size_t(16) << 10}) {
+            MarketDataWebSocket wsClient(url, session.websocketToken, 3);
+            wsClient.setCaFile(caFile);
+            wsClient.setSymbolsToTrack(symbols);
+            wsClient.setMaxSubscriptionFrameBytes(frameBytes);
+            wsClient.quotes().start([](const QuoteRecord&) {});
+            wsClient.connect();
+            wsClient.quotes().stop();
+
+            SubscriptionCoverage coverage = wsClient.subscriptionCoverage();
+            const LatencyHistogram& fullCoverage = wsClient.timeline().histogram(SessionStage::SubscriptionToFullCoverage);
+            std::cout << "max frame " << (frameBytes >= (size_t(1) << 30) ? std::string("unbounded")
+                                                                           : std::to_string(frameBytes >> 10) + " KiB")
+                      << " | frames: " << coverage.framesSent << " | live: " << coverage.live << "/"
+                      << coverage.subscribed;
+            if (fullCoverage.count() > 0) {
+                std::cout << " | full coverage: " << static_cast<double>(fullCoverage.max()) / 1e6 << " ms" << std::endl;
+            } else {
+                std::cout << " | never fully covered" << std::endl;
+            }
+        }
+
+        // Incremental diffs on one streaming connection
+        MarketDataWebSocket wsClient(url, session.websocketToken, 3);
+        wsClient.setCaFile(caFile);
+        wsClient.setSymbolsToTrack(symbols, symbolCount + static_cast<size_t>(diffRounds) * diffSize);
+        wsClient.enableStreaming();
+        wsClient.quotes().start([](const QuoteRecord&) {});
+        std::thread feed([&wsClient] { wsClient.connect(); });
+
+        int completed = 0;
+        if (waitFor(wsClient, 1, 30000)) {
+            size_t nextNew = 0;
+            for (int round = 0; round < diffRounds; ++round) {
+                // Swap the oldest diffSize symbols still subscribed for new ones
+                size_t first = std::min(symbolCount, static_cast<size_t>(round) * diffSize);
+                size_t last = std::min(symbolCount, first + diffSize);
+                std::vector<std::string> removed(symbols.begin() + static_cast<long>(first),
+                                                 symbols.begin() + static_cast<long>(last));
+                std::vector<std::string> added;
+                for (size_t i = 0; i < diffSize; ++i) {
+                    added.push_back("/NEW" + std::to_string(nextNew++) + ":XCME");
+                }
+                uint64_t framesBefore = wsClient.subscriptionCoverage().framesSent;
+                wsClient.removeSymbols(removed);
+                wsClient.addSymbols(added);
+                if (!waitFor(wsClient, framesBefore + 1, 30000)) {
+                    std::cerr << "Diff round " << round << " did not reach full coverage" << std::endl;
+                    break;
+                }
+                ++completed;
+            }
+        } else {
+            std::cerr << "Initial subscription did not reach full coverage" << std::endl;
+        }
+        wsClient.stop();
+        feed.join();
+        wsClient.quotes().stop();
+
+        SubscriptionCoverage coverage = wsClient.subscriptionCoverage();
+        std::cout << "diffs: " << completed << "/" << diffRounds << " rounds of -" << diffSize << "/+" << diffSize
+                  << " | frames: " << coverage.framesSent << " | live: " << coverage.live << "/"
+                  << coverage.subscribed << std::endl;
+        // The first sample is the initial subscription, the rest are the diffs
+        std::cout << "full coverage (initial + diffs): "
+                  << wsClient.timeline().histogram(SessionStage::SubscriptionToFullCoverage).summary() << std::endl;
+        wsClient.timeline().report(std::cout);
+        if (completed != diffRounds) {
+            status = 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        status = 1;
+    }
+
+    std::remove(credsPath.c_str());
+    std::remove(TokenCache::pathNextTo(credsPath).c_str());
+    return status;
+}
@@ -0,0 +1,72 @@
+#ifndef SYNTHETICFEED_HPP
+#define SYNTHETICFEED_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Pre-generated dxLink COMPACT FEED_DATA frames for offline benchmarks
+struct SyntheticFeedConfig {
+    size_t symbolCount = 1;
+    size_t quotesPerFrame = 1;
+    double nanRatio = 0.0;   // Fraction of price/size fields sent as "NaN"
+    size_t frameCount = 1024;
+    int64_t channel = 3;
+};
+
+inline std::string syntheticSymbol(size_t index) {
+    return "/SYN" + std::to_string(index) + ":XCME";
+}
+
+inline std::vector<std::string> syntheticSymbols(size_t count) {
+    std::vector<std::string> symbols;
+    symbols.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        symbols.push_back(syntheticSymbol(i));
+    }
+    return symbols;
+}
+
+// Frames cycle through the symbols in order, so every symbol is quoted once per symbolCount quotes
+inline std::vector<std::string> makeSyntheticFrames(const SyntheticFeedConfig& config) {
+    // Small deterministic LCG so runs are comparable
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    auto nextUnit = [&state]() {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        return static_cast<double>(state >> 11) / 9007199254740992.0;
+    };
+    auto field = [&](double value) {
+        if (config.nanRatio > 0 && nextUnit() < config.nanRatio) {
+            return std::string("\"NaN\"");
+        }
+        std::string text = std::to_string(value);
+        // Trim the fixed six decimals to something closer to what dxLink sends
+        while (text.size() > 1 && text.back() == '0' && text[text.size() - 2] != '.') {
+            text.pop_back();
+        }
+        return text;
+    };
+
+    std::vector<std::string> frames;
+    frames.reserve(config.frameCount);
+    size_t symbolIndex = 0;
+    for (size_t f = 0; f < config.frameCount; ++f) {
+        std::string frame = "{\"type\":\"FEED_DATA\",\"channel\":" + std::to_string(config.channel) +
+                            ",\"data\":[\"Quote\",[";
+        for (size_t q = 0; q < config.quotesPerFrame; ++q) {
+            double bid = 1.25 + static_cast<double>((symbolIndex * 7 + f) % 1000) * 0.0001;
+            if (q > 0) {
+                frame += ",";
+            }
+            frame += "\"Quote\",\"" + syntheticSymbol(symbolIndex) + "\"," + field(bid) + "," +
+                     field(bid + 0.0001) + "," + field(static_cast<double>(1 + (f + q) % 50)) + "," +
+                     field(static_cast<double>(1 + (f * 3 + q) % 50));
+            symbolIndex = (symbolIndex + 1) % config.symbolCount;
+        }
+        frame += "]]}";
+        frames.push_back(std::move(frame));
+    }
+    return frames;
+}
+
+#endif // SYNTHETICFEED_HPP
@@ -0,0 +1,274 @@
+// A/B of the websocket transports behind MarketDataWebSocket on loopback. An in-process Beast TLS
+// websocket server pushes pre-serialized COMPACT FEED_DATA frames as fast as it can after every
+// upgrade and then closes; each transport reconnects for the next round from its close handler,
+// the way streaming mode does. Reports received msgs/s, client thread CPU ns per message and heap
+// allocations per message, kernel receive -> onMessage latency where the transport reads kernel
+// timestamps (beast; sampled every 64th message, so queueing behind a saturating sender is in it),
+// then the connect/TLS/upgrade stages of every connection.
+//
+// Uses the stand-in certificate (tools/dxlink_standin.py creates it on its first run).
+//
+// Build: g++ -O2 -std=c++17 -I.. TransportBench.cpp ../FeedTransport.cpp ../BeastTransport.cpp
+//        ../WebsocketppTransport.cpp ../SocketTuning.cpp ../LatencyHistogram.cpp ../SessionTimeline.cpp
+//        ../AsyncLogger.cpp -lssl -lcrypto -pthread -o transport_bench
+// Usage: transport_bench [frames per round] [rounds] [cert file] [key file] [transport...]
+#include <atomic>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/ssl.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/ssl.hpp>
+#include <boost/beast/websocket.hpp>
+#include <boost/beast/websocket/ssl.hpp>
+#include "FeedTransport.hpp"
+#include "LatencyHistogram.hpp"
+#include "MonotonicClock.hpp"
+#include "SyntheticFeed.hpp"
+
+namespace {
+std::atomic<uint64_t> allocationCount{0};
+thread_local bool countAllocations = false;
+}
+
+void* operator new(size_t size) {
+    if (countAllocations) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (void* p = std::malloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+namespace beast = boost::beast;
+namespace websocket = boost::beast::websocket;
+using boost::asio::ip::tcp;
+
+int64_t threadCpuNowNs() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+// Serves a fixed number of connections one after the other on its own thread, blocking I/O
+class LoopbackFeedServer {
+public:
+    LoopbackFeedServer(const std::string& certFile, const std::string& keyFile, const std::vector<std::string>& frames,
+                       size_t framesPerConnection, int connections)
+        : sslContext(boost::asio::ssl::context::tls_server),
+          acceptor(ioc, tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0)),
+          frames(frames), framesPerConnection(framesPerConnection), connections(connections) {
+        sslContext.use_certificate_chain_file(certFile);
+        sslContext.use_private_key_file(keyFile, boost::asio::ssl::context::pem);
+        thread = std::thread([this] { serve(); });
+    }
+
+    ~LoopbackFeedServer() {
+        boost::system::error_code ec;
+        acceptor.close(ec);
+        thread.join();
+    }
+
+    unsigned short port() const { return acceptor.local_endpoint().port(); }
+
+private:
+    boost::asio::io_context ioc;
+    boost::asio::ssl::context sslContext;
+    tcp::acceptor acceptor;
+    const std::vector<std::string>& frames;
+    size_t framesPerConnection;
+    int connections;
+    std::thread thread;
+
+    void serve() {
+        for (int i = 0; i < connections; ++i) {
+            try {
+                tcp::socket socket(ioc);
+                acceptor.accept(socket);
+                socket.set_option(tcp::no_delay(true));
+                websocket::stream<beast::ssl_stream<tcp::socket>> ws(std::move(socket), sslContext);
+                ws.next_layer().handshake(boost::asio::ssl::stream_base::server);
+                ws.accept();
+                ws.text(true);
+                for (size_t f = 0; f < framesPerConnection; ++f) {
+                    ws.write(boost::asio::buffer(frames[f % frames.size()]));
+                }
+                // Waits for the client's close reply, so every frame has been read by then
+                ws.close(websocket::close_code::normal);
+            } catch (const std::exception& e) {
+                if (acceptor.is_open()) {
+                    std::cerr << "Server connection " << i << ": " << e.what() << std::endl;
+                }
+            }
+        }
+    }
+};
+
+struct TransportResult {
+    double messagesPerSecond = 0;
+    double cpuNsPerMessage = 0;
+    double allocationsPerMessage = 0;
+    uint64_t messages = 0;
+    int connections = 0;
+    bool bytesMatch = false;
+    LatencyHistogram kernelLatency;   // Empty for transports without kernel timestamps
+};
+
+TransportResult runTransport(TransportKind kind, const std::string& url, const std::string& caFile,
+                             size_t framesPerRound, int rounds, uint64_t expectedBytes, SessionTimeline& timeline) {
+    std::unique_ptr<FeedTransport> transport = makeFeedTransport(kind, timeline);
+    transport->setCaFile(caFile);
+
+    TransportResult result;
+    size_t roundMessages = 0;
+    uint64_t bytes = 0;
+    int64_t wallStartNs = 0;
+    int64_t cpuStartNs = 0;
+    uint64_t allocationsStart = 0;
+    int64_t wallNs = 0;
+    int64_t cpuNs = 0;
+    uint64_t allocations = 0;
+    int round = 0;
+
+    TransportHandlers handlers;
+    handlers.onOpen = [&] {
+        roundMessages = 0;
+        ++result.connections;
+    };
+    handlers.onMessage = [&](std::string_view payload) {
+        bytes += payload.size();
+        if ((roundMessages & 63) == 0) {
+            if (int64_t kernelNs = transport->kernelReceiveNs(); kernelNs > 0) {
+                result.kernelLatency.recordDuration(kernelNs, monotonicNowNs());
+            }
+        }
+        // The first message of a round starts the clock, so connection setup is not counted
+        if (++roundMessages == 1) {
+            wallStartNs = monotonicNowNs();
+            cpuStartNs = threadCpuNowNs();
+            allocationsStart = allocationCount.load(std::memory_order_relaxed);
+        } else if (roundMessages == framesPerRound) {
+            wallNs += monotonicNowNs() - wallStartNs;
+            cpuNs += threadCpuNowNs() - cpuStartNs;
+            allocations += allocationCount.load(std::memory_order_relaxed) - allocationsStart;
+            result.messages += framesPerRound - 1;
+        }
+    };
+    handlers.onClose = [&](const char* reason) {
+        if (roundMessages != framesPerRound) {
+            std::cerr << transport->name() << ": connection " << reason << " after " << roundMessages
+                      << " messages" << std::endl;
+        }
+        if (++round < rounds) {
+            transport->open(url, "");
+        } else {
+            transport->stop();
+        }
+    };
+    transport->setHandlers(std::move(handlers));
+
+    countAllocations = true;
+    transport->open(url, "");
+    transport->run();
+    countAllocations = false;
+
+    if (result.messages > 0) {
+        result.messagesPerSecond = static_cast<double>(result.messages) * 1e9 / static_cast<double>(wallNs);
+        result.cpuNsPerMessage = static_cast<double>(cpuNs) / static_cast<double>(result.messages);
+        result.allocationsPerMessage = static_cast<double>(allocations) / static_cast<double>(result.messages);
+    }
+    result.bytesMatch = bytes == expectedBytes;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t framesPerRound = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    int rounds = argc > 2 ? std::atoi(argv[2]) : 5;
+    std::string certFile = argc > 3 ? argv[3] : "../tools/standin-cert.pem";
+    std::string keyFile = argc > 4 ? argv[4] : "../tools/standin-key.pem";
+    std::vector<TransportKind> kinds;
+    for (int i = 5; i < argc; ++i) {
+        TransportKind kind;
+        if (!parseTransportKind(argv[i], kind)) {
+            std::cerr << "Unknown transport: " << argv[i] << std::endl;
+            return 1;
+        }
+        kinds.push_back(kind);
+    }
+    if (kinds.empty()) {
+        kinds = {TransportKind::Websocketpp, TransportKind::Beast};
+    }
+    if (framesPerRound < 2 || rounds < 1) {
+        std::cerr << "Need at least 2 frames per round and 1 round" << std::endl;
+        return 1;
+    }
+
+    std::vector<SessionTimeline> timelines(kinds.size());
+    int failures = 0;
+    try {
+        std::cout << std::setw(12) << "transport" << std::setw(12) << "quotes/frm" << std::setw(12) << "bytes/msg"
+                  << std::setw(14) << "msgs/s" << std::setw(14) << "cpu ns/msg" << std::setw(14) << "allocs/msg"
+                  << std::setw(15) << "kernel p50 us" << std::setw(15) << "kernel p99 us" << std::endl;
+
+        for (size_t quotesPerFrame : {1, 10, 100}) {
+            SyntheticFeedConfig config;
+            config.symbolCount = 1000;
+            config.quotesPerFrame = quotesPerFrame;
+            config.frameCount = 512;
+            std::vector<std::string> frames = makeSyntheticFrames(config);
+
+            uint64_t bytesPerRound = 0;
+            for (size_t f = 0; f < framesPerRound; ++f) {
+                bytesPerRound += frames[f % frames.size()].size();
+            }
+
+            for (size_t k = 0; k < kinds.size(); ++k) {
+                LoopbackFeedServer server(certFile, keyFile, frames, framesPerRound, rounds);
+                std::string url = "wss://127.0.0.1:" + std::to_string(server.port()) + "/realtime";
+                TransportResult result = runTransport(kinds[k], url, certFile, framesPerRound, rounds,
+                                                      bytesPerRound * static_cast<uint64_t>(rounds), timelines[k]);
+                if (result.connections != rounds || !result.bytesMatch) {
+                    std::cerr << transportKindName(kinds[k]) << ": " << result.connections << "/" << rounds
+                              << " connections, payload bytes " << (result.bytesMatch ? "match" : "differ")
+                              << std::endl;
+                    ++failures;
+                }
+                std::cout << std::setw(12) << transportKindName(kinds[k]) << std::setw(12) << quotesPerFrame
+                          << std::setw(12) << bytesPerRound / framesPerRound << std::fixed << std::setprecision(0)
+                          << std::setw(14) << result.messagesPerSecond << std::setprecision(1)
+                          << std::setw(14) << result.cpuNsPerMessage << std::setprecision(2)
+                          << std::setw(14) << result.allocationsPerMessage;
+                if (result.kernelLatency.count() > 0) {
+                    std::cout << std::setprecision(1)
+                              << std::setw(15) << static_cast<double>(result.kernelLatency.percentile(50)) / 1000.0
+                              << std::setw(15) << static_cast<double>(result.kernelLatency.percentile(99)) / 1000.0;
+                } else {
+                    std::cout << std::setw(15) << "-" << std::setw(15) << "-";
+                }
+                std::cout << std::defaultfloat << std::endl;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    for (size_t k = 0; k < kinds.size(); ++k) {
+        std::cout << '\n' << transportKindName(kinds[k]) << " connection stages:\n";
+        timelines[k].report(std::cout);
+    }
+    return failures == 0 ? 0 : 2;
+}
@@ -0,0 +1,244 @@
+// Feed thread wake-up latency and jitter, blocking event loop vs busy-poll. An in-process Beast TLS
+// websocket server on loopback sends one small COMPACT FEED_DATA frame every interval, sleeping in
+// between, so the client is idle when each frame lands: the case where a blocking loop has to be
+// woken by the scheduler. The client is BeastTransport run each way (and pinned to a CPU when one is
+// given); every message's kernel receive -> onMessage time is recorded. Reports its percentiles, the
+// p99.9 - p50 spread as jitter, and how much of its core the feed thread used.
+//
+// The server thread and this process's other threads are kept off the feed CPU. With a single CPU the
+// busy-poll loop competes with the server for it and the comparison is meaningless.
+// Uses the stand-in certificate (tools/dxlink_standin.py creates it on its first run).
+//
+// Build: g++ -O2 -std=c++17 -I.. WakeupLatencyBench.cpp ../FeedTransport.cpp ../BeastTransport.cpp
+//        ../WebsocketppTransport.cpp ../SocketTuning.cpp ../LatencyHistogram.cpp ../SessionTimeline.cpp
+//        ../AsyncLogger.cpp -lssl -lcrypto -pthread -o wakeup_latency_bench
+// Usage: wakeup_latency_bench [frames] [interval us] [feed cpu, -1: unpinned] [SO_BUSY_POLL us]
+//        [cert file] [key file]
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/ssl.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/ssl.hpp>
+#include <boost/beast/websocket.hpp>
+#include <boost/beast/websocket/ssl.hpp>
+#include "FeedTransport.hpp"
+#include "LatencyHistogram.hpp"
+#include "MonotonicClock.hpp"
+#include "SyntheticFeed.hpp"
+#include "ThreadAffinity.hpp"
+
+namespace {
+
+namespace beast = boost::beast;
+namespace websocket = boost::beast::websocket;
+using boost::asio::ip::tcp;
+
+constexpr size_t kWarmupFrames = 200;   // Connection setup and first-touch page faults
+
+int64_t threadCpuNowNs() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+// Serves a fixed number of connections one after the other, each a paced run of frames
+class PacedFeedServer {
+public:
+    PacedFeedServer(const std::string& certFile, const std::string& keyFile, const std::vector<std::string>& frames,
+                    size_t framesPerConnection, std::chrono::microseconds interval, int connections)
+        : sslContext(boost::asio::ssl::context::tls_server),
+          acceptor(ioc, tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0)),
+          frames(frames), framesPerConnection(framesPerConnection), interval(interval), connections(connections) {
+        sslContext.use_certificate_chain_file(certFile);
+        sslContext.use_private_key_file(keyFile, boost::asio::ssl::context::pem);
+        thread = std::thread([this] { serve(); });
+    }
+
+    ~PacedFeedServer() {
+        boost::system::error_code ec;
+        acceptor.close(ec);
+        thread.join();
+    }
+
+    unsigned short port() const { return acceptor.local_endpoint().port(); }
+
+private:
+    boost::asio::io_context ioc;
+    boost::asio::ssl::context sslContext;
+    tcp::acceptor acceptor;
+    const std::vector<std::string>& frames;
+    size_t framesPerConnection;
+    std::chrono::microseconds interval;
+    int connections;
+    std::thread thread;
+
+    void serve() {
+        for (int i = 0; i < connections; ++i) {
+            try {
+                tcp::socket socket(ioc);
+                acceptor.accept(socket);
+                socket.set_option(tcp::no_delay(true));
+                websocket::stream<beast::ssl_stream<tcp::socket>> ws(std::move(socket), sslContext);
+                ws.next_layer().handshake(boost::asio::ssl::stream_base::server);
+                ws.accept();
+                ws.text(true);
+                // Absolute deadlines, so a late wake-up here does not shift the frames after it
+                auto next = std::chrono::steady_clock::now();
+                for (size_t f = 0; f < framesPerConnection; ++f) {
+                    next += interval;
+                    std::this_thread::sleep_until(next);
+                    ws.write(boost::asio::buffer(frames[f % frames.size()]));
+                }
+                ws.close(websocket::close_code::normal);
+            } catch (const std::exception& e) {
+                if (acceptor.is_open()) {
+                    std::cerr << "Server connection " << i << ": " << e.what() << std::endl;
+                }
+            }
+        }
+    }
+};
+
+struct Mode {
+    std::string name;
+    EventLoopConfig eventLoop;
+};
+
+struct ModeResult {
+    LatencyHistogram wakeup;
+    uint64_t messages = 0;
+    double cpuShare = 0;      // Feed thread CPU time / wall time
+    bool pinned = false;
+};
+
+ModeResult runMode(const Mode& mode, const std::string& url, const std::string& caFile, size_t frames,
+                   int busyPollMicros) {
+    SessionTimeline timeline;
+    std::unique_ptr<FeedTransport> transport = makeFeedTransport(TransportKind::Beast, timeline);
+    transport->setCaFile(caFile);
+    SocketTuning tuning;
+    tuning.busyPollMicros = busyPollMicros;
+    transport->setSocketTuning(tuning);
+
+    ModeResult result;
+    int64_t wallStartNs = 0;
+    int64_t cpuStartNs = 0;
+    int64_t wallNs = 0;
+    int64_t cpuNs = 0;
+
+    TransportHandlers handlers;
+    handlers.onOpen = [] {};
+    handlers.onMessage = [&](std::string_view) {
+        int64_t nowNs = monotonicNowNs();
+        if (++result.messages <= kWarmupFrames) {
+            if (result.messages == kWarmupFrames) {
+                wallStartNs = nowNs;
+                cpuStartNs = threadCpuNowNs();
+            }
+            return;
+        }
+        if (int64_t kernelNs = transport->kernelReceiveNs(); kernelNs > 0) {
+            result.wakeup.recordDuration(kernelNs, nowNs);
+        }
+        if (result.messages == frames) {
+            wallNs = monotonicNowNs() - wallStartNs;
+            cpuNs = threadCpuNowNs() - cpuStartNs;
+        }
+    };
+    handlers.onClose = [&](const char*) { transport->stop(); };
+    transport->setHandlers(std::move(handlers));
+
+    std::optional<ScopedCpuPin> pin;
+    if (mode.eventLoop.cpu >= 0) {
+        pin.emplace(mode.eventLoop.cpu);
+        result.pinned = pin->pinned();
+    }
+    transport->open(url, "");
+    if (mode.eventLoop.busyPoll) {
+        transport->runBusyPoll();
+    } else {
+        transport->run();
+    }
+    if (wallNs > 0) {
+        result.cpuShare = static_cast<double>(cpuNs) / static_cast<double>(wallNs);
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t frames = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000;
+    int intervalUs = argc > 2 ? std::atoi(argv[2]) : 200;
+    int feedCpu = argc > 3 ? std::atoi(argv[3]) : -1;
+    int busyPollMicros = argc > 4 ? std::atoi(argv[4]) : 0;
+    std::string certFile = argc > 5 ? argv[5] : "../tools/standin-cert.pem";
+    std::string keyFile = argc > 6 ? argv[6] : "../tools/standin-key.pem";
+    if (frames <= kWarmupFrames || intervalUs < 1) {
+        std::cerr << "Need more than " << kWarmupFrames << " frames and an interval of at least 1 us" << std::endl;
+        return 1;
+    }
+
+    std::vector<Mode> modes = {{"blocking", {false, -1}}, {"busy-poll", {true, -1}}};
+    if (feedCpu >= 0) {
+        modes.push_back({"blocking, pinned", {false, feedCpu}});
+        modes.push_back({"busy-poll, pinned", {true, feedCpu}});
+        // The server thread starts after this and inherits the mask
+        if (!excludeCpuFromCurrentThread(feedCpu)) {
+            std::cerr << "Could not keep the server off CPU " << feedCpu << std::endl;
+        }
+    }
+
+    SyntheticFeedConfig config;
+    config.symbolCount = 100;
+    config.frameCount = 512;
+    std::vector<std::string> feedFrames = makeSyntheticFrames(config);
+
+    std::cout << frames << " frames, one every " << intervalUs << " us | SO_BUSY_POLL " << busyPollMicros
+              << " us | CPUs: " << ::sysconf(_SC_NPROCESSORS_ONLN) << '\n' << std::endl;
+    std::cout << std::left << std::setw(20) << "mode" << std::right << std::setw(10) << "msgs"
+              << std::setw(10) << "p50 us" << std::setw(10) << "p99 us" << std::setw(11) << "p99.9 us"
+              << std::setw(10) << "max us" << std::setw(12) << "jitter us" << std::setw(8) << "cpu %" << std::endl;
+
+    int failures = 0;
+    try {
+        PacedFeedServer server(certFile, keyFile, feedFrames, frames, std::chrono::microseconds(intervalUs),
+                               static_cast<int>(modes.size()));
+        std::string url = "wss://127.0.0.1:" + std::to_string(server.port()) + "/realtime";
+        for (const Mode& mode : modes) {
+            ModeResult result = runMode(mode, url, certFile, frames, busyPollMicros);
+            const LatencyHistogram& wakeup = result.wakeup;
+            std::cout << std::left << std::setw(20) << mode.name << std::right << std::setw(10) << result.messages
+                      << std::fixed << std::setprecision(1)
+                      << std::setw(10) << static_cast<double>(wakeup.percentile(50)) / 1000.0
+                      << std::setw(10) << static_cast<double>(wakeup.percentile(99)) / 1000.0
+                      << std::setw(11) << static_cast<double>(wakeup.percentile(99.9)) / 1000.0
+                      << std::setw(10) << static_cast<double>(wakeup.max()) / 1000.0
+                      << std::setw(12)
+                      << static_cast<double>(wakeup.percentile(99.9) - wakeup.percentile(50)) / 1000.0
+                      << std::setprecision(0) << std::setw(8) << result.cpuShare * 100 << std::defaultfloat;
+            if (mode.eventLoop.cpu >= 0 && !result.pinned) {
+                std::cout << "  (not pinned)";
+            }
+            std::cout << std::endl;
+            if (result.messages != frames || wakeup.count() == 0) {
+                std::cerr << mode.name << ": " << result.messages << "/" << frames << " messages, "
+                          << wakeup.count() << " kernel stamps" << std::endl;
+                ++failures;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return failures == 0 ? 0 : 2;
+}
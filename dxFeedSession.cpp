@@ -8,22 +8,26 @@
 #include <boost/beast/http.hpp>
 #include <boost/beast/ssl.hpp>
 #include <boost/json.hpp>
+#include "MonotonicClock.hpp"
 
 namespace http = boost::beast::http;
 namespace json = boost::json;
 
 // Constants
-const std::string SESSION_URL = "https://api.tastyworks.com/sessions";
-const std::string QUOTE_TOKEN_URL = "https://api.tastyworks.com/api-quote-tokens";
+// Request targets on the API host RestConnection is bound to
+const std::string SESSION_PATH = "/sessions";
+const std::string QUOTE_TOKEN_PATH = "/api-quote-tokens";
+const int64_t kDefaultTokenLifetimeSeconds = 24 * 60 * 60;
 
-boost::json::value dxFeedSession::loadConfig() {
-    std::string configPath =
+std::string dxFeedSession::defaultConfigPath() {
 #ifdef __APPLE__
-        "/Users/michaelkilchenmann/Library/Mobile Documents/com~apple~CloudDocs/C_Code/J_Workbench/TT-px-snapshot-latency/creds.json";
+    return "/Users/michaelkilchenmann/Library/Mobile Documents/com~apple~CloudDocs/C_Code/J_Workbench/TT-px-snapshot-latency/creds.json";
 #else
-        "/home/ec2-user/tt/creds.json";
+    return "/home/ec2-user/tt/creds.json";
 #endif
+}
 
+boost::json::value dxFeedSession::loadConfig(const std::string& configPath) {
     std::ifstream file(configPath);
     if (!file.is_open()) {
         throw std::runtime_error("Failed to open configuration file at: " + configPath);
@@ -51,28 +55,63 @@ boost::json::value dxFeedSession::loadConfig() {
 }
 
 
-dxFeedSession::dxFeedSession() {
-    auto config = loadConfig();
+dxFeedSession::dxFeedSession(const std::string& configPath, const std::string& apiHost, const std::string& apiPort)
+    : rest(apiHost, apiPort, sessionTimeline),
+      tokenCache(TokenCache::pathNextTo(configPath)) {
+    auto config = loadConfig(configPath);
     auto userArray = config.at("user").as_array();
     auto passwordArray = config.at("pw").as_array();
 
     user = json::value_to<std::string>(userArray[0]);
     password = json::value_to<std::string>(passwordArray[0]);
+
+    tokenCache.load();
 }
 
-void dxFeedSession::authenticate() {
-    try {
-        boost::asio::io_context ioc;
-        boost::asio::ssl::context ssl_context(boost::asio::ssl::context::tlsv12_client);
-        ssl_context.set_default_verify_paths();
-        ssl_context.set_verify_mode(boost::asio::ssl::verify_peer);
+TokenSource dxFeedSession::ensureWebsocketToken() {
+    int64_t now = TokenCache::nowSeconds() + TokenCache::kExpiryMarginSeconds;
+
+    if (tokenCache.websocketToken.validAt(now)) {
+        websocketToken = tokenCache.websocketToken.token;
+        sessionToken = tokenCache.sessionToken.token;
+        lastTokenSource = TokenSource::Cache;
+        return lastTokenSource;
+    }
+
+    if (tokenCache.sessionToken.validAt(now)) {
+        sessionToken = tokenCache.sessionToken.token;
+        try {
+            getQuoteToken();
+            lastTokenSource = TokenSource::QuoteToken;
+            return lastTokenSource;
+        } catch (const std::exception&) {
+            // The cached session was revoked server-side; fall through to a full login
+            tokenCache.sessionToken = TokenCache::Entry{};
+        }
+    }
+
+    authenticate();
+    getQuoteToken();
+    lastTokenSource = TokenSource::Login;
+    return lastTokenSource;
+}
 
-        boost::beast::ssl_stream<boost::beast::tcp_stream> stream(ioc, ssl_context);
-        boost::asio::ip::tcp::resolver resolver(ioc);
-        auto const results = resolver.resolve("api.tastyworks.com", "443");
-        boost::beast::get_lowest_layer(stream).connect(results);
-        stream.handshake(boost::asio::ssl::stream_base::client);
+void dxFeedSession::invalidateCachedTokens() {
+    tokenCache.clear();
+    tokenCache.save();
+}
+
+const char* dxFeedSession::tokenSourceName(TokenSource source) {
+    switch (source) {
+        case TokenSource::Cache: return "cache";
+        case TokenSource::QuoteToken: return "quote-token";
+        case TokenSource::Login: return "login";
+    }
+    return "unknown";
+}
 
+void dxFeedSession::authenticate() {
+    try {
         boost::json::object payload{
             {"login", user},
             {"password", password},
@@ -82,23 +121,18 @@ void dxFeedSession::authenticate() {
 
         boost::beast::http::request<boost::beast::http::string_body> req(
             boost::beast::http::verb::post,
-            "/sessions",
+            SESSION_PATH,
             11); // HTTP 1.1
-        req.set(boost::beast::http::field::host, "api.tastyworks.com");
         req.set(boost::beast::http::field::content_type, "application/json");
-        req.set(boost::beast::http::field::connection, "keep-alive");
         req.set(boost::beast::http::field::user_agent, "curl/7.68.0");
         req.set(boost::beast::http::field::accept, "*/*");
         req.body() = body;
-        req.prepare_payload();
 
         // std::cout << "Request:\n" << req << std::endl;
 
-        boost::beast::http::write(stream, req);
-
-        boost::beast::flat_buffer buffer;
-        boost::beast::http::response<boost::beast::http::string_body> res;
-        boost::beast::http::read(stream, buffer, res);
+        int64_t requestStart = monotonicNowNs();
+        auto res = rest.send(req);
+        sessionTimeline.record(SessionStage::RestAuthenticate, requestStart, monotonicNowNs());
 
         // std::cout << "Response:\n" << res << std::endl;
 
@@ -106,20 +140,16 @@ void dxFeedSession::authenticate() {
             auto jsonResponse = boost::json::parse(res.body()).as_object();
             auto data = jsonResponse["data"].as_object();
             sessionToken = data["session-token"].as_string().c_str();
+
+            tokenCache.sessionToken.token = sessionToken;
+            tokenCache.sessionToken.expiresAt = data.contains("session-expiration")
+                ? TokenCache::parseIsoTimestamp(data["session-expiration"].as_string().c_str())
+                : TokenCache::nowSeconds() + kDefaultTokenLifetimeSeconds;
+            tokenCache.save();
             // std::cout << "Session token obtained: " << sessionToken << std::endl;
         } else {
             throw std::runtime_error("Failed to authenticate: " + res.body());
         }
-
-        // Graceful shutdown with error handling
-        try {
-            stream.shutdown();
-        } catch (const boost::system::system_error& e) {
-            if (e.code() != boost::asio::error::eof && e.code() != boost::asio::ssl::error::stream_truncated) {
-                throw; // Rethrow unexpected errors
-            }
-            std::cerr << "SSL Shutdown Warning: " << e.what() << std::endl;
-        }
     } catch (const std::exception& e) {
         std::cerr << "Exception: " << e.what() << std::endl;
         throw;
@@ -128,36 +158,21 @@ void dxFeedSession::authenticate() {
 
 boost::json::value dxFeedSession::getQuoteToken() {
     try {
-        boost::asio::io_context ioc;
-        boost::asio::ssl::context ssl_context(boost::asio::ssl::context::tlsv12_client);
-        ssl_context.set_default_verify_paths();
-
-        boost::beast::ssl_stream<boost::beast::tcp_stream> stream(ioc, ssl_context);
-        boost::asio::ip::tcp::resolver resolver(ioc);
-        auto const results = resolver.resolve("api.tastyworks.com", "443");
-        boost::beast::get_lowest_layer(stream).connect(results);
-        stream.handshake(boost::asio::ssl::stream_base::client);
-
         // Prepare the HTTP request
         boost::beast::http::request<boost::beast::http::string_body> req(
             boost::beast::http::verb::get,
-            "/api-quote-tokens",
+            QUOTE_TOKEN_PATH,
             11); // HTTP 1.1
-        req.set(boost::beast::http::field::host, "api.tastyworks.com");
         req.set(boost::beast::http::field::authorization, sessionToken); // Add Authorization header
-        req.set(boost::beast::http::field::connection, "keep-alive");
         req.set(boost::beast::http::field::user_agent, "curl/7.68.0");
         req.set(boost::beast::http::field::accept, "*/*");
 
         // std::cout << "Request:\n" << req << std::endl;
 
-        // Send the request
-        boost::beast::http::write(stream, req);
-
-        // Receive the response
-        boost::beast::flat_buffer buffer;
-        boost::beast::http::response<boost::beast::http::string_body> res;
-        boost::beast::http::read(stream, buffer, res);
+        // Send the request and receive the response on the shared connection
+        int64_t requestStart = monotonicNowNs();
+        auto res = rest.send(req);
+        sessionTimeline.record(SessionStage::RestQuoteToken, requestStart, monotonicNowNs());
 
         // std::cout << "Response:\n" << res << std::endl;
 
@@ -172,6 +187,13 @@ boost::json::value dxFeedSession::getQuoteToken() {
             auto data = jsonResponse["data"].as_object();
             if (data.contains("token")) {
                 websocketToken = data["token"].as_string().c_str(); // Extract WebSocket token
+
+                // Quote tokens are valid for 24 hours unless the response says otherwise
+                tokenCache.websocketToken.token = websocketToken;
+                tokenCache.websocketToken.expiresAt = data.contains("expires-at")
+                    ? TokenCache::parseIsoTimestamp(data["expires-at"].as_string().c_str())
+                    : TokenCache::nowSeconds() + kDefaultTokenLifetimeSeconds;
+                tokenCache.save();
                 // std::cout << "WebSocket token: " << websocketToken << std::endl;
             } else {
                 throw std::runtime_error("Error: 'token' not found in 'data'.");
@@ -190,28 +212,20 @@ boost::json::value dxFeedSession::getQuoteToken() {
 
 
 void dxFeedSession::closeSession() {
-    boost::asio::io_context ioc;
-    boost::asio::ssl::context sslContext(boost::asio::ssl::context::tlsv12_client);
-    boost::beast::ssl_stream<boost::beast::tcp_stream> stream(ioc, sslContext);
-
-    boost::asio::ip::tcp::resolver resolver(ioc);
-    auto const results = resolver.resolve("api.tastyworks.com", "443");
-
-    boost::beast::get_lowest_layer(stream).connect(results);
-    stream.handshake(boost::asio::ssl::stream_base::client);
-
-    http::request<http::empty_body> req(http::verb::delete_, "/sessions", 11);
-    req.set(http::field::host, "api.tastyworks.com");
+    http::request<http::string_body> req(http::verb::delete_, SESSION_PATH, 11);
     req.set(http::field::authorization, sessionToken);
-    req.prepare_payload();
 
-    http::write(stream, req);
+    int64_t requestStart = monotonicNowNs();
+    auto res = rest.send(req);
+    sessionTimeline.record(SessionStage::RestCloseSession, requestStart, monotonicNowNs());
 
-    boost::beast::flat_buffer buffer;
-    http::response<http::string_body> res;
-    http::read(stream, buffer, res);
+    // Nothing else goes to this host once the session is gone
+    rest.close();
 
     if (res.result() == http::status::ok || res.result() == http::status::no_content) {
+        // The quote token outlives the session, only the session token goes stale
+        tokenCache.sessionToken = TokenCache::Entry{};
+        tokenCache.save();
         std::cout << "Session closed successfully." << std::endl;
     } else {
         throw std::runtime_error("Failed to close session: " + res.body());
@@ -3,6 +3,16 @@
 
 #include <string>
 #include <boost/json.hpp>
+#include "RestConnection.hpp"
+#include "SessionTimeline.hpp"
+#include "TokenCache.hpp"
+
+// How the websocket token for this run was obtained
+enum class TokenSource {
+    Cache,          // Valid quote token found in the cache file, no REST calls
+    QuoteToken,     // Cached session token reused, only getQuoteToken() was called
+    Login           // Full authenticate() + getQuoteToken()
+};
  
 class dxFeedSession {
 private:
@@ -10,14 +20,45 @@ private:
     std::string password;
     std::string sessionToken;
 
-    boost::json::value loadConfig();
+    // Resolve/connect/TLS/request latencies of the REST calls
+    SessionTimeline sessionTimeline;
+
+    // One kept-alive TLS connection shared by every REST call
+    RestConnection rest;
+
+    // Tokens persisted next to creds.json between runs
+    TokenCache tokenCache;
+    TokenSource lastTokenSource = TokenSource::Login;
+
+    boost::json::value loadConfig(const std::string& configPath);
 
 public:
-    dxFeedSession();
+    // configPath defaults to the platform creds.json location
+    explicit dxFeedSession(const std::string& configPath = defaultConfigPath(),
+                           const std::string& apiHost = "api.tastyworks.com",
+                           const std::string& apiPort = "443");
     void authenticate();
     boost::json::value getQuoteToken();
     std::string websocketToken; //
     void closeSession();
+
+    // Sets websocketToken from the token cache when it is still valid, otherwise logs in as needed
+    // and refreshes the cache. Returns which path was taken.
+    TokenSource ensureWebsocketToken();
+
+    // Forget cached tokens, e.g. after the websocket answered AUTH with UNAUTHORIZED
+    void invalidateCachedTokens();
+
+    TokenSource tokenSource() const { return lastTokenSource; }
+    static const char* tokenSourceName(TokenSource source);
+
+    // Trust a specific CA bundle for the REST host (e.g. a local stand-in server)
+    void setCaFile(const std::string& caFile) { rest.setCaFile(caFile); }
+
+    const SessionTimeline& timeline() const { return sessionTimeline; }
+    RestConnection::Stats connectionStats() const { return rest.stats(); }
+
+    static std::string defaultConfigPath();
 };
 
 #endif
@@ -1,62 +1,407 @@
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <vector>
 #include <chrono>
+#include <memory>
+#include <thread>
 #include "dxFeedSession.hpp"
+#include "AsyncLogger.hpp"
+#include "EventSchema.hpp"
+#include "FrameJournal.hpp"
+#include "LatencyHistogram.hpp"
 #include "MarketDataWebSocket.hpp"
+#include "MetricsServer.hpp"
+#include "MonotonicClock.hpp"
+#include "QuoteHistory.hpp"
+#include "QuoteKernels.hpp"
+#include "SharedQuoteBus.hpp"
+#include "SnapshotServer.hpp"
+#include "ThreadAffinity.hpp"
+
+// Fills session.websocketToken from the cache or the REST API and reports which path it took
+static void fetchToken(dxFeedSession& session, std::chrono::high_resolution_clock::time_point start_time) {
+    TokenSource tokenSource = session.ensureWebsocketToken();
+
+    auto token_end_time = std::chrono::high_resolution_clock::now();
+    auto token_duration = std::chrono::duration_cast<std::chrono::milliseconds>(token_end_time - start_time).count();
+    std::cout << "Token path: " << dxFeedSession::tokenSourceName(tokenSource)
+              << " (" << token_duration << " ms)" << std::endl;
+}
+
+// Per-symbol mid, spread and size-weighted mid over the quotes history still holds
+static void printQuoteAnalytics(const QuoteHistory& history, const QuoteBook& book) {
+    for (size_t id = 0; id < book.size() && id < history.symbolCapacity(); ++id) {
+        QuoteWindow window = history.all(static_cast<int32_t>(id));
+        if (window.empty()) {
+            continue;
+        }
+        SeriesStats mid = QuoteKernels::stats(window, QuoteSeries::Mid);
+        SeriesStats spread = QuoteKernels::stats(window, QuoteSeries::Spread);
+        SeriesStats weightedMid = QuoteKernels::stats(window, QuoteSeries::WeightedMid);
+        std::cout << "Symbol: " << book.symbol(static_cast<int32_t>(id))
+                  << " | quotes: " << window.size()
+                  << " | mid: " << mid.mean << " (" << mid.min << " - " << mid.max << ", sd " << mid.stddev << ")"
+                  << " | spread: " << spread.mean
+                  << " | weighted mid: " << weightedMid.mean << std::endl;
+    }
+}
+
+// Environment overrides for runs against tools/dxlink_standin.py (tools/latency_harness.py sets them)
+static std::string envOr(const char* name, const std::string& fallback) {
+    const char* value = std::getenv(name);
+    return value != nullptr && *value != '\0' ? std::string(value) : fallback;
+}
+
+struct RunOptions {
+    bool overlapBootstrap = true;   // --sequential turns it off: token first, then the websocket
+    bool streaming = false;         // --stream keeps the feed running until Ctrl-C
+    FrameJournal* journal = nullptr; // --journal PATH captures every websocket payload
+    TransportKind transport = TransportKind::Websocketpp; // --transport beast|websocketpp
+    EventTypeSet eventTypes = eventTypeBit(EventType::Quote); // --events Quote,Trade,Summary,Greeks,TimeAndSale
+    std::string publishName;        // --publish NAME: stream into a shared-memory segment for local readers
+    double aggregationSeconds = 0.1; // --aggregation-ms N: acceptAggregationPeriod in FEED_SETUP
+    bool conflate = false;          // --conflate: a slow consumer gets the newest quote per symbol
+    SocketTuning socketTuning;      // --rcvbuf BYTES (0: kernel autotuning), --busy-poll-us N (SO_BUSY_POLL)
+    EventLoopConfig eventLoop;      // --busy-poll spins the feed loop, --feed-cpu N pins it to CPU N
+    std::string metricsEndpoint;    // --metrics PORT|unix:PATH serves Prometheus text at /metrics
+    int staleMs = 5000;             // --stale-ms N: a symbol quiet this long is flagged stale
+    std::string snapshotSocket;     // --serve PATH: stay up and answer snapshot requests on a Unix socket
+    size_t serveCapacity = 4096;    // --serve-capacity N: symbols the daemon can track, subscribed on demand
+    std::string websocketUrl = envOr("PX_WS_URL", "wss://tasty-openapi-ws.dxfeed.com/realtime");
+    std::string caFile = envOr("PX_CA_FILE", ""); // Trusted for both REST and the websocket when set
+};
+
+// Runs one websocket session and merges its stage latencies into timeline.
+// With options.overlapBootstrap the websocket connects, handshakes and sends SETUP on its own thread while
+// fetchToken() runs here; otherwise session.websocketToken must already be set.
+// Returns false if dxLink rejected the token.
+static bool runWebSocket(dxFeedSession& session, const RunOptions& options, const std::vector<std::string>& symbols,
+                         SessionTimeline& timeline, std::chrono::high_resolution_clock::time_point start_time) {
+    // Initialize and connect to WebSocket
+    MarketDataWebSocket wsClient(
+        options.websocketUrl,
+        options.overlapBootstrap ? "" : session.websocketToken, // Pass the correctly parsed WebSocket token
+        3,              // Channel number
+        options.transport
+    );
+
+    if (!options.caFile.empty()) {
+        wsClient.setCaFile(options.caFile);
+    }
+    wsClient.setSocketTuning(options.socketTuning);
+    wsClient.setEventLoop(options.eventLoop);
+
+    // Set symbols to track; the daemon keeps room for symbols its clients ask for later
+    bool serving = !options.snapshotSocket.empty();
+    wsClient.setSymbolsToTrack(symbols, serving ? std::max(options.serveCapacity, symbols.size()) : 0);
+    wsClient.setEventTypes(options.eventTypes);
+    wsClient.setAggregationPeriod(options.aggregationSeconds);
+    if (options.conflate) {
+        wsClient.quotes().enableConflation(wsClient.book().capacity());
+    }
+    if (options.streaming) {
+        wsClient.enableStreaming();
+    }
+    wsClient.setJournal(options.journal);
+
+    // Scrapes run on the server's own thread and only read the feed thread's counters
+    std::unique_ptr<MetricsServer> metricsServer;
+    if (!options.metricsEndpoint.empty()) {
+        wsClient.enableMetrics(static_cast<int64_t>(options.staleMs) * 1000000);
+        metricsServer = std::make_unique<MetricsServer>(options.metricsEndpoint, [&wsClient](std::ostream& out) {
+            wsClient.renderMetrics(out);
+        });
+        std::cout << "Serving metrics on " << metricsServer->endpoint() << " at /metrics" << std::endl;
+    }
+
+    // Daemon mode: snapshot requests are answered from the book on the server's thread, and symbols
+    // it does not track yet are subscribed on the feed thread (python/px_snapshot_client.py,
+    // tools/PxSnapshot.cpp). Listening before the bootstrap lets clients queue up while it runs.
+    std::unique_ptr<SnapshotServer> snapshotServer;
+    if (serving) {
+        snapshotServer = std::make_unique<SnapshotServer>(options.snapshotSocket, wsClient.book(),
+                                                          [&wsClient](const std::vector<std::string>& missing) {
+            wsClient.addSymbols(missing);
+        });
+        std::cout << "Serving snapshots on " << snapshotServer->path() << " (up to " << wsClient.book().capacity()
+                  << " symbols)" << std::endl;
+    }
+
+    // Streaming keeps the recent quotes of each symbol for the analytics printed at the end
+    std::unique_ptr<QuoteHistory> history;
+    if (options.streaming && !serving) {
+        history = std::make_unique<QuoteHistory>(symbols.size(), 1024);
+    }
+
+    // Publisher mode: every quote goes to the shared-memory segment instead of stdout, and local
+    // strategy processes read it with SharedQuoteReader (tools/QuoteTail.cpp) without a login or
+    // connection of their own
+    std::unique_ptr<SharedQuotePublisher> publisher;
+    if (!options.publishName.empty()) {
+        publisher = std::make_unique<SharedQuotePublisher>(options.publishName, 65536, wsClient.book().size());
+        for (size_t id = 0; id < wsClient.book().size(); ++id) {
+            publisher->defineSymbol(static_cast<int32_t>(id), wsClient.book().symbol(static_cast<int32_t>(id)));
+        }
+        std::cout << "Publishing quotes to shared memory " << options.publishName << std::endl;
+    }
+
+    // Print quotes on a consumer thread so the feed thread only decodes and hands off. Quotes are
+    // stamped with the kernel receive time where the transport has it (beast), so the handler sees
+    // how long each one took from the wire. The lines go through the AsyncLogger, which formats and
+    // writes them on its own thread, so console I/O is not part of that time either.
+    LatencyHistogram wireToHandler;
+    const QuoteBook& book = wsClient.book();
+    wsClient.quotes().start([&book, &history, &publisher, &wireToHandler, serving](const QuoteRecord& quote,
+                                                                                  uint32_t updates) {
+        wireToHandler.recordDuration(quote.receiveTimeNs, monotonicNowNs());
+        if (history) {
+            history->append(quote);
+        }
+        if (publisher) {
+            publisher->publish(quote);
+            return;
+        }
+        if (serving) {
+            return; // Clients read the book; printing every quote would only slow the consumer
+        }
+        // The record keeps only the first kMaxSymbolLength characters; the book has the full name
+        std::string_view symbol =
+            quote.symbolId != QuoteBook::kNotFound ? std::string_view(book.symbol(quote.symbolId)) : quote.symbolView();
+        if (updates > 1) {
+            PX_LOG_INFO("Symbol: {} | Bid: {} | Ask: {} | Mid: {} | bidSize: {} | askSize: {} | merged: {}", symbol,
+                        quote.bidPrice, quote.askPrice, quote.midPrice(), quote.bidSize, quote.askSize, updates);
+        } else {
+            PX_LOG_INFO("Symbol: {} | Bid: {} | Ask: {} | Mid: {} | bidSize: {} | askSize: {}", symbol,
+                        quote.bidPrice, quote.askPrice, quote.midPrice(), quote.bidSize, quote.askSize);
+        }
+    });
+    // Connect to the WebSocket server
+
+    // Start WebSocket connection timer
+    auto ws_start_time = std::chrono::high_resolution_clock::now();
+
+    if (options.overlapBootstrap) {
+        std::thread feedThread([&wsClient] { wsClient.connect(); });
+        try {
+            fetchToken(session, start_time);
+        } catch (...) {
+            wsClient.stop();
+            feedThread.join();
+            wsClient.quotes().stop();
+            throw;
+        }
+        wsClient.provideToken(session.websocketToken);
+        feedThread.join();
+    } else {
+        wsClient.connect();
+    }
+
+    // End WebSocket connection timer
+    auto ws_end_time = std::chrono::high_resolution_clock::now();
+    auto ws_duration = std::chrono::duration_cast<std::chrono::milliseconds>(ws_end_time - ws_start_time).count();
+
+    wsClient.quotes().stop();
+    // The summary goes straight to std::cout, after every logged line
+    AsyncLogger::instance().flush();
+    auto quoteStats = wsClient.quotes().stats();
+    std::cout << "WebSocket px return time: " << ws_duration << " ms" << std::endl;
+    std::cout << "Quotes published: " << quoteStats.published
+              << " | dropped: " << quoteStats.dropped
+              << " | overflows: " << quoteStats.overflows;
+    if (wsClient.quotes().conflating()) {
+        std::cout << " | merged: " << quoteStats.merged;
+    }
+    std::cout << std::endl;
+    AppliedSocketTuning tuning = wsClient.socketTuning();
+    std::cout << "Socket (" << wsClient.transportName() << "): TCP_NODELAY " << (tuning.noDelay ? "on" : "off")
+              << " | SO_RCVBUF " << tuning.receiveBufferBytes
+              << " | kernel receive stamps " << (tuning.receiveTimestamps ? "on" : "off") << std::endl;
+    // Kernel receive -> onMessage below is the feed thread's wake-up latency plus TLS and framing,
+    // so its tail is what the busy-poll mode is compared on
+    std::cout << "Feed loop: " << (options.eventLoop.busyPoll ? "busy-poll" : "blocking");
+    if (options.eventLoop.cpu >= 0) {
+        std::cout << " | CPU " << options.eventLoop.cpu
+                  << (wsClient.eventLoopIsPinned() ? " (pinned)" : " (not pinned)");
+    }
+    std::cout << " | SO_BUSY_POLL " << tuning.busyPollMicros << " us" << std::endl;
+    if (wsClient.kernelLatency().count() > 0) {
+        std::cout << "Kernel receive -> onMessage: " << wsClient.kernelLatency().summary() << std::endl;
+    }
+    std::cout << (tuning.receiveTimestamps ? "Wire" : "onMessage") << " -> quote handler: "
+              << wireToHandler.summary() << std::endl;
+    std::cout << "Aggregation period: requested " << options.aggregationSeconds * 1000 << " ms";
+    if (wsClient.grantedAggregationPeriod() >= 0) {
+        std::cout << ", granted " << wsClient.grantedAggregationPeriod() * 1000 << " ms";
+    }
+    std::cout << std::endl;
+    if (const FeedMetrics* metrics = wsClient.metrics()) {
+        std::cout << "Feed metrics: " << metrics->frameCount() << " frames | " << metrics->byteCount()
+                  << " bytes | " << metrics->parseErrorCount() << " parse errors | "
+                  << metrics->staleCount(wsClient.book(), monotonicNowNs()) << " of " << wsClient.book().size()
+                  << " symbols stale (> " << options.staleMs << " ms)" << std::endl;
+    }
+    if (publisher) {
+        std::cout << "Quotes published to " << options.publishName << ": " << publisher->publishedCount() << std::endl;
+    }
+    if (options.eventTypes != eventTypeBit(EventType::Quote)) {
+        std::cout << "Events decoded:";
+        forEachEventSchema([&](auto schema) {
+            using Schema = decltype(schema);
+            if (options.eventTypes & eventTypeBit(Schema::type)) {
+                std::cout << ' ' << Schema::name << '=' << wsClient.eventCount(Schema::type);
+            }
+        });
+        std::cout << std::endl;
+    }
+    if (options.streaming) {
+        auto streamStats = wsClient.streamingStats();
+        std::cout << "Reconnects: " << streamStats.reconnects
+                  << " | stalls: " << streamStats.stalls
+                  << " | keepalives sent/received: " << streamStats.keepalivesSent
+                  << "/" << streamStats.keepalivesReceived << std::endl;
+        if (history) {
+            printQuoteAnalytics(*history, wsClient.book());
+        }
+    }
+    if (snapshotServer) {
+        auto serveStats = snapshotServer->stats();
+        std::cout << "Snapshot requests: " << serveStats.requests << " | symbols answered: " << serveStats.symbols
+                  << " | subscribed on demand: " << serveStats.subscribed << " | rejected: " << serveStats.rejected
+                  << std::endl;
+    }
+
+    timeline.merge(wsClient.timeline());
+    return !wsClient.authWasRejected();
+}
+
+int main(int argc, char* argv[]) {
+    RunOptions options;
+    std::string journalPath;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--sequential") {
+            options.overlapBootstrap = false;
+        } else if (arg == "--stream") {
+            options.streaming = true;
+        } else if (arg == "--journal" && i + 1 < argc) {
+            journalPath = argv[++i];
+        } else if (arg == "--transport" && i + 1 < argc && parseTransportKind(argv[i + 1], options.transport)) {
+            ++i;
+        } else if (arg == "--events" && i + 1 < argc && parseEventTypes(argv[i + 1], options.eventTypes)) {
+            ++i;
+        } else if (arg == "--publish" && i + 1 < argc) {
+            options.publishName = argv[++i];
+            options.streaming = true;
+        } else if (arg == "--aggregation-ms" && i + 1 < argc) {
+            options.aggregationSeconds = std::atof(argv[++i]) / 1000.0;
+        } else if (arg == "--conflate") {
+            options.conflate = true;
+        } else if (arg == "--rcvbuf" && i + 1 < argc) {
+            options.socketTuning.receiveBufferBytes = std::atoi(argv[++i]);
+        } else if (arg == "--busy-poll") {
+            options.eventLoop.busyPoll = true;
+        } else if (arg == "--busy-poll-us" && i + 1 < argc) {
+            options.socketTuning.busyPollMicros = std::atoi(argv[++i]);
+        } else if (arg == "--feed-cpu" && i + 1 < argc) {
+            options.eventLoop.cpu = std::atoi(argv[++i]);
+        } else if (arg == "--metrics" && i + 1 < argc) {
+            options.metricsEndpoint = argv[++i];
+        } else if (arg == "--stale-ms" && i + 1 < argc) {
+            options.staleMs = std::atoi(argv[++i]);
+        } else if (arg == "--serve" && i + 1 < argc) {
+            options.snapshotSocket = argv[++i];
+            options.streaming = true;
+        } else if (arg == "--serve-capacity" && i + 1 < argc) {
+            options.serveCapacity = std::strtoul(argv[++i], nullptr, 10);
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--sequential] [--stream] [--journal PATH] [--transport websocketpp|beast]"
+                      << " [--events Quote,Trade,Summary,Greeks,TimeAndSale] [--publish SHM_NAME]"
+                      << " [--aggregation-ms N] [--conflate] [--rcvbuf BYTES] [--busy-poll] [--busy-poll-us N]"
+                      << " [--feed-cpu N] [--metrics PORT|unix:PATH] [--stale-ms N] [--serve PATH]"
+                      << " [--serve-capacity N]" << std::endl;
+            return 1;
+        }
+    }
+
+    // Every thread started from here on (dispatcher consumer, REST bootstrap) inherits a mask without
+    // the feed core; only the feed loop pins itself onto it
+    if (options.eventLoop.cpu >= 0 && !excludeCpuFromCurrentThread(options.eventLoop.cpu)) {
+        std::cerr << "Could not keep other threads off CPU " << options.eventLoop.cpu << std::endl;
+    }
 
-int main() {
     try {
         // Start total script execution timer
         auto script_start_time = std::chrono::high_resolution_clock::now();
         
-        // Initialize session
-        dxFeedSession session;
-        session.authenticate();
-
-        // Get the WebSocket token
-        auto tokenData = session.getQuoteToken();
+        std::unique_ptr<FrameJournal> journal;
+        if (!journalPath.empty()) {
+            journal = std::make_unique<FrameJournal>(journalPath);
+            options.journal = journal.get();
+        }
 
-        // Correctly access the nested "token" field inside "data"
-        auto data = tokenData.at("data").as_object();
-        std::string websocketToken = data.at("token").as_string().c_str();
+        // Initialize session; a valid cached token skips authenticate() and getQuoteToken()
+        dxFeedSession session(envOr("PX_CREDS", dxFeedSession::defaultConfigPath()),
+                              envOr("PX_API_HOST", "api.tastyworks.com"), envOr("PX_API_PORT", "443"));
+        if (!options.caFile.empty()) {
+            session.setCaFile(options.caFile);
+        }
+        if (!options.overlapBootstrap) {
+            fetchToken(session, script_start_time);
+        }
 
         // Debug print token
-        // std::cout << "WebSocket token: " << websocketToken << std::endl;
+        // std::cout << "WebSocket token: " << session.websocketToken << std::endl;
 
         // Define the symbols to retrieve prices for
         // std::vector<std::string> symbols = {"/6BZ24:XCME", "/6EZ24:XCME"};
         // std::vector<std::string> symbols = {"/6EZ24:XCME"};
         std::vector<std::string> symbols = {"/6BZ24:XCME"};
+        // PX_SYMBOLS: comma-separated list instead
+        if (const char* symbolList = std::getenv("PX_SYMBOLS"); symbolList != nullptr && *symbolList != '\0') {
+            symbols.clear();
+            std::istringstream list(symbolList);
+            for (std::string symbol; std::getline(list, symbol, ',');) {
+                if (!symbol.empty()) {
+                    symbols.push_back(symbol);
+                }
+            }
+        }
 
-        // Initialize and connect to WebSocket
-        MarketDataWebSocket wsClient(
-            "wss://tasty-openapi-ws.dxfeed.com/realtime",
-            websocketToken, // Pass the correctly parsed WebSocket token
-            3               // Channel number
-        );
-
-        // Set symbols to track
-        wsClient.setSymbolsToTrack(symbols);
-        // Connect to the WebSocket server
-
-        // Start WebSocket connection timer
-        auto ws_start_time = std::chrono::high_resolution_clock::now();
-        
-        wsClient.connect();
-
-        // End WebSocket connection timer
-        auto ws_end_time = std::chrono::high_resolution_clock::now();
-        auto ws_duration = std::chrono::duration_cast<std::chrono::milliseconds>(ws_end_time - ws_start_time).count();
-        std::cout << "WebSocket px return time: " << ws_duration << " ms" << std::endl;
+        SessionTimeline timeline;
+        if (!runWebSocket(session, options, symbols, timeline, script_start_time) &&
+            session.tokenSource() != TokenSource::Login) {
+            // The cached token was revoked before its expiry: log in again and retry once
+            std::cout << "Cached token rejected, re-authenticating." << std::endl;
+            session.invalidateCachedTokens();
+            auto retry_start_time = std::chrono::high_resolution_clock::now();
+            if (!options.overlapBootstrap) {
+                fetchToken(session, retry_start_time);
+            }
+            runWebSocket(session, options, symbols, timeline, retry_start_time);
+        }
 
         // End total script execution timer
         auto script_end_time = std::chrono::high_resolution_clock::now();
         auto script_duration = std::chrono::duration_cast<std::chrono::milliseconds>(script_end_time - script_start_time).count();
         std::cout << "Total script execution time: " << script_duration << " ms" << std::endl;
 
+        // Per-stage breakdown of where the time went
+        timeline.merge(session.timeline());
+        std::cout << "Session latency breakdown:" << std::endl;
+        timeline.report(std::cout);
+
+        if (journal) {
+            std::cout << "Journal " << journalPath << ": " << journal->recordCount() << " frames, "
+                      << journal->usedBytes() << " bytes, " << journal->droppedCount() << " dropped" << std::endl;
+        }
+
 
     } catch (const std::exception& ex) {
+        AsyncLogger::instance().flush();
         std::cerr << "Error: " << ex.what() << std::endl;
         return 1;
     }
@@ -1,20 +1,38 @@
 #!/usr/bin/env python3
+import os
+import sys
 import time
 import platform
 import ssl
 import websocket
 from websocket_init import TastyworksSession
 import json
+import numpy as np
 import pandas as pd
 from typing import List, Tuple, Any
 
+# The C++ feed (python/dxfeed_native.cpp) when it has been built; otherwise the pure Python path below
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "python"))
+try:
+    import dxfeed_native
+except ImportError:
+    dxfeed_native = None
+from px_snapshot_client import SnapshotClient, STATUS_NAMES
+
+
+# PX_WS_URL / PX_CA_FILE / PX_SYMBOLS point the script at a local stand-in (tools/dxlink_standin.py);
+# PX_NATIVE=0 forces the pure Python path; PX_DAEMON=PATH asks a running snapshot daemon (main --serve PATH)
+WS_URL = os.environ.get('PX_WS_URL', 'wss://tasty-openapi-ws.dxfeed.com/realtime')
+CA_FILE = os.environ.get('PX_CA_FILE')
+
 
 class MarketDataProcessor:
-    def __init__(self, token: str, symbols: List[str]):
-        self.ws_url = 'wss://tasty-openapi-ws.dxfeed.com/realtime'
+    def __init__(self, token: str, symbols: List[str], use_native: bool = True):
+        self.ws_url = WS_URL
         self.channel_number = 3
         self.token = token
         self.symbols = symbols
+        self.use_native = use_native and dxfeed_native is not None and os.environ.get('PX_NATIVE') != '0'
         self.ws_client = MarketDataWebSocket(self.ws_url, self.token, self.channel_number)
         self.columns_to_check = [
             'bidPrice', 'askPrice', 'bidSize', 'askSize', 
@@ -63,6 +81,8 @@ class MarketDataProcessor:
 
     def process_market_data(self) -> pd.DataFrame:
         """Main function to process WebSocket market data."""
+        if self.use_native:
+            return self.process_market_data_native()
         symbols = self.get_streamer_symbols()
         print(f'Symbols: {symbols}')
         self.ws_client.set_symbols_to_track(symbols)
@@ -83,6 +103,29 @@ class MarketDataProcessor:
         # Reorder and return
         return self.reorder_columns(df_parsed, ['midPrice'])
 
+    def process_market_data_native(self) -> pd.DataFrame:
+        """Snapshot through the C++ feed: quotes arrive as one NumPy array, no per-row parsing."""
+        symbols = self.get_streamer_symbols()
+        print(f'Symbols: {symbols}')
+        feed = dxfeed_native.Feed(self.ws_url, self.token, symbols, self.channel_number, ca_file=CA_FILE)
+        request_start_time = time.time()
+        quotes = feed.snapshot()
+        request_end_time = time.time()
+        print(f"WebSocket px return time: {(request_end_time - request_start_time) * 1000:.2f} ms")
+
+        # symbolId indexes the full names; the array's own symbol field is truncated to 19 bytes
+        df_parsed = pd.DataFrame({
+            'eventType': 'Quote',
+            'eventType2': 'Quote',
+            'streamer-symbol': np.asarray(feed.symbols(), dtype=object)[quotes['symbolId']],
+            'bidPrice': quotes['bidPrice'],
+            'askPrice': quotes['askPrice'],
+            'bidSize': quotes['bidSize'],
+            'askSize': quotes['askSize'],
+        })
+        df_parsed = self.calculate_mid_prices(df_parsed)
+        return self.reorder_columns(df_parsed, ['midPrice'])
+
     def calculate_mid_prices(self, df: pd.DataFrame) -> pd.DataFrame:
         """Calculate mid prices."""
         if 'bidPrice' in df.columns and 'askPrice' in df.columns:
@@ -111,7 +154,7 @@ class MarketDataWebSocket:
             on_error=self.on_error,
             on_close=self.on_close
         )
-        self.ws.run_forever(sslopt={"cert_reqs": ssl.CERT_NONE})
+        self.ws.run_forever(sslopt={"ca_certs": CA_FILE} if CA_FILE else {"cert_reqs": ssl.CERT_NONE})
 
     def on_open(self, ws):
         print("### connection opened ###")
@@ -203,22 +246,53 @@ def px_flow(symbols: List[str]) -> MarketDataProcessor:
     Create and return a MarketDataProcessor instance.
     """
     creds_path = "creds.yaml" if platform.system() == "Darwin" else "/home/ec2-user/tt/creds.yaml"
+    token_start_time = time.time()
     session = TastyworksSession()
     streamer_token = session.run()
+    print(f"Token path: login ({(time.time() - token_start_time) * 1000:.2f} ms)")
     return MarketDataProcessor(streamer_token['data']['token'], symbols)
 
+def daemon_snapshot(socket_path: str, symbols: List[str]) -> pd.DataFrame:
+    """Latest quotes from the snapshot daemon: no login, websocket or subscription on this side."""
+    with SnapshotClient(socket_path) as client:
+        request_start_time = time.time()
+        # Symbols the daemon is not tracking yet get subscribed now; give them time for a first quote
+        quotes = client.get(symbols, wait_ms=5000)
+        request_end_time = time.time()
+    print(f"Daemon px return time: {(request_end_time - request_start_time) * 1000:.3f} ms")
+    for quote in quotes:
+        if not quote.ok:
+            print(f"Warning: no quote for {quote.symbol} ({STATUS_NAMES.get(quote.status, 'unknown')})")
+    quotes = [quote for quote in quotes if quote.ok]
+    df = pd.DataFrame({
+        'eventType': 'Quote',
+        'eventType2': 'Quote',
+        'streamer-symbol': [quote.symbol for quote in quotes],
+        'bidPrice': [quote.bidPrice for quote in quotes],
+        'askPrice': [quote.askPrice for quote in quotes],
+        'bidSize': [quote.bidSize for quote in quotes],
+        'askSize': [quote.askSize for quote in quotes],
+    })
+    df['midPrice'] = (df['bidPrice'] + df['askPrice']) / 2
+    return df
+
 def main():
     start_time = time.time() 
     
     # Define the symbols to retrieve prices for
     # symbols = ["/6EZ24:XCME", "/6BZ24:XCME"]
     symbols = ["/6BZ24:XCME"]
+    if os.environ.get("PX_SYMBOLS"):
+        symbols = [symbol for symbol in os.environ["PX_SYMBOLS"].split(",") if symbol]
 
-    # Create a MarketDataProcessor instance
-    pxi = px_flow(symbols)
+    if os.environ.get("PX_DAEMON"):
+        prices = daemon_snapshot(os.environ["PX_DAEMON"], symbols)
+    else:
+        # Create a MarketDataProcessor instance
+        pxi = px_flow(symbols)
 
-    # Process and retrieve market data
-    prices = pxi.process_market_data()
+        # Process and retrieve market data
+        prices = pxi.process_market_data()
 
     end_time = time.time()
     
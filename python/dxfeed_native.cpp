@@ -0,0 +1,535 @@
+// Python extension over dxFeedSession and MarketDataWebSocket. Quotes come back as NumPy
+// structured arrays (dxfeed_native.quote_dtype, the QuoteRecord layout) whose buffer is the
+// std::vector the records were drained into, so nothing is parsed or boxed per row. The GIL is
+// released while connecting, fetching tokens and stopping.
+//
+// Written against the CPython and NumPy C APIs, so NumPy is the only build dependency.
+//
+// Build (from python/):
+//   g++ -O2 -std=c++17 -shared -fPIC -I.. $(python3-config --includes)
+//       -I$(python3 -c "import numpy; print(numpy.get_include())") dxfeed_native.cpp
+//       ../dxFeedSession.cpp ../RestConnection.cpp ../TokenCache.cpp ../MarketDataWebSocket.cpp
+//       ../SubscriptionManager.cpp ../FeedTransport.cpp ../BeastTransport.cpp ../CompactFeedDecoder.cpp
+//       ../WebsocketppTransport.cpp ../QuoteBook.cpp ../QuoteDispatcher.cpp ../SocketTuning.cpp ../FeedMetrics.cpp
+//       ../AsyncLogger.cpp ../LatencyHistogram.cpp ../SessionTimeline.cpp -lboost_json -lssl -lcrypto -pthread
+//       -o dxfeed_native$(python3-config --extension-suffix)
+//
+//   import dxfeed_native
+//   session = dxfeed_native.Session()                  # creds.json at the default path
+//   feed = dxfeed_native.Feed(url, session.websocket_token(), ["/6BZ24:XCME"])
+//   quotes = feed.snapshot()                            # one row per symbol, once all have quoted
+//   feed.start(); ...; recent = feed.poll(); feed.stop() # or stream and pull batches
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#include <numpy/arrayobject.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "dxFeedSession.hpp"
+#include "MarketDataWebSocket.hpp"
+
+namespace {
+
+PyArray_Descr* quoteDescr = nullptr;
+
+using QuoteBuffer = std::vector<QuoteRecord>;
+
+// Zero the unused part of the symbol so NumPy's fixed-width bytes field ends at symbolLength
+void clearSymbolTail(QuoteRecord& quote) {
+    std::memset(quote.symbol + quote.symbolLength, 0, QuoteRecord::kMaxSymbolLength - quote.symbolLength);
+}
+
+// Wraps the buffer as a 1-d array of quote_dtype without copying; the array owns the buffer
+PyObject* toArray(std::unique_ptr<QuoteBuffer> quotes) {
+    npy_intp length = static_cast<npy_intp>(quotes->size());
+    Py_INCREF(quoteDescr);
+    if (length == 0) {
+        return PyArray_NewFromDescr(&PyArray_Type, quoteDescr, 1, &length, nullptr, nullptr, 0, nullptr);
+    }
+    PyObject* array = PyArray_NewFromDescr(&PyArray_Type, quoteDescr, 1, &length, nullptr, quotes->data(),
+                                           NPY_ARRAY_CARRAY, nullptr);
+    if (array == nullptr) {
+        return nullptr;
+    }
+    PyObject* owner = PyCapsule_New(quotes.get(), nullptr, [](PyObject* capsule) {
+        delete static_cast<QuoteBuffer*>(PyCapsule_GetPointer(capsule, nullptr));
+    });
+    if (owner == nullptr) {
+        Py_DECREF(array);
+        return nullptr;
+    }
+    quotes.release();
+    if (PyArray_SetBaseObject(reinterpret_cast<PyArrayObject*>(array), owner) != 0) {
+        Py_DECREF(array);
+        return nullptr;
+    }
+    return array;
+}
+
+PyObject* raise(const std::exception& e) {
+    PyErr_SetString(PyExc_RuntimeError, e.what());
+    return nullptr;
+}
+
+bool toStringList(PyObject* sequence, std::vector<std::string>& out) {
+    PyObject* items = PySequence_Fast(sequence, "symbols must be a sequence of str");
+    if (items == nullptr) {
+        return false;
+    }
+    Py_ssize_t count = PySequence_Fast_GET_SIZE(items);
+    out.reserve(static_cast<size_t>(count));
+    for (Py_ssize_t i = 0; i < count; ++i) {
+        Py_ssize_t size = 0;
+        const char* text = PyUnicode_AsUTF8AndSize(PySequence_Fast_GET_ITEM(items, i), &size);
+        if (text == nullptr) {
+            Py_DECREF(items);
+            return false;
+        }
+        out.emplace_back(text, static_cast<size_t>(size));
+    }
+    Py_DECREF(items);
+    return true;
+}
+
+// ---- Session ----
+
+struct SessionObject {
+    PyObject_HEAD
+    dxFeedSession* session;
+};
+
+int sessionInit(SessionObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"config_path", "host", "port", "ca_file", nullptr};
+    const char* configPath = nullptr;
+    const char* host = "api.tastyworks.com";
+    const char* port = "443";
+    const char* caFile = nullptr;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|zssz", const_cast<char**>(keywords), &configPath, &host, &port,
+                                     &caFile)) {
+        return -1;
+    }
+    try {
+        delete self->session;
+        self->session = new dxFeedSession(configPath ? configPath : dxFeedSession::defaultConfigPath(), host, port);
+        if (caFile != nullptr) {
+            self->session->setCaFile(caFile);
+        }
+    } catch (const std::exception& e) {
+        raise(e);
+        return -1;
+    }
+    return 0;
+}
+
+// Heap types: instances hold a reference to their type
+void freeObject(PyObject* self) {
+    PyTypeObject* type = Py_TYPE(self);
+    type->tp_free(self);
+    Py_DECREF(type);
+}
+
+void sessionDealloc(SessionObject* self) {
+    delete self->session;
+    freeObject(reinterpret_cast<PyObject*>(self));
+}
+
+bool sessionReady(SessionObject* self) {
+    if (self->session == nullptr) {
+        PyErr_SetString(PyExc_RuntimeError, "Session is not initialized");
+        return false;
+    }
+    return true;
+}
+
+PyObject* sessionWebsocketToken(SessionObject* self, PyObject*) {
+    if (!sessionReady(self)) {
+        return nullptr;
+    }
+    std::string token;
+    std::string error;
+    Py_BEGIN_ALLOW_THREADS
+    try {
+        self->session->ensureWebsocketToken();
+        token = self->session->websocketToken;
+    } catch (const std::exception& e) {
+        error = e.what();
+    }
+    Py_END_ALLOW_THREADS
+    if (!error.empty()) {
+        PyErr_SetString(PyExc_RuntimeError, error.c_str());
+        return nullptr;
+    }
+    return PyUnicode_FromStringAndSize(token.data(), static_cast<Py_ssize_t>(token.size()));
+}
+
+PyObject* sessionTokenSource(SessionObject* self, PyObject*) {
+    if (!sessionReady(self)) {
+        return nullptr;
+    }
+    return PyUnicode_FromString(dxFeedSession::tokenSourceName(self->session->tokenSource()));
+}
+
+PyObject* sessionInvalidate(SessionObject* self, PyObject*) {
+    if (!sessionReady(self)) {
+        return nullptr;
+    }
+    self->session->invalidateCachedTokens();
+    Py_RETURN_NONE;
+}
+
+PyMethodDef sessionMethods[] = {
+    {"websocket_token", reinterpret_cast<PyCFunction>(sessionWebsocketToken), METH_NOARGS,
+     "Cached dxLink token, or a fresh one from the REST API (releases the GIL)"},
+    {"token_source", reinterpret_cast<PyCFunction>(sessionTokenSource), METH_NOARGS,
+     "How the last websocket_token() was obtained"},
+    {"invalidate_cached_tokens", reinterpret_cast<PyCFunction>(sessionInvalidate), METH_NOARGS,
+     "Forget cached tokens, e.g. after dxLink rejected one"},
+    {nullptr, nullptr, 0, nullptr}};
+
+PyType_Slot sessionSlots[] = {
+    {Py_tp_doc, const_cast<char*>("Session(config_path=None, host='api.tastyworks.com', port='443', ca_file=None)")},
+    {Py_tp_new, reinterpret_cast<void*>(PyType_GenericNew)},
+    {Py_tp_init, reinterpret_cast<void*>(sessionInit)},
+    {Py_tp_dealloc, reinterpret_cast<void*>(sessionDealloc)},
+    {Py_tp_methods, sessionMethods},
+    {0, nullptr}};
+
+PyType_Spec sessionSpec = {"dxfeed_native.Session", sizeof(SessionObject), 0, Py_TPFLAGS_DEFAULT, sessionSlots};
+
+// ---- Feed ----
+
+struct FeedObject {
+    PyObject_HEAD
+    MarketDataWebSocket* client;
+    std::thread* feedThread; // Set while start()ed
+    bool used;               // connect() runs once per Feed
+};
+
+int feedInit(FeedObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"url", "token", "symbols", "channel", "transport", "ca_file", "capacity",
+                                     nullptr};
+    const char* url = nullptr;
+    const char* token = nullptr;
+    PyObject* symbolList = nullptr;
+    int channel = 3;
+    const char* transport = "websocketpp";
+    const char* caFile = nullptr;
+    Py_ssize_t capacity = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "ssO|iszn", const_cast<char**>(keywords), &url, &token,
+                                     &symbolList, &channel, &transport, &caFile, &capacity)) {
+        return -1;
+    }
+    std::vector<std::string> symbols;
+    if (!toStringList(symbolList, symbols)) {
+        return -1;
+    }
+    if (self->client != nullptr) {
+        PyErr_SetString(PyExc_RuntimeError, "Feed is already initialized");
+        return -1;
+    }
+    TransportKind kind;
+    if (!parseTransportKind(transport, kind)) {
+        PyErr_SetString(PyExc_ValueError, "transport must be 'websocketpp' or 'beast'");
+        return -1;
+    }
+    try {
+        self->client = new MarketDataWebSocket(url, token, channel, kind);
+        self->client->setSymbolsToTrack(symbols, static_cast<size_t>(capacity > 0 ? capacity : 0));
+        if (caFile != nullptr) {
+            self->client->setCaFile(caFile);
+        }
+    } catch (const std::exception& e) {
+        raise(e);
+        return -1;
+    }
+    return 0;
+}
+
+void stopFeed(FeedObject* self) {
+    if (self->feedThread == nullptr) {
+        return;
+    }
+    Py_BEGIN_ALLOW_THREADS
+    self->client->stop();
+    self->feedThread->join();
+    Py_END_ALLOW_THREADS
+    delete self->feedThread;
+    self->feedThread = nullptr;
+}
+
+void feedDealloc(FeedObject* self) {
+    if (self->client != nullptr) {
+        stopFeed(self);
+        delete self->client;
+    }
+    freeObject(reinterpret_cast<PyObject*>(self));
+}
+
+bool claimConnection(FeedObject* self) {
+    if (self->client == nullptr) {
+        PyErr_SetString(PyExc_RuntimeError, "Feed is not initialized");
+        return false;
+    }
+    if (self->used) {
+        PyErr_SetString(PyExc_RuntimeError, "Feed has already connected; create a new Feed");
+        return false;
+    }
+    self->used = true;
+    return true;
+}
+
+// Latest quote of every symbol that has one, read through the book's seqlock
+PyObject* feedBook(FeedObject* self, PyObject*) {
+    if (self->client == nullptr) {
+        PyErr_SetString(PyExc_RuntimeError, "Feed is not initialized");
+        return nullptr;
+    }
+    const QuoteBook& book = self->client->book();
+    auto quotes = std::make_unique<QuoteBuffer>();
+    quotes->reserve(book.size());
+    for (size_t id = 0; id < book.size(); ++id) {
+        QuoteSnapshot snapshot;
+        if (!book.read(static_cast<int32_t>(id), snapshot)) {
+            continue;
+        }
+        QuoteRecord& quote = quotes->emplace_back();
+        quote.receiveTimeNs = snapshot.receiveTimeNs;
+        quote.bidPrice = snapshot.bidPrice;
+        quote.askPrice = snapshot.askPrice;
+        quote.bidSize = snapshot.bidSize;
+        quote.askSize = snapshot.askSize;
+        quote.symbolId = static_cast<int32_t>(id);
+        quote.setSymbol(book.symbol(static_cast<int32_t>(id)));
+        clearSymbolTail(quote);
+    }
+    return toArray(std::move(quotes));
+}
+
+PyObject* feedSnapshot(FeedObject* self, PyObject*) {
+    if (!claimConnection(self)) {
+        return nullptr;
+    }
+    std::string error;
+    Py_BEGIN_ALLOW_THREADS
+    try {
+        self->client->connect();
+    } catch (const std::exception& e) {
+        error = e.what();
+    }
+    Py_END_ALLOW_THREADS
+    if (!error.empty()) {
+        PyErr_SetString(PyExc_RuntimeError, error.c_str());
+        return nullptr;
+    }
+    if (self->client->authWasRejected()) {
+        PyErr_SetString(PyExc_PermissionError, "dxLink rejected the token");
+        return nullptr;
+    }
+    return feedBook(self, nullptr);
+}
+
+PyObject* feedStart(FeedObject* self, PyObject*) {
+    if (!claimConnection(self)) {
+        return nullptr;
+    }
+    self->client->enableStreaming();
+    MarketDataWebSocket* client = self->client;
+    self->feedThread = new std::thread([client] {
+        try {
+            client->connect();
+        } catch (const std::exception& e) {
+            std::cerr << "Feed error: " << e.what() << std::endl;
+        }
+    });
+    Py_RETURN_NONE;
+}
+
+PyObject* feedStop(FeedObject* self, PyObject*) {
+    if (self->client != nullptr) {
+        stopFeed(self);
+    }
+    Py_RETURN_NONE;
+}
+
+// Everything published since the last poll (up to max_quotes), oldest first. Single consumer: the
+// GIL serializes callers.
+PyObject* feedPoll(FeedObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"max_quotes", nullptr};
+    Py_ssize_t maxQuotes = 65536;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|n", const_cast<char**>(keywords), &maxQuotes)) {
+        return nullptr;
+    }
+    if (self->client == nullptr) {
+        PyErr_SetString(PyExc_RuntimeError, "Feed is not initialized");
+        return nullptr;
+    }
+    auto quotes = std::make_unique<QuoteBuffer>();
+    size_t limit = static_cast<size_t>(maxQuotes > 0 ? maxQuotes : 0);
+    QuoteDispatcher& dispatcher = self->client->quotes();
+    quotes->reserve(std::min(limit, dispatcher.capacity()));
+    while (quotes->size() < limit) {
+        size_t drained = dispatcher.drain([&quotes](const QuoteRecord& quote) {
+            clearSymbolTail(quotes->emplace_back(quote));
+        }, limit - quotes->size());
+        if (drained == 0) {
+            break;
+        }
+    }
+    return toArray(std::move(quotes));
+}
+
+PyObject* feedSymbols(FeedObject* self, PyObject*) {
+    if (self->client == nullptr) {
+        PyErr_SetString(PyExc_RuntimeError, "Feed is not initialized");
+        return nullptr;
+    }
+    const QuoteBook& book = self->client->book();
+    PyObject* names = PyList_New(static_cast<Py_ssize_t>(book.size()));
+    if (names == nullptr) {
+        return nullptr;
+    }
+    for (size_t id = 0; id < book.size(); ++id) {
+        const std::string& name = book.symbol(static_cast<int32_t>(id));
+        PyObject* item = PyUnicode_FromStringAndSize(name.data(), static_cast<Py_ssize_t>(name.size()));
+        if (item == nullptr) {
+            Py_DECREF(names);
+            return nullptr;
+        }
+        PyList_SET_ITEM(names, static_cast<Py_ssize_t>(id), item);
+    }
+    return names;
+}
+
+PyObject* feedChangeSymbols(FeedObject* self, PyObject* args, bool add) {
+    PyObject* symbolList = nullptr;
+    if (!PyArg_ParseTuple(args, "O", &symbolList)) {
+        return nullptr;
+    }
+    std::vector<std::string> symbols;
+    if (self->client == nullptr || !toStringList(symbolList, symbols)) {
+        if (!PyErr_Occurred()) {
+            PyErr_SetString(PyExc_RuntimeError, "Feed is not initialized");
+        }
+        return nullptr;
+    }
+    if (add) {
+        self->client->addSymbols(symbols);
+    } else {
+        self->client->removeSymbols(symbols);
+    }
+    Py_RETURN_NONE;
+}
+
+PyObject* feedAddSymbols(FeedObject* self, PyObject* args) {
+    return feedChangeSymbols(self, args, true);
+}
+
+PyObject* feedRemoveSymbols(FeedObject* self, PyObject* args) {
+    return feedChangeSymbols(self, args, false);
+}
+
+PyObject* feedStats(FeedObject* self, PyObject*) {
+    if (self->client == nullptr) {
+        PyErr_SetString(PyExc_RuntimeError, "Feed is not initialized");
+        return nullptr;
+    }
+    QuoteDispatcher::Stats quoteStats = self->client->quotes().stats();
+    StreamingStats streamStats = self->client->streamingStats();
+    SubscriptionCoverage coverage = self->client->subscriptionCoverage();
+    return Py_BuildValue("{s:K,s:K,s:K,s:K,s:K,s:K,s:n,s:n,s:s}",
+                         "published", quoteStats.published, "consumed", quoteStats.consumed,
+                         "dropped", quoteStats.dropped, "overflows", quoteStats.overflows,
+                         "reconnects", streamStats.reconnects, "stalls", streamStats.stalls,
+                         "subscribed", static_cast<Py_ssize_t>(coverage.subscribed),
+                         "live", static_cast<Py_ssize_t>(coverage.live),
+                         "transport", self->client->transportName());
+}
+
+PyMethodDef feedMethods[] = {
+    {"snapshot", reinterpret_cast<PyCFunction>(feedSnapshot), METH_NOARGS,
+     "Connect, wait until every symbol has quoted and return one row per symbol (releases the GIL)"},
+    {"start", reinterpret_cast<PyCFunction>(feedStart), METH_NOARGS,
+     "Stream on a background thread with keepalives and reconnects; pull quotes with poll()"},
+    {"stop", reinterpret_cast<PyCFunction>(feedStop), METH_NOARGS, "Stop streaming and join the feed thread"},
+    {"poll", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(feedPoll)), METH_VARARGS | METH_KEYWORDS,
+     "Quotes received since the last poll, oldest first, as a quote_dtype array"},
+    {"book", reinterpret_cast<PyCFunction>(feedBook), METH_NOARGS,
+     "Latest quote of every symbol that has quoted, as a quote_dtype array"},
+    {"symbols", reinterpret_cast<PyCFunction>(feedSymbols), METH_NOARGS,
+     "Full symbol names indexed by the symbolId field"},
+    {"add_symbols", reinterpret_cast<PyCFunction>(feedAddSymbols), METH_VARARGS,
+     "Subscribe more symbols while streaming"},
+    {"remove_symbols", reinterpret_cast<PyCFunction>(feedRemoveSymbols), METH_VARARGS,
+     "Unsubscribe symbols while streaming"},
+    {"stats", reinterpret_cast<PyCFunction>(feedStats), METH_NOARGS,
+     "Hand-off, streaming and subscription counters"},
+    {nullptr, nullptr, 0, nullptr}};
+
+PyType_Slot feedSlots[] = {
+    {Py_tp_doc, const_cast<char*>("Feed(url, token, symbols, channel=3, transport='websocketpp', ca_file=None, capacity=0)\n\n"
+                               "capacity reserves book slots for symbols added later with add_symbols()")},
+    {Py_tp_new, reinterpret_cast<void*>(PyType_GenericNew)},
+    {Py_tp_init, reinterpret_cast<void*>(feedInit)},
+    {Py_tp_dealloc, reinterpret_cast<void*>(feedDealloc)},
+    {Py_tp_methods, feedMethods},
+    {0, nullptr}};
+
+PyType_Spec feedSpec = {"dxfeed_native.Feed", sizeof(FeedObject), 0, Py_TPFLAGS_DEFAULT, feedSlots};
+
+// quote_dtype: QuoteRecord's fields at their C++ offsets, so arrays can point at QuoteRecord buffers
+PyArray_Descr* makeQuoteDescr() {
+    PyObject* spec = Py_BuildValue(
+        "{s:[s,s,s,s,s,s,s],s:[s,s,s,s,s,s,s],s:[n,n,n,n,n,n,n],s:n}",
+        "names", "receiveTimeNs", "bidPrice", "askPrice", "bidSize", "askSize", "symbolId", "symbol",
+        "formats", "<i8", "<f8", "<f8", "<f8", "<f8", "<i4", ("S" + std::to_string(QuoteRecord::kMaxSymbolLength)).c_str(),
+        "offsets", static_cast<Py_ssize_t>(offsetof(QuoteRecord, receiveTimeNs)),
+        static_cast<Py_ssize_t>(offsetof(QuoteRecord, bidPrice)), static_cast<Py_ssize_t>(offsetof(QuoteRecord, askPrice)),
+        static_cast<Py_ssize_t>(offsetof(QuoteRecord, bidSize)), static_cast<Py_ssize_t>(offsetof(QuoteRecord, askSize)),
+        static_cast<Py_ssize_t>(offsetof(QuoteRecord, symbolId)), static_cast<Py_ssize_t>(offsetof(QuoteRecord, symbol)),
+        "itemsize", static_cast<Py_ssize_t>(sizeof(QuoteRecord)));
+    if (spec == nullptr) {
+        return nullptr;
+    }
+    PyArray_Descr* descr = nullptr;
+    int ok = PyArray_DescrConverter(spec, &descr);
+    Py_DECREF(spec);
+    return ok ? descr : nullptr;
+}
+
+PyModuleDef moduleDef = {PyModuleDef_HEAD_INIT, "dxfeed_native",
+                         "dxFeed session and market data websocket with NumPy quote arrays", -1, nullptr,
+                         nullptr, nullptr, nullptr, nullptr};
+
+} // namespace
+
+PyMODINIT_FUNC PyInit_dxfeed_native() {
+    import_array();
+
+    quoteDescr = makeQuoteDescr();
+    if (quoteDescr == nullptr) {
+        return nullptr;
+    }
+
+    PyObject* module = PyModule_Create(&moduleDef);
+    if (module == nullptr) {
+        return nullptr;
+    }
+    PyObject* sessionType = PyType_FromSpec(&sessionSpec);
+    PyObject* feedType = PyType_FromSpec(&feedSpec);
+    Py_INCREF(quoteDescr);
+    if (sessionType == nullptr || PyModule_AddObject(module, "Session", sessionType) < 0 ||
+        feedType == nullptr || PyModule_AddObject(module, "Feed", feedType) < 0 ||
+        PyModule_AddObject(module, "quote_dtype", reinterpret_cast<PyObject*>(quoteDescr)) < 0) {
+        Py_DECREF(module);
+        return nullptr;
+    }
+    return module;
+}
@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+"""Client of the snapshot daemon (main --serve PATH).
+
+The daemon keeps the session and subscriptions warm and answers from its live quote book, so a
+lookup is one request/response on a Unix socket instead of a login, a websocket and a subscription.
+The wire layouts mirror SnapshotProtocol.hpp.
+
+    with SnapshotClient('/tmp/px.sock') as client:
+        quotes = client.get(['/6BZ24:XCME', '/6EZ24:XCME'], wait_ms=2000)
+"""
+import socket
+import struct
+import sys
+import time
+from typing import List, NamedTuple
+
+MAGIC = 0x31535850  # "PXS1"
+MAX_SYMBOLS = 4096
+
+_REQUEST_HEADER = struct.Struct('<IHHII')   # magic, symbolCount, reserved, waitMicros, bodyBytes
+_RESPONSE_HEADER = struct.Struct('<IHHq')   # magic, count, reserved, serverTimeNs
+_ENTRY = struct.Struct('<B7x4dqQ')          # status, bid, ask, bidSize, askSize, ageNs, updateCount
+
+STATUS_OK = 0
+STATUS_PENDING = 1
+STATUS_UNAVAILABLE = 2
+STATUS_NAMES = {STATUS_OK: 'ok', STATUS_PENDING: 'pending', STATUS_UNAVAILABLE: 'unavailable'}
+
+
+class Quote(NamedTuple):
+    symbol: str
+    status: int
+    bidPrice: float
+    askPrice: float
+    bidSize: float
+    askSize: float
+    ageNs: int          # Time since the daemon received the quote (-1 unless status is ok)
+    updateCount: int
+
+    @property
+    def ok(self) -> bool:
+        return self.status == STATUS_OK
+
+    @property
+    def midPrice(self) -> float:
+        return (self.bidPrice + self.askPrice) / 2
+
+
+class SnapshotClient:
+    """One connection to the daemon, reused for every get(). Not thread-safe."""
+
+    def __init__(self, path: str, timeout: float = 5.0):
+        self.sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        self.sock.settimeout(timeout)
+        self.sock.connect(path)
+
+    def get(self, symbols: List[str], wait_ms: float = 0) -> List[Quote]:
+        """Latest quote of each symbol, in order. Symbols the daemon does not track yet are subscribed
+        and come back pending unless their first quote arrives within wait_ms."""
+        if not 0 < len(symbols) <= MAX_SYMBOLS:
+            raise ValueError(f'A snapshot request takes 1 to {MAX_SYMBOLS} symbols')
+        names = [symbol.encode() for symbol in symbols]
+        if any(not 0 < len(name) <= 255 for name in names):
+            raise ValueError('Symbols must be 1 to 255 bytes')
+        body = b''.join(bytes((len(name),)) + name for name in names)
+        header = _REQUEST_HEADER.pack(MAGIC, len(names), 0, int(wait_ms * 1000), len(body))
+        self.sock.sendall(header + body)
+
+        magic, count, _, _ = _RESPONSE_HEADER.unpack(self._receive(_RESPONSE_HEADER.size))
+        if magic != MAGIC or count != len(symbols):
+            raise RuntimeError('Unexpected snapshot response')
+        entries = self._receive(count * _ENTRY.size)
+        return [Quote(symbol, *fields) for symbol, fields in zip(symbols, _ENTRY.iter_unpack(entries))]
+
+    def _receive(self, size: int) -> bytes:
+        buffer = bytearray(size)
+        view = memoryview(buffer)
+        while view:
+            received = self.sock.recv_into(view)
+            if received == 0:
+                raise ConnectionError('The snapshot daemon closed the connection')
+            view = view[received:]
+        return bytes(buffer)
+
+    def close(self):
+        self.sock.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
+
+
+def main():
+    args = sys.argv[1:]
+    wait_ms, repeat = 2000.0, 0
+    for flag in ('--wait-ms', '--repeat'):
+        if flag in args:
+            index = args.index(flag)
+            value = args[index + 1]
+            del args[index:index + 2]
+            if flag == '--wait-ms':
+                wait_ms = float(value)
+            else:
+                repeat = int(value)
+    if len(args) < 2:
+        print(f'Usage: {sys.argv[0]} <socket path> SYMBOL [SYMBOL...] [--wait-ms N] [--repeat N]', file=sys.stderr)
+        sys.exit(1)
+
+    with SnapshotClient(args[0]) as client:
+        start = time.perf_counter()
+        quotes = client.get(args[1:], wait_ms)
+        elapsed = time.perf_counter() - start
+        for quote in quotes:
+            if quote.ok:
+                print(f'Symbol: {quote.symbol} | Bid: {quote.bidPrice} | Ask: {quote.askPrice} | '
+                      f'Mid: {quote.midPrice} | bidSize: {quote.bidSize} | askSize: {quote.askSize} | '
+                      f'age: {quote.ageNs / 1e6:.3f} ms')
+            else:
+                print(f'Symbol: {quote.symbol} | {STATUS_NAMES.get(quote.status, "unknown")}')
+        print(f'Snapshot time: {elapsed * 1e6:.1f} us')
+
+        if repeat > 0:
+            times = []
+            for _ in range(repeat):
+                start = time.perf_counter()
+                client.get(args[1:])
+                times.append(time.perf_counter() - start)
+            times.sort()
+            print(f'Warm round trip ({len(args) - 1} symbols): p50 {times[len(times) // 2] * 1e6:.1f} us | '
+                  f'p99 {times[min(len(times) - 1, len(times) * 99 // 100)] * 1e6:.1f} us')
+
+
+if __name__ == '__main__':
+    main()
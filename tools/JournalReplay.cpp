@@ -0,0 +1,177 @@
+// Plays a FrameJournal captured by MarketDataWebSocket::setJournal() (main --journal PATH) back
+// through FeedProcessor, the same decode -> QuoteBook -> QuoteDispatcher path the live client runs.
+// At recorded speed inbound frames are released on their original spacing and the lag behind
+// schedule is reported; with --max-speed they go through back to back for throughput runs.
+//
+// Build: g++ -O2 -std=c++17 -I.. JournalReplay.cpp ../FrameJournal.cpp ../CompactFeedDecoder.cpp ../QuoteBook.cpp
+//        ../QuoteDispatcher.cpp ../LatencyHistogram.cpp ../SessionTimeline.cpp -pthread -o journal_replay
+// Usage: journal_replay <journal> [--max-speed] [--loops N] [--channel N]
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "CompactFeedDecoder.hpp"
+#include "FeedProcessor.hpp"
+#include "FrameJournal.hpp"
+#include "LatencyHistogram.hpp"
+#include "MonotonicClock.hpp"
+
+namespace {
+
+struct ReplayOptions {
+    std::string path;
+    bool maxSpeed = false;
+    int loops = 1;
+    int64_t channel = -1;   // -1: the channel of the first FEED_DATA frame
+};
+
+// First pass: every quoted symbol, so the book can be built up front like setSymbolsToTrack does
+std::vector<std::string> collectSymbols(FrameJournalReader& reader, ReplayOptions& options) {
+    std::unordered_set<std::string> seen;
+    std::vector<std::string> symbols;
+    FrameJournalRecord record;
+    while (reader.next(record)) {
+        DxLinkFrame frame;
+        if (record.direction != FrameDirection::Inbound || !CompactFeedDecoder::scanFrame(record.payload, frame) ||
+            frame.type != DxLinkMessageType::FeedData) {
+            continue;
+        }
+        if (options.channel < 0) {
+            options.channel = frame.channel;
+        }
+        CompactFeedDecoder::decodeQuotes(frame.data, [&](const QuoteEvent& quote) {
+            if (seen.emplace(quote.eventSymbol).second) {
+                symbols.emplace_back(quote.eventSymbol);
+            }
+        });
+    }
+    reader.rewind();
+    return symbols;
+}
+
+// Sleeps until close to targetNs, then spins the rest so frames are released on time
+void waitUntil(int64_t targetNs) {
+    constexpr int64_t kSpinNs = 200000;
+    int64_t remaining = targetNs - monotonicNowNs();
+    if (remaining > kSpinNs) {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(remaining - kSpinNs));
+    }
+    while (monotonicNowNs() < targetNs) {
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    ReplayOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--max-speed") {
+            options.maxSpeed = true;
+        } else if (arg == "--loops" && i + 1 < argc) {
+            options.loops = std::atoi(argv[++i]);
+        } else if (arg == "--channel" && i + 1 < argc) {
+            options.channel = std::atoll(argv[++i]);
+        } else if (options.path.empty() && arg[0] != '-') {
+            options.path = arg;
+        } else {
+            options.path.clear();
+            break;
+        }
+    }
+    if (options.path.empty()) {
+        std::cerr << "Usage: " << argv[0] << " <journal> [--max-speed] [--loops N] [--channel N]" << std::endl;
+        return 1;
+    }
+
+    try {
+        FrameJournalReader reader(options.path);
+        std::vector<std::string> symbols = collectSymbols(reader, options);
+
+        QuoteBook book(symbols);
+        QuoteDispatcher dispatcher;
+        SessionTimeline timeline;
+        FeedProcessor processor(book, dispatcher, timeline);
+
+        uint64_t consumed = 0;
+        dispatcher.start([&consumed](const QuoteRecord&) { ++consumed; });
+
+        LatencyHistogram frameLatency;
+        LatencyHistogram lateness;
+        uint64_t frames = 0;
+        uint64_t quotes = 0;
+        uint64_t malformed = 0;
+        int64_t replayStartNs = monotonicNowNs();
+
+        for (int loop = 0; loop < options.loops; ++loop) {
+            FrameJournalRecord record;
+            int64_t firstRecordNs = -1;
+            int64_t loopStartNs = monotonicNowNs();
+            uint64_t index = 0;
+            for (; reader.next(record); ++index) {
+                if (firstRecordNs < 0) {
+                    firstRecordNs = record.timestampNs;
+                }
+                int64_t nowNs;
+                if (options.maxSpeed) {
+                    nowNs = monotonicNowNs();
+                } else {
+                    int64_t targetNs = loopStartNs + (record.timestampNs - firstRecordNs);
+                    waitUntil(targetNs);
+                    nowNs = monotonicNowNs();
+                    lateness.recordDuration(targetNs, nowNs);
+                }
+
+                if (record.direction == FrameDirection::Outbound) {
+                    // Reproduces the subscription -> first quote stage on the replay clock
+                    if (record.payload.find("\"FEED_SUBSCRIPTION\"") != std::string_view::npos) {
+                        processor.setSubscriptionSentNs(nowNs);
+                    }
+                    continue;
+                }
+
+                long decoded = processor.onMessage(record.payload, options.channel, nowNs);
+                if (decoded < 0) {
+                    if (++malformed <= 5) {
+                        std::cerr << "Malformed frame at record " << index << ": "
+                                  << record.payload.substr(0, 200) << std::endl;
+                    }
+                    continue;
+                }
+                if (decoded > 0) {
+                    ++frames;
+                    quotes += static_cast<uint64_t>(decoded);
+                    frameLatency.recordDuration(nowNs, monotonicNowNs());
+                }
+            }
+            reader.rewind();
+        }
+
+        int64_t elapsedNs = monotonicNowNs() - replayStartNs;
+        dispatcher.stop();
+        auto stats = dispatcher.stats();
+        double seconds = static_cast<double>(elapsedNs) / 1e9;
+
+        std::cout << "journal: " << options.path << " | records: " << reader.recordCount()
+                  << " | symbols: " << symbols.size() << " | channel: " << options.channel << '\n'
+                  << "mode: " << (options.maxSpeed ? "max speed" : "recorded speed") << " x" << options.loops
+                  << " | " << seconds << " s\n"
+                  << "FEED_DATA frames: " << frames << " | quotes: " << quotes
+                  << " | malformed: " << malformed
+                  << " | consumed: " << consumed << " | dropped: " << stats.dropped << '\n'
+                  << "frames/s: " << static_cast<double>(frames) / seconds
+                  << " | quotes/s: " << static_cast<double>(quotes) / seconds << '\n'
+                  << "frame processing: " << frameLatency.summary() << std::endl;
+        if (!options.maxSpeed) {
+            std::cout << "lag behind schedule: " << lateness.summary() << std::endl;
+        }
+        timeline.report(std::cout);
+        return malformed == 0 ? 0 : 2;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,76 @@
+// Asks a running snapshot daemon (main --serve PATH) for the latest quotes of the given symbols and
+// prints them like main does, with each quote's age. Symbols the daemon does not track yet are
+// subscribed on the spot; --wait-ms holds the answer until their first quote (default 2000 ms).
+// --repeat N then times N more requests for the same symbols on the warm connection.
+//
+// Build: g++ -O2 -std=c++17 -I.. PxSnapshot.cpp ../SnapshotClient.cpp ../LatencyHistogram.cpp -o px_snapshot
+// Usage: px_snapshot <socket path> SYMBOL [SYMBOL...] [--wait-ms N] [--repeat N]
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "LatencyHistogram.hpp"
+#include "MonotonicClock.hpp"
+#include "SnapshotClient.hpp"
+
+int main(int argc, char* argv[]) {
+    std::string path;
+    std::vector<std::string> symbols;
+    uint32_t waitMicros = 2000000;
+    long repeat = 0;
+    bool valid = argc > 2;
+    for (int i = 1; i < argc && valid; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--wait-ms" && i + 1 < argc) {
+            waitMicros = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10) * 1000);
+        } else if (arg == "--repeat" && i + 1 < argc) {
+            repeat = std::atol(argv[++i]);
+        } else if (arg[0] == '-') {
+            valid = false;
+        } else if (path.empty()) {
+            path = arg;
+        } else {
+            symbols.push_back(arg);
+        }
+    }
+    if (!valid || symbols.empty()) {
+        std::cerr << "Usage: " << argv[0] << " <socket path> SYMBOL [SYMBOL...] [--wait-ms N] [--repeat N]"
+                  << std::endl;
+        return 1;
+    }
+
+    try {
+        SnapshotClient client(path);
+        int64_t start = monotonicNowNs();
+        std::vector<SnapshotEntry> entries = client.get(symbols, waitMicros);
+        int64_t firstNs = monotonicNowNs() - start;
+
+        for (size_t i = 0; i < symbols.size(); ++i) {
+            const SnapshotEntry& entry = entries[i];
+            std::cout << "Symbol: " << symbols[i];
+            if (!entry.ok()) {
+                std::cout << " | " << snapshotStatusName(entry.status) << '\n';
+                continue;
+            }
+            std::cout << " | Bid: " << entry.bidPrice << " | Ask: " << entry.askPrice << " | Mid: " << entry.midPrice()
+                      << " | bidSize: " << entry.bidSize << " | askSize: " << entry.askSize
+                      << " | age: " << static_cast<double>(entry.ageNs) / 1e6 << " ms\n";
+        }
+        std::cout << "Snapshot time: " << static_cast<double>(firstNs) / 1000 << " us" << std::endl;
+
+        if (repeat > 0) {
+            LatencyHistogram roundTrips;
+            for (long i = 0; i < repeat; ++i) {
+                int64_t sent = monotonicNowNs();
+                client.get(symbols, 0, entries);
+                roundTrips.recordDuration(sent, monotonicNowNs());
+            }
+            std::cout << "Warm round trip (" << symbols.size() << " symbols): " << roundTrips.summary() << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,109 @@
+// Reads the shared-memory segment of a publishing client (main --publish NAME) like a strategy
+// process would: prints every quote with its sequence number as it arrives, and on Ctrl-C or when
+// the publisher stops, the records lost to a full ring and the feed receive -> read latency.
+// --latest prints the last-value table (the current book) and exits; --quiet prints only the summary.
+//
+// Build: g++ -O2 -std=c++17 -I.. QuoteTail.cpp ../SharedQuoteBus.cpp ../LatencyHistogram.cpp -lrt -o quote_tail
+// Usage: quote_tail <segment name> [--latest] [--quiet] [--from-oldest]
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "LatencyHistogram.hpp"
+#include "MonotonicClock.hpp"
+#include "SharedQuoteBus.hpp"
+
+namespace {
+
+std::atomic<bool> interrupted{false};
+
+void onSignal(int) {
+    interrupted = true;
+}
+
+void printQuote(const QuoteRecord& quote, uint64_t sequence, std::string_view symbol) {
+    if (symbol.empty()) {
+        symbol = quote.symbolView();
+    }
+    std::cout << "#" << sequence << " Symbol: " << symbol << " | Bid: " << quote.bidPrice
+              << " | Ask: " << quote.askPrice << " | bidSize: " << quote.bidSize
+              << " | askSize: " << quote.askSize << '\n';
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string name;
+    bool latestOnly = false;
+    bool quiet = false;
+    bool fromOldest = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--latest") {
+            latestOnly = true;
+        } else if (arg == "--quiet") {
+            quiet = true;
+        } else if (arg == "--from-oldest") {
+            fromOldest = true;
+        } else if (name.empty() && arg[0] != '-') {
+            name = arg;
+        } else {
+            name.clear();
+            break;
+        }
+    }
+    if (name.empty()) {
+        std::cerr << "Usage: " << argv[0] << " <segment name> [--latest] [--quiet] [--from-oldest]" << std::endl;
+        return 1;
+    }
+
+    try {
+        SharedQuoteReader reader(name, fromOldest);
+        if (latestOnly) {
+            for (size_t id = 0; id < reader.symbolCount(); ++id) {
+                QuoteRecord quote;
+                uint64_t sequence = 0;
+                if (reader.latest(static_cast<int32_t>(id), quote, &sequence)) {
+                    printQuote(quote, sequence, reader.symbol(static_cast<int32_t>(id)));
+                }
+            }
+            std::cout << std::flush;
+            return 0;
+        }
+
+        std::signal(SIGINT, onSignal);
+        std::signal(SIGTERM, onSignal);
+        LatencyHistogram latency;
+        uint64_t received = 0;
+        int idlePolls = 0;
+        while (!interrupted) {
+            QuoteRecord quote;
+            if (!reader.poll(quote)) {
+                // Spin briefly for the next record, then back off; check the publisher now and then
+                if (++idlePolls > 1000) {
+                    if (reader.closed()) {
+                        break;
+                    }
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+                    idlePolls = 0;
+                }
+                continue;
+            }
+            idlePolls = 0;
+            latency.recordDuration(quote.receiveTimeNs, monotonicNowNs());
+            ++received;
+            if (!quiet) {
+                printQuote(quote, reader.sequence(), reader.symbol(quote.symbolId));
+            }
+        }
+        std::cout << std::flush;
+        std::cout << "received: " << received << " | lost: " << reader.lostCount() << " in " << reader.gapCount()
+                  << " gap(s) | feed receive -> read: " << latency.summary() << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,515 @@
+#!/usr/bin/env python3
+"""
+Local stand-in for the Tastytrade REST API and the dxLink websocket.
+
+Serves POST /sessions, GET /api-quote-tokens and DELETE /sessions over HTTPS with keep-alive, and
+a dxLink websocket at /realtime on the same port (SETUP, AUTH, CHANNEL_REQUEST, FEED_SETUP and
+FEED_SUBSCRIPTION, answered with COMPACT FEED_DATA for every subscribed Quote, Trade, Summary,
+Greeks and TimeAndSale, multiplexed in the same frames and laid out in the fields FEED_CONFIG
+announced; --reorder-fields announces and sends them in reverse). Uses a self-signed certificate for
+localhost/127.0.0.1, generated on first use. Delays can be injected on connect, on REST responses
+and on dxLink control replies; quotes can be streamed continuously and websocket sessions dropped
+or stalled on a schedule to exercise reconnects.
+
+It counts TLS handshakes and resumed sessions so client connection reuse can be checked; GET /stats
+returns the counters as JSON and is itself left out of them.
+
+    python3 tools/dxlink_standin.py --port 8443 --close-after 2
+    python3 tools/dxlink_standin.py --port 8443 --connect-delay-ms 20 --rest-delay-ms 50 --ws-delay-ms 20
+    python3 tools/dxlink_standin.py --port 8443 --quote-interval-ms 10 --drop-every-s 3 --drop-mode stall
+    python3 tools/dxlink_standin.py --port 8443 --quote-interval-ms 5 --quotes-per-frame 100
+    python3 tools/dxlink_standin.py --port 8443 --quotes-per-frame 500 --max-message-bytes 65536
+    python3 tools/dxlink_standin.py --port 8443 --quote-interval-ms 100 --reorder-fields
+"""
+import argparse
+import base64
+import hashlib
+import json
+import os
+import socket
+import ssl
+import struct
+import subprocess
+import threading
+import time
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+# Fields sent for event types the client subscribes to without listing them in FEED_SETUP
+DEFAULT_EVENT_FIELDS = {
+    "Quote": ["eventType", "eventSymbol", "bidPrice", "askPrice", "bidSize", "askSize"],
+    "Trade": ["eventType", "eventSymbol", "time", "price", "size", "dayVolume"],
+    "Summary": ["eventType", "eventSymbol", "dayOpenPrice", "dayHighPrice", "dayLowPrice", "dayClosePrice",
+                "prevDayClosePrice", "openInterest"],
+    "Greeks": ["eventType", "eventSymbol", "time", "price", "volatility", "delta", "gamma", "theta", "rho", "vega"],
+    "TimeAndSale": ["eventType", "eventSymbol", "time", "exchangeCode", "price", "size", "bidPrice", "askPrice",
+                    "aggressorSide"],
+}
+
+
+class Stats:
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.counters = {
+            "tls_handshakes": 0,
+            "tls_resumed": 0,
+            "requests": 0,
+            "connections_closed_by_server": 0,
+            "ws_sessions": 0,
+        }
+
+    def add(self, name, amount=1):
+        with self.lock:
+            self.counters[name] = self.counters.get(name, 0) + amount
+
+    def snapshot(self):
+        with self.lock:
+            return dict(self.counters)
+
+
+def ensure_certificate(cert_file, key_file):
+    """Create a self-signed certificate valid for localhost and 127.0.0.1 if none exists."""
+    if os.path.exists(cert_file) and os.path.exists(key_file):
+        return
+    subprocess.run([
+        "openssl", "req", "-x509", "-newkey", "rsa:2048", "-nodes", "-days", "30",
+        "-keyout", key_file, "-out", cert_file, "-subj", "/CN=localhost",
+        "-addext", "subjectAltName=DNS:localhost,IP:127.0.0.1",
+    ], check=True, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+
+
+class HttpRequest:
+    def __init__(self, method, path, headers, body):
+        self.method = method
+        self.path = path
+        self.headers = headers
+        self.body = body
+
+
+def read_request(conn, pending):
+    """Read one HTTP/1.1 request. Returns (request, leftover bytes) or (None, b'') on close."""
+    data = pending
+    while b"\r\n\r\n" not in data:
+        chunk = conn.recv(65536)
+        if not chunk:
+            return None, b""
+        data += chunk
+    head, _, rest = data.partition(b"\r\n\r\n")
+    lines = head.decode("latin-1").split("\r\n")
+    method, path, _ = lines[0].split(" ", 2)
+    headers = {}
+    for line in lines[1:]:
+        name, _, value = line.partition(":")
+        headers[name.strip().lower()] = value.strip()
+    length = int(headers.get("content-length", "0"))
+    while len(rest) < length:
+        chunk = conn.recv(65536)
+        if not chunk:
+            return None, b""
+        rest += chunk
+    return HttpRequest(method, path, headers, rest[:length]), rest[length:]
+
+
+def send_response(conn, status, body=b"", content_type="application/json", extra_headers=None):
+    reasons = {200: "OK", 201: "Created", 204: "No Content", 401: "Unauthorized", 404: "Not Found"}
+    headers = [
+        f"HTTP/1.1 {status} {reasons.get(status, 'Unknown')}",
+        f"Content-Type: {content_type}",
+        f"Content-Length: {len(body)}",
+        "Connection: keep-alive",
+    ]
+    for name, value in (extra_headers or {}).items():
+        headers.append(f"{name}: {value}")
+    conn.sendall(("\r\n".join(headers) + "\r\n\r\n").encode("latin-1") + body)
+
+
+WS_GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11"
+
+
+class WebSocket:
+    """Server side of RFC 6455 framing over an already upgraded socket."""
+
+    def __init__(self, conn, pending):
+        self.conn = conn
+        self.pending = pending
+        self.send_lock = threading.Lock()
+
+    def _read_exact(self, count):
+        while len(self.pending) < count:
+            chunk = self.conn.recv(65536)
+            if not chunk:
+                raise ConnectionError("websocket closed")
+            self.pending += chunk
+        data, self.pending = self.pending[:count], self.pending[count:]
+        return data
+
+    def _read_frame(self):
+        header = self._read_exact(2)
+        fin = header[0] & 0x80
+        opcode = header[0] & 0x0F
+        masked = header[1] & 0x80
+        length = header[1] & 0x7F
+        if length == 126:
+            length = struct.unpack("!H", self._read_exact(2))[0]
+        elif length == 127:
+            length = struct.unpack("!Q", self._read_exact(8))[0]
+        mask = self._read_exact(4) if masked else b"\0\0\0\0"
+        payload = self._read_exact(length)
+        if masked and length:
+            # XOR the whole payload at once; a per-byte loop is slow for large subscriptions
+            key = (mask * (length // 4 + 1))[:length]
+            payload = (int.from_bytes(payload, "big") ^ int.from_bytes(key, "big")).to_bytes(length, "big")
+        return fin, opcode, payload
+
+    def receive(self):
+        """Returns (opcode, payload) of the next complete message, reassembling fragmented ones."""
+        fin, opcode, payload = self._read_frame()
+        if fin or opcode >= 0x8:
+            return opcode, payload
+        parts = [payload]
+        while True:
+            fin, frame_opcode, payload = self._read_frame()
+            if frame_opcode >= 0x8:
+                # Control frames may arrive between fragments; only close matters here
+                if frame_opcode == 0x8:
+                    return frame_opcode, payload
+                continue
+            parts.append(payload)
+            if fin:
+                return opcode, b"".join(parts)
+
+    def send(self, payload, opcode=0x1):
+        if isinstance(payload, str):
+            payload = payload.encode()
+        length = len(payload)
+        if length < 126:
+            header = struct.pack("!BB", 0x80 | opcode, length)
+        elif length < 65536:
+            header = struct.pack("!BBH", 0x80 | opcode, 126, length)
+        else:
+            header = struct.pack("!BBQ", 0x80 | opcode, 127, length)
+        with self.send_lock:
+            self.conn.sendall(header + payload)
+
+    def send_json(self, message):
+        self.send(json.dumps(message, separators=(",", ":")))
+
+
+def accept_websocket(conn, request, pending):
+    key = request.headers.get("sec-websocket-key", "")
+    accept = base64.b64encode(hashlib.sha1((key + WS_GUID).encode()).digest()).decode()
+    conn.sendall((
+        "HTTP/1.1 101 Switching Protocols\r\n"
+        "Upgrade: websocket\r\n"
+        "Connection: Upgrade\r\n"
+        f"Sec-WebSocket-Accept: {accept}\r\n\r\n"
+    ).encode("latin-1"))
+    return WebSocket(conn, pending)
+
+
+class StandIn:
+    def __init__(self, args):
+        self.args = args
+        self.stats = Stats()
+        self.session_counter = 0
+
+    def delay(self, ms):
+        if ms > 0:
+            time.sleep(ms / 1000.0)
+
+    # REST endpoints
+
+    def handle_rest(self, conn, request):
+        self.stats.add("requests")
+        if request.method == "POST" and request.path == "/sessions":
+            self.delay(self.args.rest_delay_ms)
+            self.session_counter += 1
+            expiry = time.strftime("%Y-%m-%dT%H:%M:%S.000Z", time.gmtime(time.time() + self.args.token_ttl))
+            body = {"data": {
+                "session-token": f"standin-session-{self.session_counter}",
+                "session-expiration": expiry,
+                "user": {"username": "standin"},
+            }}
+            send_response(conn, 201, json.dumps(body).encode())
+        elif request.method == "GET" and request.path == "/api-quote-tokens":
+            self.delay(self.args.rest_delay_ms)
+            issued = time.time()
+            body = {"data": {
+                "token": f"standin-quote-token-{self.session_counter}",
+                "dxlink-url": f"wss://127.0.0.1:{self.args.port}/realtime",
+                "level": "api",
+                "issued-at": time.strftime("%Y-%m-%dT%H:%M:%S.000Z", time.gmtime(issued)),
+                "expires-at": time.strftime("%Y-%m-%dT%H:%M:%S.000Z", time.gmtime(issued + self.args.token_ttl)),
+            }}
+            send_response(conn, 200, json.dumps(body).encode())
+        elif request.method == "DELETE" and request.path == "/sessions":
+            send_response(conn, 204)
+        else:
+            send_response(conn, 404, b'{"error":"not found"}')
+
+    # dxLink websocket
+
+    def event_values(self, event_type, fields, symbol, sequence):
+        """One COMPACT record; values are synthesized by field name, unknown fields are "NaN"."""
+        base = 1.0 + (sum(symbol.encode()) % 1000) / 1000.0
+        bid = round(base + (sequence % 20) * 0.0001, 5)
+        values = {
+            "eventType": event_type, "eventSymbol": symbol,
+            "bidPrice": bid, "askPrice": round(bid + 0.0001, 5),
+            "bidSize": float(1 + sequence % 50), "askSize": float(1 + (sequence * 3) % 50),
+            "time": int(time.time() * 1000), "price": round(bid + 0.00005, 6), "size": float(1 + sequence % 10),
+            "dayVolume": float(1000 + sequence), "exchangeCode": "X",
+            "aggressorSide": "BUY" if sequence % 2 else "SELL",
+            "dayOpenPrice": base, "dayHighPrice": round(base + 0.002, 5), "dayLowPrice": round(base - 0.002, 5),
+            "dayClosePrice": "NaN", "prevDayClosePrice": round(base - 0.001, 5), "openInterest": 25000.0,
+            "volatility": 0.12, "delta": 0.5, "gamma": 0.01, "theta": -0.02, "rho": 0.03, "vega": 0.1,
+        }
+        return [values.get(field, "NaN") for field in fields]
+
+    def event_frames(self, channel, entries, fields, sequence):
+        """FEED_DATA texts carrying one record per (event type, symbol) entry, at most --quotes-per-frame
+        records each; consecutive entries of one type share a [type, values] pair."""
+        size = self.args.quotes_per_frame if self.args.quotes_per_frame > 0 else max(len(entries), 1)
+        frames = []
+        for start in range(0, len(entries), size):
+            data = []
+            for event_type, symbol in entries[start:start + size]:
+                if not data or data[-2] != event_type:
+                    data.extend([event_type, []])
+                layout = fields.get(event_type) or DEFAULT_EVENT_FIELDS.get(event_type, ["eventType", "eventSymbol"])
+                data[-1].extend(self.event_values(event_type, layout, symbol, sequence))
+            frames.append(json.dumps({"type": "FEED_DATA", "channel": channel, "data": data},
+                                     separators=(",", ":")).encode())
+        return frames
+
+    def send_events(self, ws, channel, entries, fields, sequence):
+        for frame in self.event_frames(channel, entries, fields, sequence):
+            ws.send(frame)
+
+    def stream_dxlink(self, ws, state):
+        """Background sender of one websocket session: streamed events, KEEPALIVEs and the drop schedule."""
+        opened = time.monotonic()
+        next_quote = opened
+        sequence = 0
+        built_version = 0
+        phases = []
+        tick = 0.01
+        if self.args.quote_interval_ms > 0:
+            tick = min(tick, self.args.quote_interval_ms / 1000.0)
+        while not state["closed"].wait(tick):
+            now = time.monotonic()
+            if self.args.drop_every_s > 0 and now - opened >= self.args.drop_every_s:
+                if self.args.drop_mode == "stall":
+                    # Keep the socket open but go silent; the client has to notice on its own
+                    self.stats.add("ws_stalls")
+                    state["stalled"] = True
+                else:
+                    self.stats.add("ws_drops")
+                    try:
+                        ws.conn.shutdown(socket.SHUT_RDWR)
+                    except OSError:
+                        pass
+                return
+            if self.args.quote_interval_ms > 0 and now >= next_quote:
+                with state["lock"]:
+                    version, channel, entries = state["version"], state["channel"], list(state["subscribed"])
+                    fields = state["fields"]
+                if version != built_version:
+                    # Serialize once per subscription change; a few price phases keep quotes moving
+                    phases = [self.event_frames(channel, entries, fields, phase + 1) for phase in range(8)]
+                    built_version = version
+                if phases:
+                    for frame in phases[sequence % len(phases)]:
+                        ws.send(frame)
+                    self.stats.add("quotes_streamed", len(entries))
+                    sequence += 1
+                    state["last_sent"] = now
+                next_quote = now + self.args.quote_interval_ms / 1000.0
+            if now - state["last_sent"] >= self.args.keepalive_s:
+                ws.send_json({"type": "KEEPALIVE", "channel": 0})
+                state["last_sent"] = now
+
+    def handle_dxlink(self, ws):
+        self.stats.add("ws_sessions")
+        state = {"lock": threading.Lock(), "closed": threading.Event(), "stalled": False,
+                 "channel": 0, "subscribed": [], "fields": {}, "version": 0, "last_sent": time.monotonic()}
+        streamer = threading.Thread(target=self.stream_dxlink, args=(ws, state), daemon=True)
+        streamer.start()
+        try:
+            self.serve_dxlink(ws, state)
+        finally:
+            state["closed"].set()
+
+    def serve_dxlink(self, ws, state):
+        authorized = False
+        while True:
+            opcode, payload = ws.receive()
+            if state["stalled"]:
+                continue
+            if opcode == 0x8:
+                ws.send(payload[:2], opcode=0x8)
+                return
+            if opcode == 0x9:
+                ws.send(payload, opcode=0xA)
+                continue
+            if opcode != 0x1:
+                continue
+            if self.args.max_message_bytes > 0 and len(payload) > self.args.max_message_bytes:
+                # 1009: message too big, as a server with a frame size limit would answer
+                self.stats.add("ws_oversized_messages")
+                ws.send(struct.pack("!H", 1009), opcode=0x8)
+                return
+
+            message = json.loads(payload)
+            kind = message.get("type")
+            channel = message.get("channel", 0)
+            if kind in ("SETUP", "AUTH", "CHANNEL_REQUEST", "FEED_SETUP"):
+                self.delay(self.args.ws_delay_ms)
+            state["last_sent"] = time.monotonic()
+
+            if kind == "SETUP":
+                ws.send_json({"type": "SETUP", "channel": 0, "version": "0.1-standin",
+                              "keepaliveTimeout": 60, "acceptKeepaliveTimeout": 60})
+                ws.send_json({"type": "AUTH_STATE", "channel": 0, "state": "UNAUTHORIZED"})
+            elif kind == "KEEPALIVE":
+                self.stats.add("ws_keepalives_received")
+            elif kind == "AUTH":
+                authorized = str(message.get("token", "")).startswith("standin-quote-token")
+                self.stats.add("ws_auth_accepted" if authorized else "ws_auth_rejected")
+                ws.send_json({"type": "AUTH_STATE", "channel": 0,
+                              "state": "AUTHORIZED" if authorized else "UNAUTHORIZED"})
+            elif kind == "CHANNEL_REQUEST" and authorized:
+                ws.send_json({"type": "CHANNEL_OPENED", "channel": channel, "service": "FEED",
+                              "parameters": message.get("parameters", {})})
+            elif kind == "FEED_SETUP" and authorized:
+                # The server decides the field order; a client must follow FEED_CONFIG, not its request
+                fields = {event_type: list(reversed(names)) if self.args.reorder_fields else list(names)
+                          for event_type, names in message.get("acceptEventFields", {}).items()}
+                with state["lock"]:
+                    state["fields"] = fields
+                    state["version"] += 1
+                ws.send_json({"type": "FEED_CONFIG", "channel": channel,
+                              "aggregationPeriod": message.get("acceptAggregationPeriod", 0.1),
+                              "dataFormat": "COMPACT",
+                              "eventFields": fields})
+            elif kind == "FEED_SUBSCRIPTION" and authorized:
+                self.stats.add("ws_subscription_messages")
+                added = [(entry.get("type", "Quote"), entry["symbol"]) for entry in message.get("add", [])]
+                removed = {(entry.get("type", "Quote"), entry["symbol"]) for entry in message.get("remove", [])}
+                with state["lock"]:
+                    subscribed = [] if message.get("reset") else state["subscribed"]
+                    state["subscribed"] = [entry for entry in subscribed if entry not in removed] + added
+                    state["channel"] = channel
+                    state["version"] += 1
+                    fields = state["fields"]
+                self.send_events(ws, channel, added, fields, 0)
+
+    # Connection handling
+
+    def serve_connection(self, raw, context):
+        try:
+            self.delay(self.args.connect_delay_ms)
+            raw.settimeout(self.args.idle_timeout if self.args.idle_timeout > 0 else None)
+            conn = context.wrap_socket(raw, server_side=True)
+        except (ssl.SSLError, OSError):
+            raw.close()
+            return
+
+        counted = False
+        served = 0
+        pending = b""
+        try:
+            while True:
+                try:
+                    request, pending = read_request(conn, pending)
+                except socket.timeout:
+                    # Idle keep-alive connections are dropped silently, like a real load balancer
+                    self.stats.add("connections_closed_by_server")
+                    break
+                if request is None:
+                    break
+
+                if request.path == "/stats":
+                    send_response(conn, 200, json.dumps(self.stats.snapshot()).encode())
+                    continue
+
+                if request.headers.get("upgrade", "").lower() == "websocket":
+                    conn.settimeout(None)
+                    self.handle_dxlink(accept_websocket(conn, request, pending))
+                    break
+
+                if not counted:
+                    counted = True
+                    self.stats.add("tls_handshakes")
+                    if conn.session_reused:
+                        self.stats.add("tls_resumed")
+
+                self.handle_rest(conn, request)
+
+                served += 1
+                if self.args.close_after > 0 and served >= self.args.close_after:
+                    # Close without announcing it so the client only finds out on its next request
+                    self.stats.add("connections_closed_by_server")
+                    break
+        except (ssl.SSLError, OSError, ValueError, ConnectionError):
+            pass
+        finally:
+            try:
+                conn.close()
+            except OSError:
+                pass
+
+    def run(self):
+        cert_file = self.args.cert or os.path.join(HERE, "standin-cert.pem")
+        key_file = self.args.key or os.path.join(HERE, "standin-key.pem")
+        ensure_certificate(cert_file, key_file)
+
+        context = ssl.SSLContext(ssl.PROTOCOL_TLS_SERVER)
+        context.load_cert_chain(cert_file, key_file)
+
+        listener = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        listener.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+        listener.bind(("127.0.0.1", self.args.port))
+        listener.listen(128)
+        print(f"stand-in listening on https://127.0.0.1:{self.args.port} (CA file: {cert_file})", flush=True)
+
+        while True:
+            raw, _ = listener.accept()
+            raw.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+            threading.Thread(target=self.serve_connection, args=(raw, context), daemon=True).start()
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--port", type=int, default=8443)
+    parser.add_argument("--cert", help="PEM certificate (default: tools/standin-cert.pem, generated)")
+    parser.add_argument("--key", help="PEM private key (default: tools/standin-key.pem, generated)")
+    parser.add_argument("--connect-delay-ms", type=float, default=0,
+                        help="delay before the TLS handshake of every connection (emulates network RTT)")
+    parser.add_argument("--rest-delay-ms", type=float, default=0, help="delay added to each REST response")
+    parser.add_argument("--ws-delay-ms", type=float, default=0,
+                        help="delay added to each dxLink SETUP/AUTH/CHANNEL_REQUEST/FEED_SETUP reply")
+    parser.add_argument("--quote-interval-ms", type=float, default=0,
+                        help="stream quotes for all subscribed symbols at this interval (default: one snapshot)")
+    parser.add_argument("--quotes-per-frame", type=int, default=0,
+                        help="split FEED_DATA into frames of at most this many quotes (default: one frame)")
+    parser.add_argument("--reorder-fields", action="store_true",
+                        help="announce and send every event type's fields in reverse of the requested order")
+    parser.add_argument("--max-message-bytes", type=int, default=0,
+                        help="close the websocket with 1009 on any client message larger than this")
+    parser.add_argument("--keepalive-s", type=float, default=10,
+                        help="send a dxLink KEEPALIVE after this many idle seconds")
+    parser.add_argument("--drop-every-s", type=float, default=0,
+                        help="drop every websocket session this many seconds after it opened")
+    parser.add_argument("--drop-mode", choices=("reset", "stall"), default="reset",
+                        help="reset: shut the socket down; stall: keep it open but stop sending and answering")
+    parser.add_argument("--token-ttl", type=float, default=24 * 3600, help="lifetime of issued tokens in seconds")
+    parser.add_argument("--close-after", type=int, default=0,
+                        help="silently close each connection after this many REST requests")
+    parser.add_argument("--idle-timeout", type=float, default=0,
+                        help="silently close connections idle for this many seconds")
+    return parser.parse_args()
+
+
+if __name__ == "__main__":
+    StandIn(parse_args()).run()
@@ -0,0 +1,254 @@
+#!/usr/bin/env python3
+"""
+Repeatable end-to-end latency runs of the C++ and Python clients against the local stand-in.
+
+Starts tools/dxlink_standin.py (HTTPS REST + dxLink websocket, with the injected delays given here),
+points the clients at it through the PX_* environment overrides (PX_API_HOST, PX_API_PORT,
+PX_CREDS, PX_CA_FILE, PX_WS_URL, PX_SYMBOLS), runs each client N times, interleaved so drift hits
+them alike, and writes percentile statistics of every phase to CSV:
+
+    token_ms      Token path line: client start until the dxLink token is in hand (REST login and
+                  quote token, or the C++ token cache with --warm-token)
+    websocket_ms  WebSocket px return time line: connect until every symbol has quoted
+    total_ms      Total script execution time line, as the client measures it
+    process_ms    Wall time of the whole process as measured here (interpreter/loader start included)
+    <stage>_ms    C++ only: each SessionTimeline stage (rest_tls_handshake, setup_to_auth_state, ...)
+
+Every run starts with a cold token cache unless --warm-token is given.
+
+    python3 tools/latency_harness.py --cpp build/main --runs 50 --out latency.csv
+    python3 tools/latency_harness.py --cpp build/main --clients cpp,cpp-sequential,python \\
+        --connect-delay-ms 10 --rest-delay-ms 30 --ws-delay-ms 5 --raw latency_runs.csv
+    python3 tools/latency_harness.py --cpp build/main --cpp-args="--transport beast" --clients cpp,python-native
+
+Clients: cpp (main), cpp-sequential (main --sequential), python (px_snapshot_tt.py, pure Python
+path) and python-native (px_snapshot_tt.py through python/dxfeed_native when built).
+"""
+import argparse
+import csv
+import json
+import math
+import os
+import re
+import shlex
+import socket
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+REPO = os.path.dirname(HERE)
+
+TOKEN_LINE = re.compile(r"^Token path: (\w+) \(([\d.]+) ms\)", re.MULTILINE)
+WEBSOCKET_LINE = re.compile(r"^WebSocket px return time: ([\d.]+) ms", re.MULTILINE)
+TOTAL_LINE = re.compile(r"^Total script execution time: ([\d.]+) ms", re.MULTILINE)
+STAGE_LINE = re.compile(r"^(\w+)\s+count=(\d+) p50=([\d.e+-]+)us .* max=([\d.e+-]+)us", re.MULTILINE)
+
+PERCENTILES = (50, 90, 99)
+
+
+def free_port():
+    with socket.socket() as probe:
+        probe.bind(("127.0.0.1", 0))
+        return probe.getsockname()[1]
+
+
+def start_standin(args, port):
+    command = [sys.executable, os.path.join(HERE, "dxlink_standin.py"), "--port", str(port),
+               "--connect-delay-ms", str(args.connect_delay_ms), "--rest-delay-ms", str(args.rest_delay_ms),
+               "--ws-delay-ms", str(args.ws_delay_ms)] + shlex.split(args.standin_args)
+    standin = subprocess.Popen(command, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+    # Wait for the listening line (certificate generation may print first), then keep draining the
+    # pipe so stand-in logging can never block it
+    seen = []
+    for line in standin.stdout:
+        seen.append(line)
+        if "listening" in line:
+            threading.Thread(target=lambda: [None for _ in standin.stdout], daemon=True).start()
+            return standin
+    standin.wait()
+    raise RuntimeError("stand-in did not start:\n" + "".join(seen))
+
+
+def client_commands(args):
+    px_snapshot = [sys.executable, os.path.join(REPO, "px_snapshot_tt.py")]
+    cpp_args = shlex.split(args.cpp_args)
+    return {
+        "cpp": ([args.cpp] + cpp_args, {}),
+        "cpp-sequential": ([args.cpp, "--sequential"] + cpp_args, {}),
+        "python": (px_snapshot, {"PX_NATIVE": "0"}),
+        "python-native": (px_snapshot, {"PX_NATIVE": "1"}),
+    }
+
+
+def parse_phases(output):
+    """Phase name -> milliseconds from one client run's output."""
+    phases = {}
+    if match := TOKEN_LINE.search(output):
+        phases["token_ms"] = float(match.group(2))
+    if match := WEBSOCKET_LINE.search(output):
+        phases["websocket_ms"] = float(match.group(1))
+    if match := TOTAL_LINE.search(output):
+        phases["total_ms"] = float(match.group(1))
+    for name, count, p50, maximum in STAGE_LINE.findall(output):
+        # One sample is exact in max; the histogram's p50 is bucketed
+        phases[f"{name}_ms"] = (float(maximum) if int(count) == 1 else float(p50)) / 1000.0
+    return phases
+
+
+def run_client(command, env, timeout):
+    start = time.perf_counter()
+    try:
+        result = subprocess.run(command, env=env, cwd=REPO, capture_output=True, text=True, timeout=timeout)
+    except subprocess.TimeoutExpired:
+        return None, "timed out"
+    elapsed_ms = (time.perf_counter() - start) * 1000.0
+    output = result.stdout + result.stderr
+    phases = parse_phases(output)
+    if result.returncode != 0 or "websocket_ms" not in phases:
+        return None, output.strip().splitlines()[-1] if output.strip() else f"exit code {result.returncode}"
+    phases["process_ms"] = elapsed_ms
+    return phases, None
+
+
+def percentile(sorted_values, p):
+    """Linear interpolation between closest ranks."""
+    if len(sorted_values) == 1:
+        return sorted_values[0]
+    rank = (len(sorted_values) - 1) * p / 100.0
+    low = math.floor(rank)
+    high = min(low + 1, len(sorted_values) - 1)
+    return sorted_values[low] + (sorted_values[high] - sorted_values[low]) * (rank - low)
+
+
+def summarize(samples):
+    values = sorted(samples)
+    mean = sum(values) / len(values)
+    stdev = math.sqrt(sum((v - mean) ** 2 for v in values) / (len(values) - 1)) if len(values) > 1 else 0.0
+    row = {"mean_ms": mean, "stdev_ms": stdev, "min_ms": values[0]}
+    for p in PERCENTILES:
+        row[f"p{p}_ms"] = percentile(values, p)
+    row["max_ms"] = values[-1]
+    return row
+
+
+def phase_order(phase):
+    # Client-reported phases first, then the C++ stages in report order (insertion order)
+    fixed = ("token_ms", "websocket_ms", "total_ms", "process_ms")
+    return fixed.index(phase) if phase in fixed else len(fixed)
+
+
+def main():
+    args = parse_args()
+    commands = client_commands(args)
+    clients = [client for client in args.clients.split(",") if client]
+    for client in clients:
+        if client not in commands:
+            sys.exit(f"unknown client {client}; choose from {', '.join(commands)}")
+        if client.startswith("cpp") and not os.path.isfile(args.cpp):
+            sys.exit(f"C++ client {args.cpp} not found; run make or pass --cpp")
+
+    port = args.port or free_port()
+    workdir = tempfile.mkdtemp(prefix="latency_harness_")
+    creds = os.path.join(workdir, "creds.json")
+    # JSON is also valid YAML, so the same file serves main.cpp and websocket_init.py
+    with open(creds, "w") as f:
+        json.dump({"user": ["standin"], "pw": ["standin"]}, f)
+    token_cache = os.path.join(workdir, "token_cache.json")
+
+    env = dict(os.environ)
+    env.update({
+        "PX_API_HOST": "127.0.0.1",
+        "PX_API_PORT": str(port),
+        "PX_CREDS": creds,
+        "PX_CA_FILE": os.path.join(HERE, "standin-cert.pem"),
+        "PX_WS_URL": f"wss://127.0.0.1:{port}/realtime",
+        "PX_SYMBOLS": args.symbols,
+    })
+
+    standin = start_standin(args, port)
+    samples = {client: {} for client in clients}
+    failures = {client: 0 for client in clients}
+    raw_rows = []
+    try:
+        total_runs = args.warmup + args.runs
+        for run in range(total_runs):
+            for client in clients:
+                if not args.warm_token and os.path.exists(token_cache):
+                    os.remove(token_cache)
+                command, extra_env = commands[client]
+                phases, error = run_client(command, {**env, **extra_env}, args.timeout)
+                if run < args.warmup:
+                    continue
+                if phases is None:
+                    failures[client] += 1
+                    print(f"{client} run {run - args.warmup}: failed ({error})", file=sys.stderr)
+                    continue
+                for phase, value in phases.items():
+                    samples[client].setdefault(phase, []).append(value)
+                    raw_rows.append((client, run - args.warmup, phase, f"{value:.3f}"))
+            if not args.quiet:
+                print(f"\rrun {run + 1}/{total_runs}", end="", file=sys.stderr, flush=True)
+        if not args.quiet:
+            print(file=sys.stderr)
+    finally:
+        standin.terminate()
+        standin.wait()
+        for path in (creds, token_cache):
+            if os.path.exists(path):
+                os.remove(path)
+        os.rmdir(workdir)
+
+    fields = ["client", "phase", "runs", "failures", "mean_ms", "stdev_ms", "min_ms"] + \
+             [f"p{p}_ms" for p in PERCENTILES] + ["max_ms"]
+    rows = []
+    for client in clients:
+        for phase in sorted(samples[client], key=phase_order):
+            row = {"client": client, "phase": phase, "runs": len(samples[client][phase]),
+                   "failures": failures[client]}
+            row.update({key: f"{value:.3f}" for key, value in summarize(samples[client][phase]).items()})
+            rows.append(row)
+
+    with open(args.out, "w", newline="") as f:
+        writer = csv.DictWriter(f, fieldnames=fields)
+        writer.writeheader()
+        writer.writerows(rows)
+    if args.raw:
+        with open(args.raw, "w", newline="") as f:
+            writer = csv.writer(f)
+            writer.writerow(["client", "run", "phase", "ms"])
+            writer.writerows(raw_rows)
+
+    print(f"{'client':<16}{'phase':<34}{'runs':>6}{'p50 ms':>10}{'p90 ms':>10}{'p99 ms':>10}{'max ms':>10}")
+    for row in rows:
+        print(f"{row['client']:<16}{row['phase']:<34}{row['runs']:>6}{row['p50_ms']:>10}{row['p90_ms']:>10}"
+              f"{row['p99_ms']:>10}{row['max_ms']:>10}")
+    print(f"wrote {args.out}" + (f" and {args.raw}" if args.raw else ""))
+    return 1 if any(failures.values()) else 0
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--runs", type=int, default=20, help="measured runs per client")
+    parser.add_argument("--warmup", type=int, default=1, help="unmeasured runs per client first (page cache, certs)")
+    parser.add_argument("--clients", default="cpp,python", help="comma-separated clients to run")
+    parser.add_argument("--cpp", default=os.path.join(REPO, "build", "main"), help="C++ client binary (make main)")
+    parser.add_argument("--cpp-args", default="", help="extra arguments for the C++ client, e.g. '--transport beast'")
+    parser.add_argument("--symbols", default="/6BZ24:XCME", help="comma-separated symbols to snapshot")
+    parser.add_argument("--port", type=int, default=0, help="stand-in port (default: a free one)")
+    parser.add_argument("--connect-delay-ms", type=float, default=0, help="stand-in delay before each TLS handshake")
+    parser.add_argument("--rest-delay-ms", type=float, default=0, help="stand-in delay on each REST response")
+    parser.add_argument("--ws-delay-ms", type=float, default=0, help="stand-in delay on each dxLink control reply")
+    parser.add_argument("--standin-args", default="", help="further tools/dxlink_standin.py arguments")
+    parser.add_argument("--warm-token", action="store_true", help="keep the C++ token cache between runs")
+    parser.add_argument("--timeout", type=float, default=60, help="seconds before a client run counts as failed")
+    parser.add_argument("--out", default="latency.csv", help="percentile statistics per client and phase")
+    parser.add_argument("--raw", help="also write every sample (client, run, phase, ms)")
+    parser.add_argument("--quiet", action="store_true", help="no progress line")
+    return parser.parse_args()
+
+
+if __name__ == "__main__":
+    sys.exit(main())
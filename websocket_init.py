@@ -1,16 +1,24 @@
 #!/usr/bin/env python3
 
+import os
 import platform
 import yaml
 import requests
 import json
-from discordwebhook import Discord
+try:
+    from discordwebhook import Discord
+except ImportError:
+    Discord = None
 from datetime import datetime
 import pandas as pd
 import sqlite3
 
-# Constants
-API_BASE_URL = "https://api.tastyworks.com"
+# Constants; PX_API_HOST / PX_API_PORT / PX_CA_FILE / PX_CREDS point the session at a local
+# stand-in (tools/dxlink_standin.py), as tools/latency_harness.py does
+API_HOST = os.environ.get("PX_API_HOST", "api.tastyworks.com")
+API_PORT = os.environ.get("PX_API_PORT", "443")
+API_BASE_URL = f"https://{API_HOST}" if API_PORT == "443" else f"https://{API_HOST}:{API_PORT}"
+CA_FILE = os.environ.get("PX_CA_FILE") or True
 SESSION_URL = f"{API_BASE_URL}/sessions"
 QUOTE_TOKEN_URL = f"{API_BASE_URL}/api-quote-tokens"
 
@@ -30,6 +38,7 @@ class TastyworksSession:
         """
         ps = platform.system()
         file = "creds.yaml" if ps == "Darwin" else "/home/ec2-user/tt/creds.yaml"
+        file = os.environ.get("PX_CREDS", file)
         
         with open(file, "r") as f:
             data = yaml.safe_load(f)
@@ -38,9 +47,12 @@ class TastyworksSession:
     def _init_discord(self, data):
         """
         Initializes the Discord webhook client with the specified URL.
+        Returns None when the config has no webhook or the package is not installed.
         """
-        discord_url = data.get("discord_url_logs")[0]
-        return Discord(url=discord_url)
+        discord_url = data.get("discord_url_logs")
+        if not discord_url or Discord is None:
+            return None
+        return Discord(url=discord_url[0])
 
     def authenticate(self):
         """
@@ -60,7 +72,7 @@ class TastyworksSession:
         print("Headers:")
         print(headers)
 
-        response = requests.post(SESSION_URL, data=json.dumps(payload), headers=headers)
+        response = requests.post(SESSION_URL, data=json.dumps(payload), headers=headers, verify=CA_FILE)
         if response.status_code in {200, 201}:  # Accept 200 and 201 as successful responses
             session_data = response.json()
             self.session_token = session_data['data'].get('session-token')
@@ -76,7 +88,7 @@ class TastyworksSession:
             'Authorization': self.session_token,
             'Content-Type': 'application/json'
         }
-        response = requests.get(QUOTE_TOKEN_URL, headers=headers)
+        response = requests.get(QUOTE_TOKEN_URL, headers=headers, verify=CA_FILE)
         if response.status_code == 200:
             quote_data = response.json()
             print("Quote Token Data:", quote_data)
@@ -92,7 +104,7 @@ class TastyworksSession:
             'Authorization': self.session_token,
             'Content-Type': 'application/json'
         }
-        response = requests.delete(SESSION_URL, headers=headers)
+        response = requests.delete(SESSION_URL, headers=headers, verify=CA_FILE)
         if response.status_code in {200, 204}:  # Accept 200 and 204 as successful responses
             print("Session closed successfully.")
         else:
@@ -103,7 +115,8 @@ class TastyworksSession:
         """
         Sends a message to the Discord webhook.
         """
-        self.discord.post(content=message)
+        if self.discord is not None:
+            self.discord.post(content=message)
 
     def run(self):
         """